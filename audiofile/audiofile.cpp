@@ -64,6 +64,17 @@ bool AudioFile::open(const QByteArray& b)
       return sf != 0;
       }
 
+//---------------------------------------------------------
+//   open
+//    read directly from file, used for disk streaming
+//---------------------------------------------------------
+
+bool AudioFile::open(const QString& path)
+      {
+      sf = sf_open(QFile::encodeName(path).constData(), SFM_READ, &info);
+      return sf != 0;
+      }
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
@@ -30,6 +30,8 @@ class AudioFile {
       ~AudioFile();
 
       bool open(const QByteArray&);
+      bool open(const QString& path);
+      sf_count_t seekFrame(sf_count_t frame) { return sf_seek(sf, frame, SEEK_SET); }
       const char* error() const     { return sf_strerror(sf); }
       int read(short*, int);
 
@@ -17,10 +17,18 @@
 // -----------------------------------------------------------------------
 
 #include <math.h>
+#include "config.h"
 #include "zita.h"
 
+#if defined(USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define ZITA_SSE2
+#endif
+
 namespace Ms {
 
+static const float SILENCE = 1e-6f;       // -120 dB
+
 enum {
       R_DELAY, R_XOVER, R_RTLOW, R_RTMID, R_FDAMP,
       R_EQ1FR, R_EQ1GN,
@@ -361,6 +369,13 @@ void ZitaReverb::init(float fsamp)
       _pareq2.setfsamp(fsamp);
       _pareq1.setparam(160.0, 0.0);
       _pareq2.setparam(2.5e3, 0.0);
+
+      float tmax = 0.0f;
+      for (int i = 0; i < 8; i++)
+            tmax = qMax(tmax, _tdelay [i]);
+      _tailFrames   = (int)((0.1f + tmax) * _fsamp);
+      _silentFrames = 0;
+      _idle         = true;
       }
 
 
@@ -415,18 +430,58 @@ void ZitaReverb::prepare (int nfram)
       }
 
 //---------------------------------------------------------
-//   process
+//   clear
+//    silence all delay lines and filters
 //---------------------------------------------------------
 
-void ZitaReverb::process (int nfram, float* inp, float* out)
+void ZitaReverb::clear()
       {
-      prepare(2048);
+      memset (_vdelay0._line, 0, _vdelay0._size * sizeof (float));
+      memset (_vdelay1._line, 0, _vdelay1._size * sizeof (float));
+      for (int i = 0; i < 8; i++) {
+            memset (_diff1 [i]._line, 0, _diff1 [i]._size * sizeof (float));
+            memset (_delay [i]._line, 0, _delay [i]._size * sizeof (float));
+            _filt1 [i]._slo = 0;
+            _filt1 [i]._shi = 0;
+            }
+      _pareq1.reset ();
+      _pareq2.reset ();
+      }
 
+//---------------------------------------------------------
+//   peak
+//---------------------------------------------------------
+
+static float peak (int n, const float* p)
+      {
+      float m = 0.0f;
+      int i = 0;
+#ifdef ZITA_SSE2
+      const __m128 abs = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+      __m128 vm = _mm_setzero_ps ();
+      for (; i + 4 <= n; i += 4)
+            vm = _mm_max_ps (vm, _mm_and_ps (_mm_loadu_ps (p + i), abs));
+      float v [4];
+      _mm_storeu_ps (v, vm);
+      m = qMax (qMax (v [0], v [1]), qMax (v [2], v [3]));
+#endif
+      for (; i < n; i++)
+            m = qMax (m, fabsf (p [i]));
+      return m;
+      }
+
+//---------------------------------------------------------
+//   reverb
+//    the wet signal of n frames
+//---------------------------------------------------------
+
+void ZitaReverb::reverb (int nfram, const float* inp, float* out)
+      {
       float t, g, x0, x1, x2, x3, x4, x5, x6, x7;
       g = sqrtf (0.125f);
 
-      float* p0 = inp;
-      float* p1 = inp + 1;
+      const float* p0 = inp;
+      const float* p1 = inp + 1;
       float* q0 = out;
       float* q1 = out + 1;
 
@@ -472,6 +527,277 @@ void ZitaReverb::process (int nfram, float* inp, float* out)
             _delay [6].write (_filt1 [6].process (g * x6));
             _delay [7].write (_filt1 [7].process (g * x7));
             }
+      }
+
+#ifdef ZITA_SSE2
+//---------------------------------------------------------
+//   readLine
+//    m frames of a ring buffer starting at idx
+//---------------------------------------------------------
+
+static inline void readLine (const float* line, int size, int idx, float* dst, int m)
+      {
+      int n = qMin (m, size - idx);
+      memcpy (dst, line + idx, n * sizeof (float));
+      memcpy (dst + n, line, (m - n) * sizeof (float));
+      }
+
+//---------------------------------------------------------
+//   writeLine
+//---------------------------------------------------------
+
+static inline void writeLine (float* line, int size, int& idx, const float* src, int m)
+      {
+      int n = qMin (m, size - idx);
+      memcpy (line + idx, src, n * sizeof (float));
+      memcpy (line, src + n, (m - n) * sizeof (float));
+      idx += m;
+      if (idx >= size)
+            idx -= size;
+      }
+#endif
+
+//---------------------------------------------------------
+//   reverbBlock
+//    same as reverb, but in chunks shorter than any delay
+//    line, so that all line reads of a chunk are samples
+//    written before it. Only the damping filters are a
+//    recursion; everything else runs over the chunk
+//    four frames at a time, the filters run the eight
+//    lines in two SSE registers. The operations are
+//    those of reverb, the result is bit identical.
+//---------------------------------------------------------
+
+void ZitaReverb::reverbBlock (int nfram, const float* inp, float* out)
+      {
+#ifdef ZITA_SSE2
+      static const int CHUNK = 256;
+
+      int chunk = CHUNK;
+      for (int k = 0; k < 8; k++)
+            chunk = qMin (chunk, qMin (_diff1 [k]._size, _delay [k]._size));
+      int lag = _vdelay0._iw - _vdelay0._ir;
+      if (lag < 0)
+            lag += _vdelay0._size;
+      chunk = qMin (chunk, _vdelay0._size - lag);
+
+      const __m128 g   = _mm_set1_ps (sqrtf (0.125f));
+      const __m128 dc  = _mm_set1_ps (1e-10f);
+      const __m128 t03 = _mm_set1_ps (0.3f);
+
+      __m128 gmf [2], glo [2], wlo [2], whi [2], slo [2], shi [2];
+      for (int k = 0; k < 2; k++) {
+            const Filt1* f = _filt1 + k * 4;
+            gmf [k] = _mm_setr_ps (f [0]._gmf, f [1]._gmf, f [2]._gmf, f [3]._gmf);
+            glo [k] = _mm_setr_ps (f [0]._glo, f [1]._glo, f [2]._glo, f [3]._glo);
+            wlo [k] = _mm_setr_ps (f [0]._wlo, f [1]._wlo, f [2]._wlo, f [3]._wlo);
+            whi [k] = _mm_setr_ps (f [0]._whi, f [1]._whi, f [2]._whi, f [3]._whi);
+            slo [k] = _mm_setr_ps (f [0]._slo, f [1]._slo, f [2]._slo, f [3]._slo);
+            shi [k] = _mm_setr_ps (f [0]._shi, f [1]._shi, f [2]._shi, f [3]._shi);
+            }
+
+      float t [2][CHUNK];
+      float x [8][CHUNK];
+      float z [CHUNK];
+      float gg [CHUNK];
+
+      for (int done = 0; done < nfram; ) {
+            int m = qMin (chunk, nfram - done);
+
+            // predelay
+            for (int i = 0; i < m; i++) {
+                  t [0][i] = inp [(done + i) * 2];
+                  t [1][i] = inp [(done + i) * 2 + 1];
+                  }
+            Vdelay* vd [2] = { &_vdelay0, &_vdelay1 };
+            for (int c = 0; c < 2; c++) {
+                  writeLine (vd [c]->_line, vd [c]->_size, vd [c]->_iw, t [c], m);
+                  readLine (vd [c]->_line, vd [c]->_size, vd [c]->_ir, t [c], m);
+                  vd [c]->_ir += m;
+                  if (vd [c]->_ir >= vd [c]->_size)
+                        vd [c]->_ir -= vd [c]->_size;
+                  }
+            int i4 = m & ~3;
+            for (int c = 0; c < 2; c++) {
+                  int i = 0;
+                  for (; i < i4; i += 4)
+                        _mm_storeu_ps (t [c] + i, _mm_mul_ps (t03, _mm_loadu_ps (t [c] + i)));
+                  for (; i < m; i++)
+                        t [c][i] = 0.3f * t [c][i];
+                  }
+
+            // delay lines and diffusers
+            for (int k = 0; k < 8; k++) {
+                  Diff1& d = _diff1 [k];
+                  float* xk = x [k];
+                  const float* tk = t [k >> 2];
+                  readLine (_delay [k]._line, _delay [k]._size, _delay [k]._i, xk, m);
+                  readLine (d._line, d._size, d._i, z, m);
+                  __m128 c = _mm_set1_ps (d._c);
+                  int i = 0;
+                  for (; i < i4; i += 4) {
+                        __m128 v  = _mm_loadu_ps (xk + i);
+                        __m128 tv = _mm_loadu_ps (tk + i);
+                        v = (k & 2) ? _mm_sub_ps (v, tv) : _mm_add_ps (v, tv);
+                        v = _mm_sub_ps (v, _mm_mul_ps (c, _mm_loadu_ps (z + i)));
+                        _mm_storeu_ps (xk + i, v);
+                        }
+                  for (; i < m; i++) {
+                        float v = (k & 2) ? xk [i] - tk [i] : xk [i] + tk [i];
+                        xk [i] = v - d._c * z [i];
+                        }
+                  writeLine (d._line, d._size, d._i, xk, m);
+                  for (i = 0; i < i4; i += 4) {
+                        __m128 v = _mm_add_ps (_mm_loadu_ps (z + i), _mm_mul_ps (c, _mm_loadu_ps (xk + i)));
+                        _mm_storeu_ps (xk + i, v);
+                        }
+                  for (; i < m; i++)
+                        xk [i] = z [i] + d._c * xk [i];
+                  }
+
+            // Hadamard mix
+            int i = 0;
+            for (; i < i4; i += 4) {
+                  __m128 v [8];
+                  for (int k = 0; k < 8; k++)
+                        v [k] = _mm_loadu_ps (x [k] + i);
+                  for (int s = 1; s < 8; s <<= 1) {
+                        for (int k = 0; k < 8; k++) {
+                              if (k & s)
+                                    continue;
+                              __m128 a = v [k];
+                              v [k]     = _mm_add_ps (a, v [k + s]);
+                              v [k + s] = _mm_sub_ps (a, v [k + s]);
+                              }
+                        }
+                  for (int k = 0; k < 8; k++)
+                        _mm_storeu_ps (x [k] + i, v [k]);
+                  }
+            for (; i < m; i++) {
+                  for (int s = 1; s < 8; s <<= 1) {
+                        for (int k = 0; k < 8; k++) {
+                              if (k & s)
+                                    continue;
+                              float a = x [k][i];
+                              x [k][i]     = a + x [k + s][i];
+                              x [k + s][i] = a - x [k + s][i];
+                              }
+                        }
+                  }
+
+            // output
+            for (i = 0; i < m; i++) {
+                  _g1 += _d1;
+                  gg [i] = _g1;
+                  }
+            float* q = out + done * 2;
+            for (i = 0; i < i4; i += 4) {
+                  __m128 a  = _mm_loadu_ps (x [1] + i);
+                  __m128 b  = _mm_loadu_ps (x [2] + i);
+                  __m128 gv = _mm_loadu_ps (gg + i);
+                  __m128 l  = _mm_mul_ps (gv, _mm_add_ps (a, b));
+                  __m128 r  = _mm_mul_ps (gv, _mm_sub_ps (a, b));
+                  _mm_storeu_ps (q + i * 2,     _mm_unpacklo_ps (l, r));
+                  _mm_storeu_ps (q + i * 2 + 4, _mm_unpackhi_ps (l, r));
+                  }
+            for (; i < m; i++) {
+                  q [i * 2]     = gg [i] * (x [1][i] + x [2][i]);
+                  q [i * 2 + 1] = gg [i] * (x [1][i] - x [2][i]);
+                  }
+
+            // damping filters, lanes are lines
+            for (int k = 0; k < 2; k++) {
+                  float* r [4] = { x [k * 4], x [k * 4 + 1], x [k * 4 + 2], x [k * 4 + 3] };
+                  for (i = 0; i < m; ) {
+                        __m128 v [4];
+                        int n = qMin (4, m - i);
+                        if (n == 4) {
+                              for (int j = 0; j < 4; j++)
+                                    v [j] = _mm_loadu_ps (r [j] + i);
+                              _MM_TRANSPOSE4_PS (v [0], v [1], v [2], v [3]);
+                              }
+                        else {
+                              for (int j = 0; j < n; j++)
+                                    v [j] = _mm_setr_ps (r [0][i + j], r [1][i + j], r [2][i + j], r [3][i + j]);
+                              }
+                        for (int j = 0; j < n; j++) {
+                              __m128 y = _mm_mul_ps (g, v [j]);
+                              slo [k] = _mm_add_ps (slo [k], _mm_add_ps (_mm_mul_ps (wlo [k], _mm_sub_ps (y, slo [k])), dc));
+                              y = _mm_add_ps (y, _mm_mul_ps (glo [k], slo [k]));
+                              shi [k] = _mm_add_ps (shi [k], _mm_mul_ps (whi [k], _mm_sub_ps (y, shi [k])));
+                              v [j] = _mm_mul_ps (gmf [k], shi [k]);
+                              }
+                        if (n == 4) {
+                              _MM_TRANSPOSE4_PS (v [0], v [1], v [2], v [3]);
+                              for (int j = 0; j < 4; j++)
+                                    _mm_storeu_ps (r [j] + i, v [j]);
+                              }
+                        else {
+                              for (int j = 0; j < n; j++) {
+                                    float f [4];
+                                    _mm_storeu_ps (f, v [j]);
+                                    for (int l = 0; l < 4; l++)
+                                          r [l][i + j] = f [l];
+                                    }
+                              }
+                        i += n;
+                        }
+                  }
+            for (int k = 0; k < 8; k++)
+                  writeLine (_delay [k]._line, _delay [k]._size, _delay [k]._i, x [k], m);
+            done += m;
+            }
+
+      float s [8];
+      _mm_storeu_ps (s, slo [0]);
+      _mm_storeu_ps (s + 4, slo [1]);
+      for (int k = 0; k < 8; k++)
+            _filt1 [k]._slo = s [k];
+      _mm_storeu_ps (s, shi [0]);
+      _mm_storeu_ps (s + 4, shi [1]);
+      for (int k = 0; k < 8; k++)
+            _filt1 [k]._shi = s [k];
+#else
+      reverb (nfram, inp, out);
+#endif
+      }
+
+//---------------------------------------------------------
+//   process
+//    Once the input has been silent and the wet output
+//    below SILENCE for longer than the longest path
+//    through the delay lines the lines are cleared and
+//    the reverb is bypassed until the input is audible
+//    again.
+//---------------------------------------------------------
+
+void ZitaReverb::process (int nfram, float* inp, float* out)
+      {
+      prepare(2048);
+
+      bool silent = peak (nfram * 2, inp) < SILENCE;
+      if (silent && _idle) {
+            _g1 += _d1 * nfram;
+            for (int i = 0; i < nfram; i++) {
+                  *out++ = _g0 * *inp++;
+                  *out++ = _g0 * *inp++;
+                  _g0 += _d0;
+                  }
+            return;
+            }
+      _idle = false;
+      if (_simd)
+            reverbBlock (nfram, inp, out);
+      else
+            reverb (nfram, inp, out);
+
+      if (!silent || peak (nfram * 2, out) >= SILENCE)
+            _silentFrames = 0;
+      else if ((_silentFrames += nfram) >= _tailFrames) {
+            clear ();
+            _idle = true;
+            }
+
       _pareq1.process (nfram, out);
       _pareq2.process (nfram, out);
 
@@ -228,10 +228,18 @@ class ZitaReverb : public Effect
       Pareq   _pareq1;
       Pareq   _pareq2;
 
+      bool    _simd = true;
+      bool    _idle;              // tail has decayed, lines are cleared
+      int     _silentFrames;      // silent input and wet output since
+      int     _tailFrames;        // longest path through the delay lines
+
       static float _tdiff1 [8];
       static float _tdelay [8];
 
       void prepare(int n);
+      void reverb(int n, const float* inp, float* out);
+      void reverbBlock(int n, const float* inp, float* out);
+      void clear();
 
    public:
       ZitaReverb() : Effect() {}
@@ -241,6 +249,8 @@ class ZitaReverb : public Effect
       void fini();
 
       virtual void process(int n, float* inp, float* out);
+      void setSimd(bool val)  { _simd = val; }
+      bool idle() const       { return _idle; }
 
       void set_delay(float v) { _ipdel = v; _cntA1++; }
       float delay() const     { return _ipdel; }
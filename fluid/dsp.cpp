@@ -18,9 +18,16 @@
  * 02111-1307, USA
  */
 
+#include "config.h"
 #include "fluid.h"
 #include "voice.h"
 #include "sfont.h"
+#include "dsp.h"
+
+#if defined(USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define FLUID_DSP_SSE2
+#endif
 
 namespace FluidS {
 
@@ -107,6 +114,247 @@ void Voice::dsp_float_config()
       fluid_check_fpe("interpolation table calculation");
       }
 
+#ifdef FLUID_DSP_SSE2
+//---------------------------------------------------------
+//   loadPoints4
+//    four consecutive 16 bit sample points as floats
+//---------------------------------------------------------
+
+static inline __m128 loadPoints4(const short* p)
+      {
+      __m128i s = _mm_loadl_epi64((const __m128i*)p);
+      return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+      }
+
+//---------------------------------------------------------
+//   advance4
+//    phases and amplitudes for the next four output samples;
+//    amplitudes are accumulated one by one like the scalar
+//    loop does to stay bit identical
+//---------------------------------------------------------
+
+static inline void advance4(Phase* p, float* a, const Phase& phase, const Phase& incr, float amp, float amp_incr)
+      {
+      p[0] = phase;
+      a[0] = amp;
+      for (int k = 1; k < 4; ++k) {
+            p[k] = p[k-1];
+            p[k] += incr;
+            a[k] = a[k-1] + amp_incr;
+            }
+      }
+#endif
+
+//---------------------------------------------------------
+//   dsp_interpolate_linear_run
+//---------------------------------------------------------
+
+unsigned dsp_interpolate_linear_run(const short* data, const float (*coeff)[2],
+   Phase& phase, Phase phase_incr, float& amp, float amp_incr,
+   float* buf, unsigned dsp_i, unsigned n, unsigned end_index, bool simd)
+      {
+#ifdef FLUID_DSP_SSE2
+      if (simd) {
+            Phase p[4];
+            float a[4];
+            while (dsp_i + 4 <= n) {
+                  advance4(p, a, phase, phase_incr, amp, amp_incr);
+                  if (unsigned(p[3].index()) > end_index)
+                        break;
+                  const float* c[4];
+                  const short* d[4];
+                  for (int k = 0; k < 4; ++k) {
+                        c[k] = coeff[fluid_phase_fract_to_tablerow(p[k])];
+                        d[k] = data + unsigned(p[k].index());
+                        }
+                  __m128 c0 = _mm_setr_ps(c[0][0], c[1][0], c[2][0], c[3][0]);
+                  __m128 c1 = _mm_setr_ps(c[0][1], c[1][1], c[2][1], c[3][1]);
+                  __m128 d0 = _mm_setr_ps(d[0][0], d[1][0], d[2][0], d[3][0]);
+                  __m128 d1 = _mm_setr_ps(d[0][1], d[1][1], d[2][1], d[3][1]);
+                  __m128 v  = _mm_add_ps(_mm_mul_ps(c0, d0), _mm_mul_ps(c1, d1));
+                  _mm_storeu_ps(buf + dsp_i, _mm_mul_ps(_mm_loadu_ps(a), v));
+                  phase = p[3];
+                  phase += phase_incr;
+                  amp = a[3] + amp_incr;
+                  dsp_i += 4;
+                  }
+            }
+#else
+      Q_UNUSED(simd);
+#endif
+      unsigned dsp_phase_index = phase.index();
+      for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
+            const float* coeffs = coeff[fluid_phase_fract_to_tablerow (phase)];
+            buf[dsp_i] = amp * (coeffs[0] * data[dsp_phase_index]
+               + coeffs[1] * data[dsp_phase_index+1]);
+
+            /* increment phase and amplitude */
+            phase += phase_incr;
+            dsp_phase_index = phase.index();
+            amp += amp_incr;
+            }
+      return dsp_i;
+      }
+
+//---------------------------------------------------------
+//   dsp_interpolate_4th_run
+//---------------------------------------------------------
+
+unsigned dsp_interpolate_4th_run(const short* data, const float (*coeff)[4],
+   Phase& phase, Phase phase_incr, float& amp, float amp_incr,
+   float* buf, unsigned dsp_i, unsigned n, unsigned end_index, bool simd)
+      {
+#ifdef FLUID_DSP_SSE2
+      if (simd) {
+            Phase p[4];
+            float a[4];
+            while (dsp_i + 4 <= n) {
+                  advance4(p, a, phase, phase_incr, amp, amp_incr);
+                  if (unsigned(p[3].index()) > end_index)
+                        break;
+                  __m128 r[4];
+                  for (int k = 0; k < 4; ++k) {
+                        __m128 c = _mm_loadu_ps(coeff[fluid_phase_fract_to_tablerow(p[k])]);
+                        r[k] = _mm_mul_ps(c, loadPoints4(data + unsigned(p[k].index()) - 1));
+                        }
+                  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+                  __m128 v = _mm_add_ps(_mm_add_ps(_mm_add_ps(r[0], r[1]), r[2]), r[3]);
+                  _mm_storeu_ps(buf + dsp_i, _mm_mul_ps(_mm_loadu_ps(a), v));
+                  phase = p[3];
+                  phase += phase_incr;
+                  amp = a[3] + amp_incr;
+                  dsp_i += 4;
+                  }
+            }
+#else
+      Q_UNUSED(simd);
+#endif
+      unsigned dsp_phase_index = phase.index();
+      for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
+            const float* coeffs = coeff[fluid_phase_fract_to_tablerow (phase)];
+            buf[dsp_i] = amp * (coeffs[0] * data[dsp_phase_index-1]
+               + coeffs[1] * data[dsp_phase_index]
+               + coeffs[2] * data[dsp_phase_index+1]
+               + coeffs[3] * data[dsp_phase_index+2]);
+
+            /* increment phase and amplitude */
+            phase += phase_incr;
+            dsp_phase_index = phase.index();
+            amp += amp_incr;
+            }
+      return dsp_i;
+      }
+
+//---------------------------------------------------------
+//   dsp_interpolate_7th_run
+//    phase is already offset by 1/2 sample
+//---------------------------------------------------------
+
+unsigned dsp_interpolate_7th_run(const short* data, const float (*coeff)[7],
+   Phase& phase, Phase phase_incr, float& amp, float amp_incr,
+   float* buf, unsigned dsp_i, unsigned n, unsigned end_index, bool simd)
+      {
+#ifdef FLUID_DSP_SSE2
+      if (simd) {
+            Phase p[4];
+            float a[4];
+            while (dsp_i + 4 <= n) {
+                  advance4(p, a, phase, phase_incr, amp, amp_incr);
+                  if (unsigned(p[3].index()) > end_index)
+                        break;
+                  __m128 r[4];      // terms 0-3
+                  __m128 q[4];      // terms 3-6, term 3 is not used
+                  for (int k = 0; k < 4; ++k) {
+                        const float* c = coeff[fluid_phase_fract_to_tablerow(p[k])];
+                        const short* d = data + unsigned(p[k].index());
+                        r[k] = _mm_mul_ps(_mm_loadu_ps(c), loadPoints4(d - 3));
+                        q[k] = _mm_mul_ps(_mm_loadu_ps(c + 3), loadPoints4(d));
+                        }
+                  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+                  _MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+                  __m128 v = _mm_add_ps(_mm_add_ps(_mm_add_ps(r[0], r[1]), r[2]), r[3]);
+                  v = _mm_add_ps(_mm_add_ps(_mm_add_ps(v, q[1]), q[2]), q[3]);
+                  _mm_storeu_ps(buf + dsp_i, _mm_mul_ps(_mm_loadu_ps(a), v));
+                  phase = p[3];
+                  phase += phase_incr;
+                  amp = a[3] + amp_incr;
+                  dsp_i += 4;
+                  }
+            }
+#else
+      Q_UNUSED(simd);
+#endif
+      unsigned dsp_phase_index = phase.index();
+      for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
+            const float* coeffs = coeff[fluid_phase_fract_to_tablerow (phase)];
+
+            buf[dsp_i] = amp * (coeffs[0] * (float)data[dsp_phase_index-3]
+               + coeffs[1] * (float)data[dsp_phase_index-2]
+               + coeffs[2] * (float)data[dsp_phase_index-1]
+               + coeffs[3] * (float)data[dsp_phase_index]
+               + coeffs[4] * (float)data[dsp_phase_index+1]
+               + coeffs[5] * (float)data[dsp_phase_index+2]
+               + coeffs[6] * (float)data[dsp_phase_index+3]);
+
+            /* increment phase and amplitude */
+            phase += phase_incr;
+            dsp_phase_index = phase.index();
+            amp += amp_incr;
+            }
+      return dsp_i;
+      }
+
+//---------------------------------------------------------
+//   dsp_mix
+//---------------------------------------------------------
+
+void dsp_mix(const float* buf, unsigned count, float amp_left, float amp_right,
+   float amp_reverb, float amp_chorus, float* out, float* reverb, float* chorus,
+   bool simd)
+      {
+      unsigned i = 0;
+#ifdef FLUID_DSP_SSE2
+      if (simd) {
+            const __m128 l   = _mm_set1_ps(amp_left);
+            const __m128 r   = _mm_set1_ps(amp_right);
+            const __m128 rev = _mm_set1_ps(amp_reverb);
+            const __m128 cho = _mm_set1_ps(amp_chorus);
+            for (; i + 4 <= count; i += 4) {
+                  __m128 v  = _mm_loadu_ps(buf + i);
+                  __m128 vl = _mm_mul_ps(v, l);
+                  __m128 vr = _mm_mul_ps(v, r);
+                  __m128 lo = _mm_unpacklo_ps(vl, vr);      // l0 r0 l1 r1
+                  __m128 hi = _mm_unpackhi_ps(vl, vr);      // l2 r2 l3 r3
+                  unsigned o = i * 2;
+                  _mm_storeu_ps(out + o,        _mm_add_ps(_mm_loadu_ps(out + o), lo));
+                  _mm_storeu_ps(out + o + 4,    _mm_add_ps(_mm_loadu_ps(out + o + 4), hi));
+                  _mm_storeu_ps(reverb + o,     _mm_add_ps(_mm_loadu_ps(reverb + o), _mm_mul_ps(lo, rev)));
+                  _mm_storeu_ps(reverb + o + 4, _mm_add_ps(_mm_loadu_ps(reverb + o + 4), _mm_mul_ps(hi, rev)));
+                  _mm_storeu_ps(chorus + o,     _mm_add_ps(_mm_loadu_ps(chorus + o), _mm_mul_ps(lo, cho)));
+                  _mm_storeu_ps(chorus + o + 4, _mm_add_ps(_mm_loadu_ps(chorus + o + 4), _mm_mul_ps(hi, cho)));
+                  }
+            out    += i * 2;
+            reverb += i * 2;
+            chorus += i * 2;
+            }
+#else
+      Q_UNUSED(simd);
+#endif
+      for (; i < count; i++) {
+            float v    = buf[i];
+
+            float vv   = v  * amp_left;
+            *out++    += vv;
+            *reverb++ += vv * amp_reverb;
+            *chorus++ += vv * amp_chorus;
+
+            vv         = v  * amp_right;
+            *out++    += vv;
+            *reverb++ += vv * amp_reverb;
+            *chorus++ += vv * amp_chorus;
+            }
+      }
+
 //-------------------------------------------------------------------
 //   fluid_dsp_float_interpolate_none
 //    No interpolation. Just take the sample, which is closest to
@@ -216,16 +464,9 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
             dsp_phase_index = dsp_phase.index();
 
             /* interpolate the sequence of sample points */
-            for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
-                  coeffs = interp_coeff_linear[fluid_phase_fract_to_tablerow (dsp_phase)];
-                  dsp_buf[dsp_i] = dsp_amp * (coeffs[0] * dsp_data[dsp_phase_index]
-				  + coeffs[1] * dsp_data[dsp_phase_index+1]);
-
-                  /* increment phase and amplitude */
-                  dsp_phase += dsp_phase_incr;
-                  dsp_phase_index = dsp_phase.index();
-                  dsp_amp += dsp_amp_incr;
-                  }
+            dsp_i = dsp_interpolate_linear_run(dsp_data, interp_coeff_linear, dsp_phase, dsp_phase_incr,
+               dsp_amp, dsp_amp_incr, dsp_buf, dsp_i, n, end_index);
+            dsp_phase_index = dsp_phase.index();
 
             /* break out if buffer filled */
             if (dsp_i >= n)
@@ -331,18 +572,9 @@ int Voice::dsp_float_interpolate_4th_order(unsigned n)
                   }
 
             /* interpolate the sequence of sample points */
-            for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
-                  coeffs = interp_coeff[fluid_phase_fract_to_tablerow (phase)];
-                  dsp_buf[dsp_i] = amp * (coeffs[0] * dsp_data[dsp_phase_index-1]
-				  + coeffs[1] * dsp_data[dsp_phase_index]
-				  + coeffs[2] * dsp_data[dsp_phase_index+1]
-				  + coeffs[3] * dsp_data[dsp_phase_index+2]);
-
-                  /* increment phase and amplitude */
-                  phase += dsp_phase_incr;
-                  dsp_phase_index = phase.index();
-                  amp += dsp_amp_incr;
-                  }
+            dsp_i = dsp_interpolate_4th_run(dsp_data, interp_coeff, phase, dsp_phase_incr,
+               amp, dsp_amp_incr, dsp_buf, dsp_i, n, end_index);
+            dsp_phase_index = phase.index();
 
             /* break out if buffer filled */
             if (dsp_i >= n)
@@ -529,22 +761,9 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
             start_index -= 2;	/* set back to original start index */
 
             /* interpolate the sequence of sample points */
-            for ( ; dsp_i < n && dsp_phase_index <= end_index; dsp_i++) {
-                  coeffs = sinc_table7[fluid_phase_fract_to_tablerow (dsp_phase)];
-
-                  dsp_buf[dsp_i] = dsp_amp * (coeffs[0] * (float)dsp_data[dsp_phase_index-3]
-                     + coeffs[1] * (float)dsp_data[dsp_phase_index-2]
-                     + coeffs[2] * (float)dsp_data[dsp_phase_index-1]
-                     + coeffs[3] * (float)dsp_data[dsp_phase_index]
-                     + coeffs[4] * (float)dsp_data[dsp_phase_index+1]
-                     + coeffs[5] * (float)dsp_data[dsp_phase_index+2]
-                     + coeffs[6] * (float)dsp_data[dsp_phase_index+3]);
-
-                  /* increment phase and amplitude */
-                  dsp_phase += dsp_phase_incr;
-                  dsp_phase_index = dsp_phase.index();
-                  dsp_amp += dsp_amp_incr;
-                  }
+            dsp_i = dsp_interpolate_7th_run(dsp_data, sinc_table7, dsp_phase, dsp_phase_incr,
+               dsp_amp, dsp_amp_incr, dsp_buf, dsp_i, n, end_index);
+            dsp_phase_index = dsp_phase.index();
 
             /* break out if buffer filled */
             if (dsp_i >= n)
@@ -0,0 +1,57 @@
+/* FluidSynth - A Software Synthesizer
+ *
+ * Copyright (C) 2003  Peter Hanappe and others.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public License
+ * as published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307, USA
+ */
+
+#ifndef _FLUID_DSP_H
+#define _FLUID_DSP_H
+
+#include "fluid.h"
+
+namespace FluidS {
+
+/* Inner loops of the interpolators and the output mixer.
+ *
+ * The run functions interpolate output samples dsp_i..n-1 as long as
+ * all interpolation points lie inside the sample data, i.e. until the
+ * phase index passes end_index. They return the new dsp_i; phase and
+ * amp are advanced accordingly. With simd set the SSE2 kernels are used
+ * where available; they produce bit identical results to the scalar
+ * loops.
+ */
+
+unsigned dsp_interpolate_linear_run(const short* data, const float (*coeff)[2],
+   Phase& phase, Phase phase_incr, float& amp, float amp_incr,
+   float* buf, unsigned dsp_i, unsigned n, unsigned end_index, bool simd = true);
+
+unsigned dsp_interpolate_4th_run(const short* data, const float (*coeff)[4],
+   Phase& phase, Phase phase_incr, float& amp, float amp_incr,
+   float* buf, unsigned dsp_i, unsigned n, unsigned end_index, bool simd = true);
+
+unsigned dsp_interpolate_7th_run(const short* data, const float (*coeff)[7],
+   Phase& phase, Phase phase_incr, float& amp, float amp_incr,
+   float* buf, unsigned dsp_i, unsigned n, unsigned end_index, bool simd = true);
+
+/* Adds count mono samples from buf panned to the interleaved stereo
+ * buffers out, reverb and chorus. */
+
+void dsp_mix(const float* buf, unsigned count, float amp_left, float amp_right,
+   float amp_reverb, float amp_chorus, float* out, float* reverb, float* chorus,
+   bool simd = true);
+}
+#endif
@@ -18,6 +18,7 @@
  * 02111-1307, USA
  */
 
+#include <algorithm>
 #include "synthesizer/event.h"
 #include "synthesizer/msynthesizer.h"
 #include "mscore/preferences.h"
@@ -71,6 +72,12 @@ static const Mod defaultMod[] = {
 Fluid::Fluid()
    : Synthesizer()
       {
+      stealHeapValid = false;
+      stealNoteId    = 0;
+      _allocated     = 0;
+      _stolen        = 0;
+      _active        = 0;
+      _maxActive     = 0;
       }
 
 //---------------------------------------------------------
@@ -96,6 +103,11 @@ void Fluid::init(float sampleRate)
             _tuning[i] = i * 100.0;
       _masterTuning = 440.0;
 
+      // reserve the lists once, the audio thread moves voices
+      // between them without allocating
+      freeVoices.reserve(512);
+      activeVoices.reserve(512);
+      stealHeap.reserve(512);
       for (int i = 0; i < 512; i++)
             freeVoices.append(new Voice(this));
       }
@@ -125,8 +137,29 @@ Fluid::~Fluid()
 
 void Fluid::freeVoice(Voice* v)
       {
-      if (activeVoices.removeOne(v))
-            freeVoices.append(v);
+      if (v->slot < 0)
+            return;
+      Voice* last = activeVoices.last();
+      activeVoices[v->slot] = last;
+      last->slot = v->slot;
+      activeVoices.removeLast();
+      v->slot = -1;
+      freeVoices.append(v);
+      stealHeapValid = false;
+      }
+
+//---------------------------------------------------------
+//   voiceStats
+//---------------------------------------------------------
+
+VoiceStats Fluid::voiceStats() const
+      {
+      VoiceStats stats;
+      stats.allocated = _allocated;
+      stats.stolen    = _stolen;
+      stats.active    = _active;
+      stats.maxActive = _maxActive;
+      return stats;
       }
 
 //---------------------------------------------------------
@@ -447,79 +480,113 @@ void Fluid::program_reset()
 void Fluid::process(unsigned len, float* out, float* effect1, float* effect2)
       {
       if (mutex.tryLock()) {
-            foreach (Voice* v, activeVoices)
+            int n = activeVoices.size();
+            // a voice which ends is replaced by the last one
+            // in activeVoices, which is written next
+            for (int i = 0; i < activeVoices.size();) {
+                  Voice* v = activeVoices.at(i);
                   v->write(len, out, effect1, effect2);
+                  if (i < activeVoices.size() && activeVoices.at(i) == v)
+                        ++i;
+                  }
+            // envelopes have moved on
+            stealHeapValid = false;
+            _active = n;
+            if (n > _maxActive)
+                  _maxActive = n;
             mutex.unlock();
             }
       }
 
+//---------------------------------------------------------
+//   voicePriority
+//    how important a voice is, relative to the note
+//    stealNoteId
+//---------------------------------------------------------
+
+float Fluid::voicePriority(const Voice* v) const
+      {
+      /* Determine, how 'important' a voice is.
+       * Start with an arbitrary number */
+      float prio = 10000.;
+
+      /* Is this voice on the drum channel?
+       * Then it is very important.
+       * Also, forget about the released-note condition:
+       * Typically, drum notes are triggered only very briefly, they run most
+       * of the time in release phase.
+       */
+      if (v->chan == 9) {
+            prio += 4000;
+            }
+      else if (v->RELEASED()) {
+            /* The key for this voice has been released. Consider it much less important
+            * than a voice, which is still held.
+            */
+            prio -= 2000.;
+            }
+
+      if (v->SUSTAINED()) {
+        /* The sustain pedal is held down on this channel.
+         * Consider it less important than non-sustained channels.
+         * This decision is somehow subjective. But usually the sustain pedal
+         * is used to play 'more-voices-than-fingers', so it shouldn't hurt
+         * if we kill one voice.
+         */
+            prio -= 1000;
+            }
+
+      /* We are not enthusiastic about releasing voices, which have just been started.
+       * Otherwise hitting a chord may result in killing notes belonging to that very same
+       * chord.
+       * So subtract the age of the voice from the priority - an older voice is just a little
+       * bit less important than a younger voice.
+       * This is a number between roughly 0 and 100.
+       * Voices started after stealNoteId get a negative age.*/
+
+      prio -= int(stealNoteId - v->get_id());
+
+      /* take a rough estimate of loudness into account. Louder voices are more important. */
+      if (v->volenv_section != FLUID_VOICE_ENVATTACK) {
+            prio += v->volenv_val * 1000.;
+            }
+      return prio;
+      }
+
 /*
  * fluid_synth_free_voice_by_kill
  *
  * selects a voice for killing. the selection algorithm is a refinement
  * of the algorithm previously in fluid_synth_alloc_voice.
+ *
+ * The priorities of all active voices are computed once into a heap,
+ * following steals take the next voice from the heap until a voice
+ * changes (note off, voice end, next block).
  */
 
 void Fluid::free_voice_by_kill()
       {
-      float best_prio = 999999.;
-      float this_voice_prio;
-      Voice* best_voice = 0;
-
-      foreach(Voice* v, activeVoices) {
-            /* Determine, how 'important' a voice is.
-             * Start with an arbitrary number */
-            this_voice_prio = 10000.;
-
-            /* Is this voice on the drum channel?
-             * Then it is very important.
-             * Also, forget about the released-note condition:
-             * Typically, drum notes are triggered only very briefly, they run most
-             * of the time in release phase.
-             */
-            if (v->chan == 9) {
-                  this_voice_prio += 4000;
-
-                  }
-            else if (v->RELEASED()) {
-                  /* The key for this voice has been released. Consider it much less important
-                  * than a voice, which is still held.
-                  */
-                  this_voice_prio -= 2000.;
-                  }
-
-            if (v->SUSTAINED()) {
-              /* The sustain pedal is held down on this channel.
-               * Consider it less important than non-sustained channels.
-               * This decision is somehow subjective. But usually the sustain pedal
-               * is used to play 'more-voices-than-fingers', so it shouldn't hurt
-               * if we kill one voice.
-               */
-                  this_voice_prio -= 1000;
-                  }
-
-            /* We are not enthusiastic about releasing voices, which have just been started.
-             * Otherwise hitting a chord may result in killing notes belonging to that very same
-             * chord.
-             * So subtract the age of the voice from the priority - an older voice is just a little
-             * bit less important than a younger voice.
-             * This is a number between roughly 0 and 100.*/
-
-            this_voice_prio -= (noteid - v->get_id());
-
-            /* take a rough estimate of loudness into account. Louder voices are more important. */
-            if (v->volenv_section != FLUID_VOICE_ENVATTACK) {
-                  this_voice_prio += v->volenv_val * 1000.;
-                  }
-
-            /* check if this voice has less priority than the previous candidate. */
-            if (this_voice_prio < best_prio) {
-                  best_voice = v;
-                  best_prio = this_voice_prio;
+      if (!stealHeapValid) {
+            stealNoteId = noteid;
+            stealHeap.resize(0);    // clear() frees the reserved storage before Qt 5.7
+            foreach(Voice* v, activeVoices) {
+                  StealCandidate c = { voicePriority(v), v };
+                  stealHeap.append(c);
                   }
+            std::make_heap(stealHeap.begin(), stealHeap.end());
+            stealHeapValid = true;
+            }
+      while (!stealHeap.isEmpty()) {
+            std::pop_heap(stealHeap.begin(), stealHeap.end());
+            Voice* v = stealHeap.last().voice;
+            stealHeap.removeLast();
+            if (v->slot < 0)
+                  continue;
+            v->off();
+            ++_stolen;
+            stealHeapValid = true;  // the killed voice has already left the heap
+            return;
             }
-      if (best_voice)
-            best_voice->off();
       }
 
 //---------------------------------------------------------
@@ -539,7 +606,9 @@ Voice* Fluid::alloc_voice(unsigned id, Sample* sample, int chan, int key, int ve
             return 0;
             }
 
-      Voice* v = freeVoices.takeLast();
+      Voice* v = freeVoices.last();
+      freeVoices.removeLast();
+      v->slot = activeVoices.size();
       activeVoices.append(v);
 
       if (chan >= 0)
@@ -550,6 +619,13 @@ Voice* Fluid::alloc_voice(unsigned id, Sample* sample, int chan, int key, int ve
       /* add the default modulators to the synthesis process. */
       for (unsigned i = 0; i < sizeof(defaultMod)/sizeof(*defaultMod); ++i)
             v->add_mod(&defaultMod[i],  FLUID_VOICE_DEFAULT);
+
+      ++_allocated;
+      if (stealHeapValid) {
+            StealCandidate sc = { voicePriority(v), v };
+            stealHeap.append(sc);
+            std::push_heap(stealHeap.begin(), stealHeap.end());
+            }
       return v;
       }
 
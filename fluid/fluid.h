@@ -22,6 +22,7 @@
 #ifndef __FLUID_S_H__
 #define __FLUID_S_H__
 
+#include <atomic>
 #include "synthesizer/synthesizer.h"
 #include "synthesizer/midipatch.h"
 
@@ -290,6 +291,17 @@ enum {
       FLUID_GROUP  = 0,
       };
 
+//---------------------------------------------------------
+//   VoiceStats
+//---------------------------------------------------------
+
+struct VoiceStats {
+      int allocated;          // voices started
+      int stolen;             // voices killed to start a new one
+      int active;             // voices rendered in the last block
+      int maxActive;          // peak of active
+      };
+
 //---------------------------------------------------------
 //   Fluid
 //---------------------------------------------------------
@@ -299,12 +311,30 @@ class Fluid : public Synthesizer {
       QList<BankOffset*> bank_offsets;    // the offsets of the soundfont banks
       QList<MidiPatch*> patches;
 
-      QList<Voice*> freeVoices;           // unused synthesis processes
-      QList<Voice*> activeVoices;         // active synthesis processes
+      QVector<Voice*> freeVoices;         // unused synthesis processes
+      QVector<Voice*> activeVoices;       // active synthesis processes, Voice::slot is the index
+
+      // active voices ordered by kill priority, the least important
+      // on top; rebuilt on the first steal after any voice changed
+      struct StealCandidate {
+            float prio;
+            Voice* voice;
+            bool operator<(const StealCandidate& c) const { return prio > c.prio; }
+            };
+      QVector<StealCandidate> stealHeap;
+      bool stealHeapValid;
+      unsigned stealNoteId;               // noteid the priorities in stealHeap refer to
+
+      std::atomic<int> _allocated;
+      std::atomic<int> _stolen;
+      std::atomic<int> _active;
+      std::atomic<int> _maxActive;
       QString _error;                     // last error message
 
       static bool initialized;
 
+      float voicePriority(const Voice*) const;
+
       double sample_rate;                 // The sample rate
       float _masterTuning;                // usually 440.0
       double _tuning[128];                // the pitch of every key, in cents
@@ -402,6 +432,8 @@ class Fluid : public Synthesizer {
       void get_pitch_bend(int chan, int* ppitch_bend);
 
       void freeVoice(Voice* v);
+      void voiceChanged()            { stealHeapValid = false; }
+      VoiceStats voiceStats() const;
 
       double getPitch(int k) const   { return _tuning[k]; }
       float ct2hz_real(float cents)  { return powf(2.0f, (cents - 6900.0f) / 1200.0f) * _masterTuning; }
@@ -33,6 +33,8 @@ static bool debugMode = false;
 
 namespace FluidS {
 
+qint64 SFont::_cacheBudget = 256 * 1024 * 1024;
+
 //---------------------------------------------------------
 //   SFVersion
 //---------------------------------------------------------
@@ -52,10 +54,15 @@ SFont::SFont(Fluid* f)
       synth      = f;
       samplepos  = 0;
       samplesize = 0;
+      sampleData = 0;
+      _cacheSize = 0;
+      _useCount  = 0;
       }
 
 SFont::~SFont()
       {
+      foreach(Sample* s, sample)
+            s->waitLoaded();
       foreach(Sample* s, sample)
             delete s;
       foreach(Preset* p, presets)
@@ -78,6 +85,7 @@ bool SFont::read(const QString& s)
       f.setFileName(s);
       if (!load())
             return false;
+      mapSamples();
 
       foreach(Instrument* i, instruments) {
             if (!i->import_sfont())
@@ -91,6 +99,47 @@ bool SFont::read(const QString& s)
       return true;
       }
 
+//---------------------------------------------------------
+//   mapSamples
+//    map the sample data chunk; samples are then used in
+//    place (SF2) or decoded from memory (SF3) and the
+//    operating system pages them in as they are played
+//---------------------------------------------------------
+
+void SFont::mapSamples()
+      {
+      if (samplesize == 0)
+            return;
+      sampleFile.setFileName(f.fileName());
+      if (sampleFile.open(QIODevice::ReadOnly))
+            sampleData = sampleFile.map(samplepos, samplesize);
+      if (!sampleData) {
+            qDebug("SFont: cannot map sample data of <%s>", qPrintable(f.fileName()));
+            sampleFile.close();
+            }
+      }
+
+//---------------------------------------------------------
+//   trimCache
+//    release least recently used sample data not played
+//    by any voice until the cache fits into the budget
+//---------------------------------------------------------
+
+void SFont::trimCache()
+      {
+      while (_cacheSize > _cacheBudget) {
+            Sample* lru = 0;
+            foreach (Sample* s, sample) {
+                  if (s->state() == Sample::LOADED && s->ownsData() && s->refCount() == 0
+                     && (!lru || s->lastUse() < lru->lastUse()))
+                        lru = s;
+                  }
+            if (!lru)
+                  break;
+            lru->unload();
+            }
+      }
+
 //---------------------------------------------------------
 //   get_preset
 //---------------------------------------------------------
@@ -130,28 +179,28 @@ Preset::~Preset()
 //---------------------------------------------------------
 //   loadSamples
 //    this is called if the preset is associated with a
-//    channel
+//    channel; compressed samples are decoded in the
+//    background
 //---------------------------------------------------------
 
 void Preset::loadSamples()
       {
-//      sfont->synth->mutex.lock();
       if (_global_zone && _global_zone->instrument) {
             Instrument* i = _global_zone->instrument;
             if (i->global_zone && i->global_zone->sample)
-                  i->global_zone->sample->load();
+                  i->global_zone->sample->loadAsync();
             foreach(Zone* iz, i->zones)
-                  iz->sample->load();
+                  iz->sample->loadAsync();
             }
 
       foreach(Zone* z, zones) {
             Instrument* i = z->instrument;
             if (i->global_zone && i->global_zone->sample)
-                  i->global_zone->sample->load();
+                  i->global_zone->sample->loadAsync();
             foreach(Zone* iz, i->zones)
-                  iz->sample->load();
+                  iz->sample->loadAsync();
             }
-//      sfont->synth->mutex.unlock();
+      sfont->trimCache();
       }
 
 //---------------------------------------------------------
@@ -182,7 +231,7 @@ bool Preset::noteon(Fluid* synth, unsigned id, int chan, int key, int vel, doubl
                               continue;
                         /* check if the note falls into the key and velocity range of this
                            instrument */
-                        if (inst_zone->inside_range(key, vel) && (sample != 0)) {
+                        if (inst_zone->inside_range(key, vel) && sample->valid()) {
 
                               /* this is a good zone. allocate a new synthesis process and
                                  initialize it */
@@ -584,6 +633,15 @@ Sample::Sample(SFont* s)
       pitchadj    = 0;
       sampletype  = 0;
       data        = 0;
+      _state      = UNLOADED;
+      _ownsData   = false;
+      _bytes      = 0;
+      _lastUse    = 0;
+      _refCount   = 0;
+      _fileStart  = 0;
+      _fileEnd    = 0;
+      _fileLoopstart = 0;
+      _fileLoopend   = 0;
       amplitude_that_reaches_noise_floor_is_valid = false;
       amplitude_that_reaches_noise_floor = 0.0;
       }
@@ -594,66 +652,200 @@ Sample::Sample(SFont* s)
 
 Sample::~Sample()
       {
-      delete[] data;
+      if (_ownsData)
+            delete[] data;
       }
 
 //---------------------------------------------------------
 //   load
+//    called from a worker thread for compressed samples
 //---------------------------------------------------------
 
 void Sample::load()
       {
-      if (!_valid || data)
-            return;
-      QFile fd(sf->get_name());
-      if (!fd.open(QIODevice::ReadOnly))
+      loadData();
+      _state = LOADED;
+      }
+
+//---------------------------------------------------------
+//   loadAsync
+//    uncompressed samples are mapped at once, compressed
+//    ones are decoded in the background
+//---------------------------------------------------------
+
+void Sample::loadAsync()
+      {
+      _lastUse = sf->use();
+      if (!_valid || _state != UNLOADED)
             return;
+#ifdef SOUNDFONT3
       if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
-            if (!fd.seek(sf->samplePos() + start))
+            // claim the decode; LOADING is published only after
+            // _pending is set, unless the decode has already
+            // finished and set LOADED
+            int state = UNLOADED;
+            if (!_state.compare_exchange_strong(state, STARTING))
                   return;
+            _pending = QtConcurrent::run(this, &Sample::load);
+            state = STARTING;
+            _state.compare_exchange_strong(state, LOADING);
+            return;
             }
-      else {
-            if (!fd.seek(sf->samplePos() + start * sizeof(short)))
-                  return;
+#endif
+      int state = UNLOADED;
+      if (_state.compare_exchange_strong(state, LOADING))
+            load();
+      }
+
+//---------------------------------------------------------
+//   prepare
+//    start loading the sample data of a new or pending
+//    voice; returns true if the data can be played.
+//    The audio thread does not wait for a sample being
+//    decoded, the voice stays pending until the decode is
+//    done; offline rendering (block) waits for it.
+//
+//    The caller must hold a reference on the sample, this
+//    keeps unload() from releasing the data.
+//
+//    There is no resident attack head for compressed
+//    samples: the loop points of an SF3 sample are known
+//    only after decoding it and decoding just the head
+//    would need a Vorbis decoder state per sample. A note
+//    on a sample being decoded starts late instead.
+//---------------------------------------------------------
+
+bool Sample::prepare(bool block)
+      {
+      _lastUse = sf->use();
+      if (_state == UNLOADED)
+            loadAsync();
+      while (block && _valid && _state != LOADED) {
+            if (_state == UNLOADED)
+                  loadAsync();
+            else if (_state == LOADING)
+                  _pending.waitForFinished();
+            else
+                  QThread::yieldCurrentThread();
             }
+      return _valid && _state == LOADED && data;
+      }
+
+//---------------------------------------------------------
+//   unload
+//    release decoded sample data, it is reloaded on the
+//    next note on. Called from the gui thread; the state
+//    is claimed before the reference count is checked,
+//    a voice takes its reference before it checks the
+//    state (Voice::init(), prepare()), so one of the two
+//    sees the other.
+//---------------------------------------------------------
+
+void Sample::unload()
+      {
+      if (!_ownsData)
+            return;
+      int state = LOADED;
+      if (!_state.compare_exchange_strong(state, UNLOADING))
+            return;
+      if (_refCount) {
+            _state = LOADED;
+            return;
+            }
+      delete[] data;
+      data       = 0;
+      _ownsData  = false;
+      sf->cacheChanged(-_bytes);
+      _bytes     = 0;
+      start      = _fileStart;
+      end        = _fileEnd;
+      loopstart  = _fileLoopstart;
+      loopend    = _fileLoopend;
+      _state     = UNLOADED;
+      }
+
+//---------------------------------------------------------
+//   loadData
+//---------------------------------------------------------
+
+void Sample::loadData()
+      {
+      if (!_valid || data)
+            return;
+      _fileStart     = start;
+      _fileEnd       = end;
+      _fileLoopstart = loopstart;
+      _fileLoopend   = loopend;
+
+      const uchar* mapped = sf->mappedSampleData();
       unsigned int size = end - start;
 
       if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
 #ifdef SOUNDFONT3
-            char* p = new char[size];
-            if (fd.read(p, size) != size) {
-                  printf("  read %d failed\n", size);
-                  return;
+            if (mapped)
+                  decompressOggVorbis((const char*)mapped + start, size);
+            else {
+                  QFile fd(sf->get_name());
+                  if (!fd.open(QIODevice::ReadOnly) || !fd.seek(sf->samplePos() + start))
+                        return;
+                  char* p = new char[size];
+                  if (fd.read(p, size) != size) {
+                        printf("  read %d failed\n", size);
+                        delete[] p;
+                        return;
+                        }
+                  decompressOggVorbis(p, size);
+                  delete[] p;
+                  }
+            if (data) {
+                  _ownsData = true;
+                  _bytes    = qint64(end + 1) * sizeof(short);
+                  sf->cacheChanged(_bytes);
                   }
-            decompressOggVorbis(p, size);
-            delete[] p;
 #endif
             }
       else {
-            data = new short[size];
-            size *= sizeof(short);
-
-            if (fd.read((char*)data, size) != size)
-                  return;
+            if (mapped && QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
+                  // use the sample data in place
+                  data      = (short*)(mapped + start * sizeof(short));
+                  _ownsData = false;
+                  }
+            else {
+                  QFile fd(sf->get_name());
+                  if (!fd.open(QIODevice::ReadOnly) || !fd.seek(sf->samplePos() + start * sizeof(short)))
+                        return;
+                  data = new short[size];
+                  size *= sizeof(short);
+
+                  if (fd.read((char*)data, size) != size) {
+                        delete[] data;
+                        data = 0;
+                        return;
+                        }
 
-            if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
-                  unsigned char hi, lo;
-                  unsigned int i, j;
-                  short s;
-                  uchar* cbuf = (uchar*) data;
-                  for (i = 0, j = 0; j < size; i++) {
-                        lo = cbuf[j++];
-                        hi = cbuf[j++];
-                        s = (hi << 8) | lo;
-                        data[i] = s;
+                  if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
+                        unsigned char hi, lo;
+                        unsigned int i, j;
+                        short s;
+                        uchar* cbuf = (uchar*) data;
+                        for (i = 0, j = 0; j < size; i++) {
+                              lo = cbuf[j++];
+                              hi = cbuf[j++];
+                              s = (hi << 8) | lo;
+                              data[i] = s;
+                              }
                         }
+                  _ownsData = true;
+                  _bytes    = size;
+                  sf->cacheChanged(_bytes);
                   }
             end       -= (start + 1);       // marks last sample, contrary to SF spec.
             loopstart -= start;
             loopend   -= start;
             start      = 0;
             }
-      optimize();
+      if (data)
+            optimize();
       }
 
 //---------------------------------------------------------
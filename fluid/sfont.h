@@ -23,6 +23,7 @@
 #ifndef _FLUID_DEFSFONT_H
 #define _FLUID_DEFSFONT_H
 
+#include <atomic>
 #include "config.h"
 #include "fluid.h"
 
@@ -55,6 +56,12 @@ class SFont {
       unsigned samplepos;           // the position in the file at which the sample data starts
       unsigned samplesize;          // the size of the sample data
 
+      QFile sampleFile;             // kept open while the sample data is mapped
+      const uchar* sampleData;      // mapped sample data chunk, 0 if mapping failed
+      std::atomic<qint64> _cacheSize;     // bytes of sample data held in memory
+      std::atomic<unsigned> _useCount;    // LRU clock, advanced on program change and note on
+      static qint64 _cacheBudget;
+
       QList<Instrument*> instruments;
       QList<Preset*> presets;
       QList<Sample*> sample;
@@ -96,6 +103,7 @@ class SFont {
       void safe_fread(void *buf, int count);
       void safe_fseek(long ofs);
       bool load();
+      void mapSamples();
 
    public:
       SFont(Fluid* f);
@@ -115,6 +123,14 @@ class SFont {
       unsigned getSamplesize() const            { return samplesize; }
       const QList<Preset*> getPresets() const   { return presets; }
       SFVersion version() const                 { return _version; }
+      const uchar* mappedSampleData() const     { return sampleData; }
+
+      unsigned use()                            { return ++_useCount; }
+      void cacheChanged(qint64 bytes)           { _cacheSize += bytes; }
+      qint64 cacheSize() const                  { return _cacheSize; }
+      void trimCache();
+      static void setCacheBudget(qint64 bytes)  { _cacheBudget = bytes; }
+      static qint64 cacheBudget()               { return _cacheBudget; }
       friend class Preset;
       };
 
@@ -125,6 +141,20 @@ class SFont {
 class Sample {
       bool _valid;
 
+   public:
+      enum State { UNLOADED, STARTING, LOADING, LOADED, UNLOADING };
+
+   private:
+      std::atomic<int> _state;
+      QFuture<void> _pending;       // background decode of compressed samples
+      bool _ownsData;               // false if data points into the mapped file
+      qint64 _bytes;                // size of owned data
+      std::atomic<unsigned> _lastUse;
+      std::atomic<int> _refCount;   // number of voices playing this sample
+
+      // sample header as read from the file, load() rebases start/end
+      unsigned _fileStart, _fileEnd, _fileLoopstart, _fileLoopend;
+
    public:
       SFont* sf;
       unsigned int start;
@@ -152,10 +182,21 @@ class Sample {
       bool inRom() const;
       void optimize();
       void load();
+      void loadData();
+      void loadAsync();
+      bool prepare(bool block);
+      void unload();
+      void waitLoaded()             { _pending.waitForFinished(); }
+      State state() const           { return State(int(_state)); }
+      bool ownsData() const         { return _ownsData; }
+      unsigned lastUse() const      { return _lastUse; }
+      void ref()                    { ++_refCount; }
+      void deref()                  { --_refCount; }
+      int refCount() const          { return _refCount; }
       bool valid() const    { return _valid; }
       void setValid(bool v) { _valid = v; }
 #ifdef SOUNDFONT3
-      bool decompressOggVorbis(char* p, int size);
+      bool decompressOggVorbis(const char* p, int size);
 #endif
       };
 
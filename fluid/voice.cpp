@@ -23,6 +23,7 @@
 #include "sfont.h"
 #include "gen.h"
 #include "voice.h"
+#include "dsp.h"
 
 namespace FluidS {
 
@@ -63,6 +64,9 @@ Voice::Voice(Fluid* f)
       vel     = 0;
       channel = 0;
       sample  = 0;
+      sampleRef = false;
+      samplePending = false;
+      slot    = -1;
 
       /* The 'sustain' and 'finished' segments of the volume / modulation
        * envelope are constant. They are never affected by any modulator
@@ -115,6 +119,12 @@ void Voice::init(Sample* _sample, Channel* _channel, int _key, int _vel,
       channel        = _channel;
       mod_count      = 0;
       sample         = _sample;
+      sampleRef      = sample != 0;
+      if (sampleRef)
+            sample->ref();
+      // the reference is taken before the sample state is checked,
+      // see Sample::unload()
+      samplePending  = sampleRef && !sample->prepare(_fluid->offline());
       ticks          = 0;
       debug          = 0;
       has_looped     = false; // Will be set during voice_write when the 2nd loop point is reached
@@ -215,6 +225,23 @@ void Voice::write(unsigned n, float* out, float* reverb, float* chorus)
             off();
             return;
             }
+      if (samplePending) {
+            // the voice starts when the sample data are loaded;
+            // a note released before that is not played
+            if (!sample->prepare(_fluid->offline())) {
+                  if ((sample->state() == Sample::LOADED && !sample->data)
+                     || volenv_section >= FLUID_VOICE_ENVRELEASE)
+                        off();
+                  return;
+                  }
+            samplePending = false;
+            // the sample offsets were computed from the header
+            // of the undecoded sample
+            update_param(GEN_STARTADDROFS);
+            update_param(GEN_ENDADDROFS);
+            update_param(GEN_STARTLOOPADDROFS);
+            update_param(GEN_ENDLOOPADDROFS);
+            }
 
       float target_amp;    /* target amplitude */
       fluid_env_data_t* env_data;
@@ -1261,6 +1288,7 @@ void Voice::modulate_all()
  */
 void Voice::noteoff()
       {
+      _fluid->voiceChanged();
       if (channel && channel->sustained())
             status = FLUID_VOICE_SUSTAINED;
       else {
@@ -1340,6 +1368,10 @@ void Voice::off()
       modenv_section = FLUID_VOICE_ENVFINISHED;
       modenv_count   = 0;
       status         = FLUID_VOICE_OFF;
+      if (sampleRef) {
+            sample->deref();
+            sampleRef = false;
+            }
       _fluid->freeVoice(this);
       }
 
@@ -1718,19 +1750,7 @@ void Voice::effects(int count, float* out, float* reverb, float* chorus)
                   }
             }
 
-      for (int i = 0; i < count; i++) {
-            float v    = dsp_buf[i];
-
-            float vv   = v  * amp_left;
-            *out++    += vv;
-            *reverb++ += vv * amp_reverb;
-            *chorus++ += vv * amp_chorus;
-
-            vv         = v  * amp_right;
-            *out++    += vv;
-            *reverb++ += vv * amp_reverb;
-            *chorus++ += vv * amp_chorus;
-            }
+      dsp_mix(dsp_buf, count, amp_left, amp_right, amp_reverb, amp_chorus, out, reverb, chorus);
       }
 }
 
@@ -79,6 +79,7 @@ class Voice
 	unsigned char chan;             // the channel number, quick access for channel messages
 	unsigned char key;              // the key, quick acces for noteoff
 	unsigned char vel;              // the velocity
+	int slot;                       // index in Fluid::activeVoices, -1 if free
 
 	Channel* channel;
 	Generator gen[GEN_LAST];
@@ -87,6 +88,8 @@ class Voice
 	int mod_count;
 	bool has_looped;                /* Flag that is set as soon as the first loop is completed. */
 	Sample* sample;
+	bool sampleRef;                  // voice holds a reference on sample
+	bool samplePending;              // sample data are still being loaded
 	int check_sample_sanity_flag;   /* Flag that initiates, that sample-related parameters
 					           have to be checked. */
 	unsigned int ticks;
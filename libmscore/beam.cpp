@@ -992,17 +992,16 @@ static void initBeamMetrics()
 
 //---------------------------------------------------------
 //   beamMetric1
-//    table driven
+//    table driven; the table is filled on first use
+//    and only read afterwards, scores can be laid out
+//    in parallel
 //---------------------------------------------------------
 
 static Bm beamMetric1(bool up, char l1, char l2)
       {
-      static int initialized = false;
-      if (!initialized) {
-            initBeamMetrics();
-            initialized = true;
-            }
-      return bMetrics[Bm::key(up, l1, l2)];
+      static const bool initialized = (initBeamMetrics(), true);
+      Q_UNUSED(initialized);
+      return bMetrics.value(Bm::key(up, l1, l2));
       }
 
 //---------------------------------------------------------
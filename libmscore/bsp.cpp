@@ -27,7 +27,7 @@ class InsertItemBspTreeVisitor : public BspTreeVisitor
    public:
       Element* item;
 
-      inline void visit(QList<Element*> *items) { items->prepend(item); }
+      inline void visit(QVector<Element*>* items) { items->append(item); }
       };
 
 //---------------------------------------------------------
@@ -39,7 +39,16 @@ class RemoveItemBspTreeVisitor : public BspTreeVisitor
    public:
       Element* item;
 
-      inline void visit(QList<Element*> *items) { items->removeAll(item); }
+      void visit(QVector<Element*>* items) {
+            int n = items->size();
+            for (int i = 0; i < n; ++i) {
+                  if (items->at(i) == item) {
+                        (*items)[i] = items->at(n - 1);
+                        items->removeLast();
+                        return;
+                        }
+                  }
+            }
       };
 
 //---------------------------------------------------------
@@ -51,12 +60,11 @@ class FindItemBspTreeVisitor : public BspTreeVisitor
    public:
       QList<Element*> foundItems;
 
-      void visit(QList<Element*>* items) {
-            for (int i = 0; i < items->size(); ++i) {
-                  Element* item = items->at(i);
+      void visit(QVector<Element*>* items) {
+            for (Element* item : *items) {
                   if (!item->itemDiscovered) {
                         item->itemDiscovered = true;
-                        foundItems.prepend(item);
+                        foundItems.append(item);
                         }
                   }
             }
@@ -70,6 +78,7 @@ BspTree::BspTree()
    : leafCnt(0)
       {
       depth = 0;
+      stamp = 0;
       }
 
 //---------------------------------------------------------
@@ -93,10 +102,26 @@ void BspTree::initialize(const QRectF& rect, int n)
 
       nodes.resize((1 << (depth+1)) - 1);
       leaves.resize(1 << depth);
-      leaves.fill(QList<Element*>());
+      leaves.fill(QVector<Element*>());
+      entries.clear();
+      entries.reserve(n);
       initialize(rect, depth, 0);
       }
 
+//---------------------------------------------------------
+//   fits
+//    return true if the tree covers rect and its depth is
+//    still adequate for n items
+//---------------------------------------------------------
+
+bool BspTree::fits(const QRectF& r, int n) const
+      {
+      if (nodes.isEmpty() || r != rect)
+            return false;
+      int d = intmaxlog(n);
+      return d + 1 >= int(depth) && d <= int(depth) + 1;
+      }
+
 //---------------------------------------------------------
 //   clear
 //---------------------------------------------------------
@@ -106,6 +131,7 @@ void BspTree::clear()
       leafCnt = 0;
       nodes.clear();
       leaves.clear();
+      entries.clear();
       }
 
 //---------------------------------------------------------
@@ -113,21 +139,88 @@ void BspTree::clear()
 //---------------------------------------------------------
 
 void BspTree::insert(Element* element)
+      {
+      if (entries.contains(element))
+            return;
+      QRectF r = element->pageBoundingRect();
+      entries.insert(element, Entry { r, stamp });
+      insert(element, r);
+      }
+
+void BspTree::insert(Element* element, const QRectF& r)
       {
       InsertItemBspTreeVisitor insertVisitor;
       insertVisitor.item = element;
-      climbTree(&insertVisitor, element->pageBoundingRect());
+      climbTree(&insertVisitor, r);
       }
 
 //---------------------------------------------------------
 //   remove
+//    the item is looked up under the rect it was filed
+//    under, it may already be moved or deleted
 //---------------------------------------------------------
 
 void BspTree::remove(Element* element)
+      {
+      auto i = entries.find(element);
+      if (i == entries.end())
+            return;
+      remove(element, i.value().rect);
+      entries.erase(i);
+      }
+
+void BspTree::remove(Element* element, const QRectF& r)
       {
       RemoveItemBspTreeVisitor removeVisitor;
       removeVisitor.item = element;
-      climbTree(&removeVisitor, element->pageBoundingRect());
+      climbTree(&removeVisitor, r);
+      }
+
+//---------------------------------------------------------
+//   update
+//    refile element if its page bounding rect changed,
+//    insert it if it is not in the tree;
+//    return true if the tree was changed
+//---------------------------------------------------------
+
+bool BspTree::update(Element* element)
+      {
+      QRectF r = element->pageBoundingRect();
+      auto i = entries.find(element);
+      if (i == entries.end()) {
+            entries.insert(element, Entry { r, stamp });
+            insert(element, r);
+            return true;
+            }
+      Entry& entry = i.value();
+      entry.stamp = stamp;
+      if (entry.rect == r)
+            return false;
+      remove(element, entry.rect);
+      insert(element, r);
+      entry.rect = r;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   sync
+//    make the tree contain exactly items: update all of
+//    them and remove everything not seen
+//---------------------------------------------------------
+
+void BspTree::sync(const QList<Element*>& items)
+      {
+      ++stamp;
+      for (Element* e : items)
+            update(e);
+      for (auto i = entries.begin(); i != entries.end();) {
+            if (i.value().stamp != stamp) {
+                  remove(i.key(), i.value().rect);
+                  i = entries.erase(i);
+                  }
+            else
+                  ++i;
+            }
       }
 
 //---------------------------------------------------------
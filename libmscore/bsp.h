@@ -28,6 +28,10 @@ class Element;
 //---------------------------------------------------------
 //   BspTree
 //    binary space partitioning
+//    Every item is filed under the page bounding rect it
+//    had when it was inserted; update() and sync() move
+//    items whose rect changed, so the tree can be kept
+//    up to date without rebuilding it.
 //---------------------------------------------------------
 
 class BspTree
@@ -41,6 +45,10 @@ class BspTree
                   };
             Type type;
             };
+      struct Entry {
+            QRectF rect;            ///< page bounding rect the item is filed under
+            uint stamp;
+            };
    private:
       uint depth;
       void initialize(const QRectF& rect, int depth, int index);
@@ -50,9 +58,13 @@ class BspTree
       void findItems(QList<Element*>* foundItems, const QRectF& rect, int index);
       void findItems(QList<Element*>* foundItems, const QPointF& pos, int index);
       QRectF rectForIndex(int index) const;
+      void insert(Element* item, const QRectF& r);
+      void remove(Element* item, const QRectF& r);
 
       QVector<Node> nodes;
-      QVector<QList<Element*> > leaves;
+      QVector<QVector<Element*> > leaves;
+      QHash<Element*, Entry> entries;
+      uint stamp;
       int leafCnt;
       QRectF rect;
 
@@ -61,9 +73,14 @@ class BspTree
 
       void initialize(const QRectF& rect, int depth);
       void clear();
+      bool fits(const QRectF& rect, int n) const;
 
       void insert(Element* item);
       void remove(Element* item);
+      bool update(Element* item);
+      void sync(const QList<Element*>& items);
+      bool contains(Element* item) const          { return entries.contains(item); }
+      int count() const                           { return entries.size(); }
 
       QList<Element*> items(const QRectF& rect);
       QList<Element*> items(const QPointF& pos);
@@ -87,7 +104,7 @@ class BspTreeVisitor
       {
    public:
       virtual ~BspTreeVisitor() {}
-      virtual void visit(QList<Element*>* items) = 0;
+      virtual void visit(QVector<Element*>* items) = 0;
       };
 
 }     // namespace Ms
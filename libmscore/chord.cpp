@@ -993,9 +993,9 @@ void Chord::write(Xml& xml) const
 void Chord::read(XmlReader& e)
       {
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            const Tag tag = e.tag();
 
-            if (tag == "Note") {
+            if (tag == Tag::Note) {
                   Note* note = new Note(score());
                   // the note needs to know the properties of the track it belongs to
                   note->setTrack(track());
@@ -1005,49 +1005,49 @@ void Chord::read(XmlReader& e)
                   }
             else if (ChordRest::readProperties(e))
                   ;
-            else if (tag == "Stem") {
+            else if (tag == Tag::Stem) {
                   _stem = new Stem(score());
                   _stem->read(e);
                   add(_stem);
                   }
-            else if (tag == "Hook") {
+            else if (tag == Tag::Hook) {
                   _hook = new Hook(score());
                   _hook->read(e);
                   add(_hook);
                   }
-            else if (tag == "appoggiatura") {
+            else if (tag == Tag::appoggiatura) {
                   _noteType = NoteType::APPOGGIATURA;
                   e.readNext();
                   }
-            else if (tag == "acciaccatura") {
+            else if (tag == Tag::acciaccatura) {
                   _noteType = NoteType::ACCIACCATURA;
                   e.readNext();
                   }
-            else if (tag == "grace4") {
+            else if (tag == Tag::grace4) {
                   _noteType = NoteType::GRACE4;
                   e.readNext();
                   }
-            else if (tag == "grace16") {
+            else if (tag == Tag::grace16) {
                   _noteType = NoteType::GRACE16;
                   e.readNext();
                   }
-            else if (tag == "grace32") {
+            else if (tag == Tag::grace32) {
                   _noteType = NoteType::GRACE32;
                   e.readNext();
                   }
-            else if (tag == "grace8after") {
+            else if (tag == Tag::grace8after) {
                   _noteType = NoteType::GRACE8_AFTER;
                   e.readNext();
                   }
-            else if (tag == "grace16after") {
+            else if (tag == Tag::grace16after) {
                   _noteType = NoteType::GRACE16_AFTER;
                   e.readNext();
                   }
-            else if (tag == "grace32after") {
+            else if (tag == Tag::grace32after) {
                   _noteType = NoteType::GRACE32_AFTER;
                   e.readNext();
                   }
-            else if (tag == "StemDirection") {
+            else if (tag == Tag::StemDirection) {
                   QString val(e.readElementText());
                   if (val == "up")
                         _stemDirection = Direction::UP;
@@ -1056,29 +1056,29 @@ void Chord::read(XmlReader& e)
                   else
                         _stemDirection = Direction(val.toInt());
                   }
-            else if (tag == "noStem")
+            else if (tag == Tag::noStem)
                   _noStem = e.readInt();
-            else if (tag == "Arpeggio") {
+            else if (tag == Tag::Arpeggio) {
                   _arpeggio = new Arpeggio(score());
                   _arpeggio->setTrack(track());
                   _arpeggio->read(e);
                   _arpeggio->setParent(this);
                   }
-            else if (tag == "Glissando") {
+            else if (tag == Tag::Glissando) {
                   _glissando = new Glissando(score());
                   _glissando->setTrack(track());
                   _glissando->read(e);
                   _glissando->setParent(this);
                   }
-            else if (tag == "Tremolo") {
+            else if (tag == Tag::Tremolo) {
                   _tremolo = new Tremolo(score());
                   _tremolo->setTrack(track());
                   _tremolo->read(e);
                   _tremolo->setParent(this);
                   }
-            else if (tag == "tickOffset")       // obsolete
+            else if (tag == Tag::tickOffset)       // obsolete
                   ;
-            else if (tag == "ChordLine") {
+            else if (tag == Tag::ChordLine) {
                   ChordLine* cl = new ChordLine(score());
                   cl->read(e);
                   add(cl);
@@ -210,9 +210,9 @@ void ChordRest::writeProperties(Xml& xml) const
 
 bool ChordRest::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
+      const Tag tag = e.tag();
 
-      if (tag == "durationType") {
+      if (tag == Tag::durationType) {
             setDurationType(e.readElementText());
             if (actualDurationType().type() != TDuration::DurationType::V_MEASURE) {
                   if ((type() == ElementType::REST) &&
@@ -239,7 +239,7 @@ bool ChordRest::readProperties(XmlReader& e)
                         }
                   }
             }
-      else if (tag == "BeamMode") {
+      else if (tag == Tag::BeamMode) {
             QString val(e.readElementText());
             BeamMode bm = BeamMode::AUTO;
             if (val == "auto")
@@ -260,20 +260,20 @@ bool ChordRest::readProperties(XmlReader& e)
                   bm = BeamMode(val.toInt());
             _beamMode = BeamMode(bm);
             }
-      else if (tag == "Attribute" || tag == "Articulation") {     // obsolete: "Attribute"
+      else if (tag == Tag::Attribute || tag == Tag::Articulation) {     // obsolete: "Attribute"
             Articulation* atr = new Articulation(score());
             atr->read(e);
             add(atr);
             }
-      else if (tag == "leadingSpace") {
+      else if (tag == Tag::leadingSpace) {
             qDebug("ChordRest: leadingSpace obsolete"); // _extraLeadingSpace = Spatium(val.toDouble());
             e.skipCurrentElement();
             }
-      else if (tag == "trailingSpace") {
+      else if (tag == Tag::trailingSpace) {
             qDebug("ChordRest: trailingSpace obsolete"); // _extraTrailingSpace = Spatium(val.toDouble());
             e.skipCurrentElement();
             }
-      else if (tag == "Beam") {
+      else if (tag == Tag::Beam) {
             int id = e.readInt();
             Beam* beam = e.findBeam(id);
             if (beam)
@@ -281,9 +281,9 @@ bool ChordRest::readProperties(XmlReader& e)
             else
                   qDebug("Beam id %d not found", id);
             }
-      else if (tag == "small")
+      else if (tag == Tag::small)
             _small = e.readInt();
-      else if (tag == "Slur") {
+      else if (tag == Tag::Slur) {
             int id = e.intAttribute("number");
             Spanner* spanner = score()->findSpanner(id);
             if (!spanner)
@@ -318,9 +318,9 @@ bool ChordRest::readProperties(XmlReader& e)
                   }
             e.readNext();
             }
-      else if (tag == "duration")
+      else if (tag == Tag::duration)
             setDuration(e.readFraction());
-      else if (tag == "ticklen") {      // obsolete (version < 1.12)
+      else if (tag == Tag::ticklen) {      // obsolete (version < 1.12)
             int mticks = score()->sigmap()->timesig(e.tick()).timesig().ticks();
             int i = e.readInt();
             if (i == 0)
@@ -335,22 +335,22 @@ bool ChordRest::readProperties(XmlReader& e)
                   setDurationType(TDuration(f));
                   }
             }
-      else if (tag == "dots")
+      else if (tag == Tag::dots)
             setDots(e.readInt());
-      else if (tag == "move")
+      else if (tag == Tag::move)
             _staffMove = e.readInt();
-      else if (tag == "Lyrics" /*|| tag == "FiguredBass"*/) {
-            Element* element = Element::name2Element(tag, score());
+      else if (tag == Tag::Lyrics /*|| tag == Tag::FiguredBass*/) {
+            Element* element = Element::name2Element(e.name(), score());
             element->setTrack(e.track());
             element->read(e);
             add(element);
             }
-      else if (tag == "pos") {
+      else if (tag == Tag::pos) {
             QPointF pt = e.readPoint();
             if (score()->mscVersion() > 114)
                   setUserOff(pt * spatium());
             }
-      else if (tag == "offset") {
+      else if (tag == Tag::offset) {
             if (score()->mscVersion() > 114) // || voice() >= 2) {
                   DurationElement::readProperties(e);
             else if (type() == ElementType::REST) {
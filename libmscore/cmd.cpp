@@ -115,10 +115,23 @@ void Score::endCmd()
             return;
             }
 
+      int stick;
+      int etick;
+      bool local = undo()->current()->layoutRange(stick, etick);
+      bool noUndo = undo()->current()->childCount() <= 1;
       for (Score* s : scoreList()) {
+            if (!noUndo) {
+                  if (local)
+                        s->invalidateMidiCache(stick, etick);
+                  else
+                        s->invalidateMidiCache();
+                  }
             if (s->layoutAll()) {
                   s->_updateAll  = true;
-                  s->doLayout();
+                  if (local)
+                        s->doLayoutRange(stick, etick);
+                  else
+                        s->doLayout();
                   }
             const InputState& is = s->inputState();
             if (is.noteEntryMode() && is.segment())
@@ -129,7 +142,6 @@ void Score::endCmd()
                   }
             }
 
-      bool noUndo = undo()->current()->childCount() <= 1;
       if (!noUndo)
             setDirty(true);
       undo()->endMacro(noUndo);
@@ -192,10 +204,21 @@ void Score::end1()
 void Score::endUndoRedo()
       {
       updateSelection();
+      int stick;
+      int etick;
+      UndoCommand* cmd = undo()->last();
+      bool local = cmd && cmd->layoutRange(stick, etick);
       for (Score* score : scoreList()) {
+            if (local)
+                  score->invalidateMidiCache(stick, etick);
+            else
+                  score->invalidateMidiCache();
             if (score->layoutAll()) {
                   score->setUndoRedo(true);
-                  score->doLayout();
+                  if (local)
+                        score->doLayoutRange(stick, etick);
+                  else
+                        score->doLayout();
                   score->setUndoRedo(false);
                   score->setUpdateAll(true);
                   }
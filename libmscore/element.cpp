@@ -715,19 +715,19 @@ void Element::writeProperties(Xml& xml) const
 
 bool Element::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
+      const Tag tag = e.tag();
 
-      if (tag == "track")
+      if (tag == Tag::track)
             setTrack(e.readInt());
-      else if (tag == "color")
+      else if (tag == Tag::color)
             setColor(e.readColor());
-      else if (tag == "visible")
+      else if (tag == Tag::visible)
             setVisible(e.readInt());
-      else if (tag == "selected") // obsolete
+      else if (tag == Tag::selected) // obsolete
             e.readInt();
-      else if (tag == "userOff")
+      else if (tag == Tag::userOff)
             _userOff = e.readPoint();
-      else if (tag == "lid") {
+      else if (tag == Tag::lid) {
             int id = e.readInt();
             _links = score()->links().value(id);
             if (!_links) {
@@ -749,21 +749,21 @@ bool Element::readProperties(XmlReader& e)
             Q_ASSERT(!_links->contains(this));
             _links->append(this);
             }
-      else if (tag == "tick") {
+      else if (tag == Tag::tick) {
             int val = e.readInt();
             if (val >= 0 && type() != ElementType::SYMBOL  && ((type() != ElementType::GLISSANDO && type() != ElementType::FINGERING && (type() != ElementType::STAFF_TEXT || val == 0)) || score()->mscVersion() > 114))   // hack for 1.2, see #25572
                   e.setTick(score()->fileDivision(val));
             }
-      else if (tag == "offset")
+      else if (tag == Tag::offset)
             setUserOff(e.readPoint() * spatium());
-      else if (tag == "pos") {
+      else if (tag == Tag::pos) {
             QPointF pt = e.readPoint();
             if (score()->mscVersion() > 114)
                   _readPos = pt * spatium();
             }
-      else if (tag == "voice")
+      else if (tag == Tag::voice)
             setTrack((_track/VOICES)*VOICES + e.readInt());
-      else if (tag == "tag") {
+      else if (tag == Tag::tag) {
             QString val(e.readElementText());
             for (int i = 1; i < MAX_TAGS; i++) {
                   if (score()->layerTags()[i] == val) {
@@ -772,7 +772,7 @@ bool Element::readProperties(XmlReader& e)
                         }
                   }
             }
-      else if (tag == "placement")
+      else if (tag == Tag::placement)
             _placement = Placement(Ms::getProperty(P_ID::PLACEMENT, e).toInt());
       else
             return false;
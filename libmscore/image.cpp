@@ -239,16 +239,23 @@ QVariant Image::propertyDefault(P_ID id) const
 
 //---------------------------------------------------------
 //   draw
+//    pages are also drawn on worker threads for export:
+//    QPixmap and the cached buffer are only used on the
+//    gui thread, copies of an image share the svg renderer
 //---------------------------------------------------------
 
+static QMutex svgRenderMutex;
+
 void Image::draw(QPainter* painter) const
       {
       bool emptyImage = false;
       if (imageType == ImageType::SVG) {
             if (!svgDoc)
                   emptyImage = true;
-            else
+            else {
+                  QMutexLocker locker(&svgRenderMutex);
                   svgDoc->render(painter, bbox());
+                  }
             }
       else if (imageType == ImageType::RASTER) {
             if (rasterDoc == nullptr)
@@ -263,21 +270,29 @@ void Image::draw(QPainter* painter) const
                   if (score()->printing()) {
                         // use original image size for printing
                         painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                        painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                        painter->drawImage(QPointF(0, 0), *rasterDoc);
                         }
                   else {
                         QTransform t = painter->transform();
                         QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
                         t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
                         painter->setWorldTransform(t);
-                        if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
-                              buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                              _dirty = false;
+                        if (QThread::currentThread() != qApp->thread()) {
+                              if (rasterDoc->isNull())
+                                    emptyImage = true;
+                              else
+                                    painter->drawImage(QPointF(0.0, 0.0), rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+                              }
+                        else {
+                              if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
+                                    buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+                                    _dirty = false;
+                                    }
+                              if (buffer.isNull())
+                                    emptyImage = true;
+                              else
+                                    painter->drawPixmap(QPointF(0.0, 0.0), buffer);
                               }
-                        if (buffer.isNull())
-                              emptyImage = true;
-                        else
-                              painter->drawPixmap(QPointF(0.0, 0.0), buffer);
                         }
                   painter->restore();
                   }
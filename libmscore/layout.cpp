@@ -1105,9 +1105,16 @@ void Score::beamGraceNotes(Chord* mainNote, bool after)
 //---------------------------------------------------------
 
 void Score::layoutStage2()
+      {
+      if (firstMeasure())
+            layoutStage2(firstMeasure(), lastMeasure());
+      }
+
+void Score::layoutStage2(Measure* sm, Measure* em)
       {
       int tracks = nstaves() * VOICES;
       bool crossMeasure = styleB(StyleIdx::crossMeasureValues);
+      int etick = em->endTick();
 
       for (int track = 0; track < tracks; ++track) {
             if (!staff(track2staff(track))->show())
@@ -1118,7 +1125,7 @@ void Score::layoutStage2()
 
             BeamMode bm = BeamMode::AUTO;
             SegmentType st = SegmentType::ChordRest;
-            for (Segment* segment = firstSegment(st); segment; segment = segment->next1(st)) {
+            for (Segment* segment = sm->first(st); segment && segment->tick() < etick; segment = segment->next1(st)) {
                   ChordRest* cr = static_cast<ChordRest*>(segment->element(track));
                   if (cr == 0)
                         continue;
@@ -1226,13 +1233,120 @@ void Score::layoutStage2()
 
 void Score::layoutStage3()
       {
-      SegmentType st = SegmentType::ChordRest;
-      for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
-            if (!staff(staffIdx)->show())
-                  continue;
-            for (Segment* segment = firstSegment(st); segment; segment = segment->next1(st)) {
-                  layoutChords1(segment, staffIdx);
+      if (firstMeasure())
+            layoutStage3(firstMeasure(), lastMeasure());
+      }
+
+//---------------------------------------------------------
+//   LayoutTile
+//    one measure of one staff
+//---------------------------------------------------------
+
+struct LayoutTile {
+      Measure* measure;
+      int staffIdx;
+      };
+
+void Score::layoutStage3(Measure* sm, Measure* em)
+      {
+      //
+      // layoutChords1() only touches the chords of one staff
+      // in one segment and only reads style, score font and
+      // _noteHeadWidth, so measure x staff tiles can be
+      // laid out concurrently
+      //
+      QList<LayoutTile> tiles;
+      for (Measure* m = sm; m; m = m->nextMeasure()) {
+            for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+                  if (staff(staffIdx)->show())
+                        tiles.append({ m, staffIdx });
                   }
+            if (m == em)
+                  break;
+            }
+      auto layoutTile = [this](const LayoutTile& tile) {
+            SegmentType st = SegmentType::ChordRest;
+            for (Segment* segment = tile.measure->first(st); segment; segment = segment->next(st))
+                  layoutChords1(segment, tile.staffIdx);
+            };
+      if (tiles.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1)
+            QtConcurrent::blockingMap(tiles, layoutTile);
+      else {
+            for (const LayoutTile& tile : tiles)
+                  layoutTile(tile);
+            }
+      }
+
+//---------------------------------------------------------
+//   layoutStage4
+//    place beams, stems, ties and articulations of all
+//    segments from fs up to tick etick
+//---------------------------------------------------------
+
+void Score::layoutStage4(Segment* fs, int etick)
+      {
+      int tracks = nstaves() * VOICES;
+      for (int track = 0; track < tracks; ++track) {
+            for (Segment* segment = fs; segment && segment->tick() < etick; segment = segment->next1MM()) {
+                  if (track == tracks-1) {
+                        for (Element* e : segment->annotations())
+                              e->layout();
+                        }
+                  Element* e = segment->element(track);
+                  if (!e)
+                        continue;
+                  if (e->isChordRest()) {
+                        if (!staff(track2staff(track))->show())
+                              continue;
+                        ChordRest* cr = static_cast<ChordRest*>(e);
+                        if (cr->beam() && cr->beam()->elements().front() == cr)
+                              cr->beam()->layout();
+
+                        if (cr->type() == ElementType::CHORD) {
+                              Chord* c = static_cast<Chord*>(cr);
+                              for (Chord* cc : c->graceNotes()) {
+                                    if (cc->beam() && cc->beam()->elements().front() == cc)
+                                          cc->beam()->layout();
+                                    for (Element* e : cc->el()) {
+                                          if (e->type() == ElementType::SLUR)
+                                                e->layout();
+                                          }
+                                    }
+                              c->layoutStem();
+                              c->layoutArpeggio2();
+                              for (Note* n : c->notes()) {
+                                    Tie* tie = n->tieFor();
+                                    if (tie)
+                                          tie->layout();
+                                    for (Spanner* sp : n->spannerFor())
+                                          sp->layout();
+                                    }
+                              }
+                        cr->layoutArticulations();
+                        }
+                  else if (e->type() == ElementType::BAR_LINE)
+                        e->layout();
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   renumberMeasures
+//---------------------------------------------------------
+
+void Score::renumberMeasures()
+      {
+      int measureNo = 0;
+      for (Measure* measure = firstMeasure(); measure; measure = measure->nextMeasure()) {
+            measureNo += measure->noOffset();
+            measure->setNo(measureNo);
+            if (measure->sectionBreak() && measure->sectionBreak()->startWithMeasureOne())
+                  measureNo = 0;
+            else if (measure->irregular())      // dont count measure
+                  ;
+            else
+                  ++measureNo;
+            measure->setBreakMMRest(false);
             }
       }
 
@@ -1247,6 +1361,8 @@ void Score::doLayout()
       {
       _scoreFont = ScoreFont::fontFactory(_style.value(StyleIdx::MusicalSymbolFont).toString());
       _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / (MScore::DPI * SPATIUM20));
+      if (MScore::debugMode)
+            Text::resetLayoutStats();
 
       if (layoutFlags & LayoutFlag::FIX_TICKS)
             fixTicks();
@@ -1255,27 +1371,13 @@ void Score::doLayout()
       if (layoutFlags & LayoutFlag::PLAY_EVENTS)
             createPlayEvents();
 
-      int measureNo = 0;
-      for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-            Measure* measure = static_cast<Measure*>(m);
-            measureNo += measure->noOffset();
-            measure->setNo(measureNo);
-            if (measure->sectionBreak() && measure->sectionBreak()->startWithMeasureOne())
-                  measureNo = 0;
-            else if (measure->irregular())      // dont count measure
-                  ;
-            else
-                  ++measureNo;
-            measure->setBreakMMRest(false);
-            }
+      renumberMeasures();
 
       for (MeasureBase* m = first(); m; m = m->next())
             m->layout0();
 
       layoutFlags = 0;
 
-      int nstaves = _staves.size();
-
       if (_staves.isEmpty() || first() == 0) {
             // score is empty
             qDeleteAll(_pages);
@@ -1306,49 +1408,8 @@ void Score::doLayout()
       //   place Spanner & beams
       //---------------------------------------------------
 
-      int tracks = nstaves * VOICES;
-      for (int track = 0; track < tracks; ++track) {
-            for (Segment* segment = firstSegmentMM(); segment; segment = segment->next1MM()) {
-                  if (track == tracks-1) {
-                        for (Element* e : segment->annotations())
-                              e->layout();
-                        }
-                  Element* e = segment->element(track);
-                  if (!e)
-                        continue;
-                  if (e->isChordRest()) {
-                        if (!staff(track2staff(track))->show())
-                              continue;
-                        ChordRest* cr = static_cast<ChordRest*>(e);
-                        if (cr->beam() && cr->beam()->elements().front() == cr)
-                              cr->beam()->layout();
+      layoutStage4(firstSegmentMM(), INT_MAX);
 
-                        if (cr->type() == ElementType::CHORD) {
-                              Chord* c = static_cast<Chord*>(cr);
-                              for (Chord* cc : c->graceNotes()) {
-                                    if (cc->beam() && cc->beam()->elements().front() == cc)
-                                          cc->beam()->layout();
-                                    for (Element* e : cc->el()) {
-                                          if (e->type() == ElementType::SLUR)
-                                                e->layout();
-                                          }
-                                    }
-                              c->layoutStem();
-                              c->layoutArpeggio2();
-                              for (Note* n : c->notes()) {
-                                    Tie* tie = n->tieFor();
-                                    if (tie)
-                                          tie->layout();
-                                    for (Spanner* sp : n->spannerFor())
-                                          sp->layout();
-                                    }
-                              }
-                        cr->layoutArticulations();
-                        }
-                  else if (e->type() == ElementType::BAR_LINE)
-                        e->layout();
-                  }
-            }
       for (const std::pair<int,Spanner*>& s : _spanner.map()) {
             Spanner* sp = s.second;
             if (sp->type() == ElementType::OTTAVA && sp->tick2() == -1) {
@@ -1379,6 +1440,213 @@ void Score::doLayout()
             viewer.at(i)->updateLoopCursors();
       }
 
+      _layoutAll = false;
+      if (MScore::debugMode) {
+            TextLayoutStats s = Text::layoutStats();
+            qDebug("layout: text fonts %d hits %d misses, text layouts %d reused %d parsed",
+               s.fontHits, s.fontMisses, s.layoutHits, s.layoutMisses);
+            }
+      }
+
+//---------------------------------------------------------
+//   beamedFromPrevious
+//    return true if a beam starting in a previous measure
+//    reaches into m
+//---------------------------------------------------------
+
+static bool beamedFromPrevious(Measure* m)
+      {
+      Segment* s = m->first(SegmentType::ChordRest);
+      if (!s)
+            return false;
+      int tracks = m->score()->ntracks();
+      for (int track = 0; track < tracks; ++track) {
+            ChordRest* cr = static_cast<ChordRest*>(s->element(track));
+            if (cr && cr->beam() && cr->beam()->elements().front()->measure() != m)
+                  return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   doLayoutRange
+//    incremental layout after a change local to the
+//    ticks [stick, etick]:
+//    - only the measures in range run the per measure
+//      layout stages
+//    - systems are rebroken from the first changed system
+//      until the line breaks settle back to the previous
+//      layout
+//    Falls back to doLayout() if the change can affect
+//    the whole score.
+//---------------------------------------------------------
+
+void Score::doLayoutRange(int stick, int etick)
+      {
+      if ((layoutFlags & LayoutFlag::FIX_TICKS)
+         || layoutMode() == LayoutMode::LINE
+         || styleB(StyleIdx::createMultiMeasureRests)
+         || _staves.isEmpty() || first() == 0 || _systems.isEmpty()) {
+            doLayout();
+            return;
+            }
+      Measure* sm = tick2measure(stick);
+      Measure* em = tick2measure(etick);
+      if (!sm || !em || !sm->system() || _systems.indexOf(sm->system()) == -1) {
+            doLayout();
+            return;
+            }
+
+      _scoreFont = ScoreFont::fontFactory(_style.value(StyleIdx::MusicalSymbolFont).toString());
+      _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / (MScore::DPI * SPATIUM20));
+
+      if (layoutFlags & LayoutFlag::FIX_PITCH_VELO)
+            updateVelo();
+      if (layoutFlags & LayoutFlag::PLAY_EVENTS)
+            createPlayEvents();
+      layoutFlags = 0;
+
+      renumberMeasures();
+
+      // beams, ties and cross measure values can reach
+      // over bar lines: include neighbour measures
+      if (sm->prevMeasure())
+            sm = sm->prevMeasure();
+      if (em->nextMeasure())
+            em = em->nextMeasure();
+      while (sm->prevMeasure() && beamedFromPrevious(sm))
+            sm = sm->prevMeasure();
+      while (em->nextMeasure() && beamedFromPrevious(em->nextMeasure()))
+            em = em->nextMeasure();
+
+      for (MeasureBase* m = sm; m; m = m->next()) {
+            m->layout0();
+            if (m == em)
+                  break;
+            }
+      for (Measure* m = sm; m; m = m->nextMeasure()) {
+            m->layoutStage1();
+            if (m == em)
+                  break;
+            }
+      layoutStage2(sm, em);
+      layoutStage3(sm, em);
+
+      //---------------------------------------------------
+      //   rebreak systems
+      //---------------------------------------------------
+
+      int startSystem = _systems.indexOf(sm->system());
+      while (startSystem > 0 && _systems[startSystem]->sameLine())
+            --startSystem;
+
+      bool firstSystem        = true;
+      bool startWithLongNames = true;
+      for (int i = startSystem - 1; i >= 0; --i) {
+            if (_systems[i]->isVbox())
+                  continue;
+            Measure* lm        = _systems[i]->lastMeasure();
+            firstSystem        = lm && lm->sectionBreak() && _layoutMode != LayoutMode::FLOAT;
+            startWithLongNames = firstSystem && lm->sectionBreak()->startWithLongNames();
+            break;
+            }
+
+      // remember the previous layout
+      int nSystems = _systems.size();
+      QList<MeasureBase*> oldStart;
+      QList<System*> oldSystems;
+      QList<Element*> oldPage;
+      QList<QPointF> oldPos;
+      for (int i = 0; i < nSystems; ++i) {
+            System* system = _systems[i];
+            if (i >= startSystem) {
+                  bool rowStart = !system->sameLine() && !system->measures().isEmpty();
+                  oldStart.append(rowStart ? system->measures().front() : 0);
+                  }
+            oldSystems.append(system);
+            oldPage.append(system->parent());
+            oldPos.append(system->pos());
+            }
+
+      curMeasure = _systems[startSystem]->measures().front();
+      curSystem  = startSystem;
+      if (!layoutSystems(firstSystem, startWithLongNames, em->tick(), oldStart)) {
+            // TODO: make undoable:
+            while (_systems.size() > curSystem)
+                  _systems.takeLast();
+            }
+      int endSystem = curSystem;
+
+      int lstick = qMin(sm->tick(), _systems[startSystem]->measures().front()->tick());
+      int letick = qMax(em->endTick(), _systems[endSystem-1]->measures().back()->endTick());
+      Measure* lsm = tick2measure(lstick);
+
+      //---------------------------------------------------
+      //   place Spanner & beams
+      //---------------------------------------------------
+
+      layoutStage4(lsm->first(), letick);
+
+      // copy: layout of a spanner may query the spanner map again
+      // spanner segments can be in systems out of range: remember
+      // the systems they leave and enter
+      QSet<System*> changed;
+      std::vector< ::Interval<Spanner*> > sl = _spanner.findOverlapping(lstick, letick);
+      for (const ::Interval<Spanner*>& i : sl) {
+            Spanner* sp = i.value;
+            if (sp->type() == ElementType::TIE || sp->tick() == -1)
+                  continue;
+            for (SpannerSegment* ss : sp->spannerSegments())
+                  changed.insert(ss->system());
+            sp->layout();
+            for (SpannerSegment* ss : sp->spannerSegments())
+                  changed.insert(ss->system());
+            }
+
+      for (int i = startSystem; i < endSystem; ++i) {
+            if (!_systems[i]->isVbox())
+                  _systems[i]->layout2();
+            }
+      layoutPages();
+      for (Measure* m = lsm; m && m->tick() < letick; m = m->nextMeasureMM())
+            m->layout2();
+
+      //---------------------------------------------------
+      //   update the spatial index for changed systems only,
+      //   on the page they left and on the page they are on
+      //---------------------------------------------------
+
+      for (int i = 0; i < _systems.size(); ++i) {
+            System* system = _systems[i];
+            if ((i >= startSystem && i < endSystem) || i >= nSystems || system != oldSystems[i]
+               || system->parent() != oldPage[i] || system->pos() != oldPos[i]) {
+                  changed.insert(system);
+                  if (i < nSystems)
+                        changed.insert(oldSystems[i]);
+                  }
+            }
+      for (int i = _systems.size(); i < nSystems; ++i)
+            changed.insert(oldSystems[i]);
+      changed.remove(0);
+
+      QMultiHash<Element*, System*> dirty;
+      for (int i = 0; i < nSystems; ++i) {
+            if (changed.contains(oldSystems[i]))
+                  dirty.insert(oldPage[i], oldSystems[i]);
+            }
+      for (System* system : _systems) {
+            if (changed.contains(system))
+                  dirty.insert(system->parent(), system);
+            }
+      for (Page* page : _pages) {
+            for (System* system : dirty.values(page))
+                  page->rebuildBspTree(system);
+            }
+
+      for (MuseScoreView* v : viewer) {
+            v->layoutChanged();
+            v->updateLoopCursors();
+            }
       _layoutAll = false;
       }
 
@@ -2775,14 +3043,34 @@ QList<System*> Score::layoutSystemRow(qreal rowWidth, bool isFirstSystem, bool u
 
 void Score::layoutSystems()
       {
-      curMeasure              = _showVBox ? firstMM() : firstMeasureMM();
-      curSystem               = 0;
-      bool firstSystem        = true;
-      bool startWithLongNames = true;
+      curMeasure = _showVBox ? firstMM() : firstMeasureMM();
+      curSystem  = 0;
+      layoutSystems(true, true, 0, QList<MeasureBase*>());
 
-      qreal w  = pageFormat()->printableWidth() * MScore::DPI;
+      // TODO: make undoable:
+      while (_systems.size() > curSystem)
+            _systems.takeLast();
+      }
+
+//---------------------------------------------------------
+//   layoutSystems
+//    break measures from curMeasure on into systems,
+//    starting at curSystem
+//    oldStart holds the first measure of every system
+//    row from curSystem on, as found by the previous layout.
+//    Stop and return true as soon as a system after tick
+//    etick starts with the same measure again.
+//---------------------------------------------------------
+
+bool Score::layoutSystems(bool firstSystem, bool startWithLongNames, int etick, const QList<MeasureBase*>& oldStart)
+      {
+      int startSystem = curSystem;
+      qreal w         = pageFormat()->printableWidth() * MScore::DPI;
 
       while (curMeasure) {
+            int idx = curSystem - startSystem;
+            if (idx > 0 && idx < oldStart.size() && oldStart[idx] == curMeasure && curMeasure->tick() > etick)
+                  return true;      // line breaks did settle
             ElementType t = curMeasure->type();
             if (t == ElementType::VBOX || t == ElementType::TBOX || t == ElementType::FBOX) {
                   System* system = getNextSystem(false, true);
@@ -2816,9 +3104,7 @@ void Score::layoutSystems()
                         qDebug("empty system!");
                   }
             }
-      // TODO: make undoable:
-      while (_systems.size() > curSystem)
-            _systems.takeLast();
+      return false;
       }
 
 //---------------------------------------------------------
@@ -94,10 +94,13 @@ MStaff::MStaff()
       _vspacerDown = 0;
       _visible     = true;
       _slashStyle  = false;
+      _events      = 0;
+      _eventsTied  = false;
       }
 
 MStaff::~MStaff()
       {
+      delete _events;
       delete _noText;
       delete lines;
       delete _vspacerUp;
@@ -115,6 +118,8 @@ MStaff::MStaff(const MStaff& m)
       _vspacerDown = 0;
       _visible     = m._visible;
       _slashStyle  = m._slashStyle;
+      _events      = 0;
+      _eventsTied  = false;
       }
 
 //---------------------------------------------------------
@@ -1792,11 +1797,11 @@ void Measure::read(XmlReader& e, int staffIdx)
       Fraction timeStretch(staff->timeStretch(tick()));
 
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            const Tag tag = e.tag();
 
-            if (tag == "tick")
+            if (tag == Tag::tick)
                   e.setTick(e.readInt());
-            else if (tag == "BarLine") {
+            else if (tag == Tag::BarLine) {
                   BarLine* barLine = new BarLine(score());
                   barLine->setTrack(e.track());
                   barLine->read(e);
@@ -1834,7 +1839,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   segment = getSegment(st, e.tick());
                   segment->add(barLine);
                   }
-            else if (tag == "Chord") {
+            else if (tag == Tag::Chord) {
 
                   Chord* chord = new Chord(score());
                   chord->setTrack(e.track());
@@ -1910,7 +1915,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         e.rtick() += crticks;
                         }
                   }
-            else if (tag == "Rest") {
+            else if (tag == Tag::Rest) {
                   Rest* rest = new Rest(score());
                   rest->setDurationType(TDuration::DurationType::V_MEASURE);
                   rest->setDuration(timesig()/timeStretch);
@@ -1925,14 +1930,14 @@ void Measure::read(XmlReader& e, int staffIdx)
 
                   e.rtick() += ts.ticks();
                   }
-            else if (tag == "Breath") {
+            else if (tag == Tag::Breath) {
                   Breath* breath = new Breath(score());
                   breath->setTrack(e.track());
                   breath->read(e);
                   segment = getSegment(SegmentType::Breath, e.tick());
                   segment->add(breath);
                   }
-            else if (tag == "endSpanner") {
+            else if (tag == Tag::endSpanner) {
                   int id = e.attribute("id").toInt();
                   Spanner* spanner = score()->findSpanner(id);
                   if (spanner) {
@@ -1961,7 +1966,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   e.readNext();
                   }
-            else if (tag == "Slur") {
+            else if (tag == Tag::Slur) {
                   Slur *sl = new Slur(score());
                   sl->setTick(e.tick());
                   sl->read(e);
@@ -1974,13 +1979,13 @@ void Measure::read(XmlReader& e, int staffIdx)
                         sl->setTick2(sv->tick2);
                         }
                   }
-            else if (tag == "HairPin"
-               || tag == "Pedal"
-               || tag == "Ottava"
-               || tag == "Trill"
-               || tag == "TextLine"
-               || tag == "Volta") {
-                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(tag, score()));
+            else if (tag == Tag::HairPin
+               || tag == Tag::Pedal
+               || tag == Tag::Ottava
+               || tag == Tag::Trill
+               || tag == Tag::TextLine
+               || tag == Tag::Volta) {
+                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(e.name(), score()));
                   sp->setTrack(e.track());
                   sp->setTick(e.tick());
                   sp->setAnchor(Spanner::Anchor::SEGMENT);
@@ -1995,7 +2000,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         sp->setTrack2(sv->track2);
                         }
                   }
-            else if (tag == "RepeatMeasure") {
+            else if (tag == Tag::RepeatMeasure) {
                   RepeatMeasure* rm = new RepeatMeasure(score());
                   rm->setTrack(e.track());
                   rm->read(e);
@@ -2003,7 +2008,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   segment->add(rm);
                   e.setTick(e.tick() + ticks());
                   }
-            else if (tag == "Clef") {
+            else if (tag == Tag::Clef) {
                   Clef* clef = new Clef(score());
                   clef->setTrack(e.track());
                   clef->read(e);
@@ -2051,7 +2056,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   segment->add(clef);
                   }
-            else if (tag == "TimeSig") {
+            else if (tag == Tag::TimeSig) {
                   TimeSig* ts = new TimeSig(score());
                   ts->setTrack(e.track());
                   ts->read(e);
@@ -2083,7 +2088,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                               }
                         }
                   }
-            else if (tag == "KeySig") {
+            else if (tag == Tag::KeySig) {
                   KeySig* ks = new KeySig(score());
                   ks->setTrack(e.track());
                   ks->read(e);
@@ -2095,8 +2100,8 @@ void Measure::read(XmlReader& e, int staffIdx)
                   if (!courtesySig)
                         staff->setKey(currTick, ks->key());
                   }
-            else if (tag == "Lyrics") {       // obsolete, keep for compatibility with version 114
-                  Element* element = Element::name2Element(tag, score());
+            else if (tag == Tag::Lyrics) {       // obsolete, keep for compatibility with version 114
+                  Element* element = Element::name2Element(e.name(), score());
                   element->setTrack(e.track());
                   element->read(e);
                   segment       = getSegment(SegmentType::ChordRest, e.tick());
@@ -2106,7 +2111,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   else
                         cr->add(element);
                   }
-            else if (tag == "Text") {
+            else if (tag == Tag::Text) {
                   Text* t = new Text(score());
                   t->setTrack(e.track());
                   t->read(e);
@@ -2122,7 +2127,7 @@ void Measure::read(XmlReader& e, int staffIdx)
             //----------------------------------------------------
             // Annotation
 
-            else if (tag == "Dynamic") {
+            else if (tag == Tag::Dynamic) {
                   Dynamic* dyn = new Dynamic(score());
                   dyn->setTrack(e.track());
                   dyn->read(e);
@@ -2131,29 +2136,29 @@ void Measure::read(XmlReader& e, int staffIdx)
                   segment = getSegment(SegmentType::ChordRest, e.tick());
                   segment->add(dyn);
                   }
-            else if (tag == "Harmony"
-               || tag == "FretDiagram"
-               || tag == "Symbol"
-               || tag == "Tempo"
-               || tag == "StaffText"
-               || tag == "RehearsalMark"
-               || tag == "InstrumentChange"
-               || tag == "Marker"
-               || tag == "Jump"
-               || tag == "StaffState"
-               || tag == "FiguredBass"
+            else if (tag == Tag::Harmony
+               || tag == Tag::FretDiagram
+               || tag == Tag::Symbol
+               || tag == Tag::Tempo
+               || tag == Tag::StaffText
+               || tag == Tag::RehearsalMark
+               || tag == Tag::InstrumentChange
+               || tag == Tag::Marker
+               || tag == Tag::Jump
+               || tag == Tag::StaffState
+               || tag == Tag::FiguredBass
                ) {
-                  Element* el = Element::name2Element(tag, score());
+                  Element* el = Element::name2Element(e.name(), score());
                   el->setTrack(e.track());
                   el->read(e);
                   segment = getSegment(SegmentType::ChordRest, e.tick());
                   segment->add(el);
                   }
-            else if (tag == "Image") {
+            else if (tag == Tag::Image) {
                   if (MScore::noImages)
                         e.skipCurrentElement();
                   else {
-                        Element* el = Element::name2Element(tag, score());
+                        Element* el = Element::name2Element(e.name(), score());
                         el->setTrack(e.track());
                         el->read(e);
                         segment = getSegment(SegmentType::ChordRest, e.tick());
@@ -2161,24 +2166,24 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   }
             //----------------------------------------------------
-            else if (tag == "stretch")
+            else if (tag == Tag::stretch)
                   _userStretch = e.readDouble();
-            else if (tag == "LayoutBreak") {
+            else if (tag == Tag::LayoutBreak) {
                   LayoutBreak* lb = new LayoutBreak(score());
                   lb->read(e);
                   add(lb);
                   }
-            else if (tag == "noOffset")
+            else if (tag == Tag::noOffset)
                   _noOffset = e.readInt();
-            else if (tag == "irregular") {
+            else if (tag == Tag::irregular) {
                   _irregular = true;
                   e.readNext();
                   }
-            else if (tag == "breakMultiMeasureRest") {
+            else if (tag == Tag::breakMultiMeasureRest) {
                   _breakMultiMeasureRest = true;
                   e.readNext();
                   }
-            else if (tag == "Tuplet") {
+            else if (tag == Tag::Tuplet) {
                   Tuplet* tuplet = new Tuplet(score());
                   tuplet->setTrack(e.track());
                   tuplet->setTick(e.tick());
@@ -2186,15 +2191,15 @@ void Measure::read(XmlReader& e, int staffIdx)
                   tuplet->read(e);
                   e.addTuplet(tuplet);
                   }
-            else if (tag == "startRepeat") {
+            else if (tag == Tag::startRepeat) {
                   _repeatFlags |= Repeat::START;
                   e.readNext();
                   }
-            else if (tag == "endRepeat") {
+            else if (tag == Tag::endRepeat) {
                   _repeatCount = e.readInt();
                   _repeatFlags |= Repeat::END;
                   }
-            else if (tag == "vspacer" || tag == "vspacerDown") {
+            else if (tag == Tag::vspacer || tag == Tag::vspacerDown) {
                   if (staves[staffIdx]->_vspacerDown == 0) {
                         Spacer* spacer = new Spacer(score());
                         spacer->setSpacerType(SpacerType::DOWN);
@@ -2203,7 +2208,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   staves[staffIdx]->_vspacerDown->setGap(e.readDouble() * _spatium);
                   }
-            else if (tag == "vspacer" || tag == "vspacerUp") {
+            else if (tag == Tag::vspacer || tag == Tag::vspacerUp) {
                   if (staves[staffIdx]->_vspacerUp == 0) {
                         Spacer* spacer = new Spacer(score());
                         spacer->setSpacerType(SpacerType::UP);
@@ -2212,20 +2217,20 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   staves[staffIdx]->_vspacerUp->setGap(e.readDouble() * _spatium);
                   }
-            else if (tag == "visible")
+            else if (tag == Tag::visible)
                   staves[staffIdx]->_visible = e.readInt();
-            else if (tag == "slashStyle")
+            else if (tag == Tag::slashStyle)
                   staves[staffIdx]->_slashStyle = e.readInt();
-            else if (tag == "Beam") {
+            else if (tag == Tag::Beam) {
                   Beam* beam = new Beam(score());
                   beam->setTrack(e.track());
                   beam->read(e);
                   beam->setParent(0);
                   e.addBeam(beam);
                   }
-            else if (tag == "Segment")
+            else if (tag == Tag::Segment)
                   segment->read(e);
-            else if (tag == "MeasureNumber") {
+            else if (tag == Tag::MeasureNumber) {
                   Text* noText = new Text(score());
                   noText->read(e);
                   noText->setFlag(ElementFlag::ON_STAFF, true);
@@ -2234,7 +2239,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   noText->setParent(this);
                   staves[noText->staffIdx()]->setNoText(noText);
                   }
-            else if (tag == "Ambitus") {
+            else if (tag == Tag::Ambitus) {
                   Ambitus* range = new Ambitus(score());
                   range->read(e);
                   segment = getSegment(SegmentType::Ambitus, e.tick());
@@ -2242,7 +2247,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   range->setTrack(trackZeroVoice(e.track()));
                   segment->add(range);
                   }
-            else if (tag == "multiMeasureRest")
+            else if (tag == Tag::multiMeasureRest)
                   _mmRestCount = e.readInt();
             else if (Element::readProperties(e))
                   ;
@@ -38,6 +38,7 @@ class Note;
 class Spacer;
 class TieMap;
 class AccidentalState;
+class EventMap;
 class Spanner;
 class Part;
 class RepeatMeasure;
@@ -58,6 +59,8 @@ struct MStaff {
                               ///< this changes some layout rules
       bool _visible;
       bool _slashStyle;
+      EventMap* _events;      ///< cached midi events, ticks relative to measure start
+      bool _eventsTied;       ///< _events depend on the next measure (tied notes)
 
       MStaff();
       ~MStaff();
@@ -74,6 +74,8 @@ qreal   MScore::nudgeStep;
 qreal   MScore::nudgeStep10;
 qreal   MScore::nudgeStep50;
 int     MScore::defaultPlayDuration;
+int     MScore::undoLimit;
+qint64  MScore::undoMemoryLimit;
 // QString MScore::partStyle;
 QString MScore::lastError;
 bool    MScore::layoutDebug = false;
@@ -151,6 +153,8 @@ void MScore::init()
       defaultColor        = Qt::black;
       dropColor           = Qt::red;
       defaultPlayDuration = 300;      // ms
+      undoLimit           = 0;
+      undoMemoryLimit     = 256 * 1024 * 1024;
       warnPitchRange      = true;
       playRepeats         = true;
       panPlayback         = true;
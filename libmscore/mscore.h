@@ -375,6 +375,8 @@ class MScore : public QObject {
       static qreal nudgeStep10;
       static qreal nudgeStep50;
       static int defaultPlayDuration;
+      static int undoLimit;               // max. number of undo steps, 0: no limit
+      static qint64 undoMemoryLimit;      // max. bytes held by undo steps, 0: no limit
       static QString lastError;
       static bool layoutDebug;
 
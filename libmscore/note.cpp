@@ -804,88 +804,88 @@ void Note::read(XmlReader& e)
             _tpc[0] = e.intAttribute("tpc");
 
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-            if (tag == "pitch")
+            const Tag tag = e.tag();
+            if (tag == Tag::pitch)
                   _pitch = e.readInt();
-            else if (tag == "tpc") {
+            else if (tag == Tag::tpc) {
                   _tpc[0] = e.readInt();
                   _tpc[1] = _tpc[0];
                   }
-            else if (tag == "tpc2")
+            else if (tag == Tag::tpc2)
                   _tpc[1] = e.readInt();
-            else if (tag == "small")
+            else if (tag == Tag::small)
                   setSmall(e.readInt());
-            else if (tag == "mirror")
+            else if (tag == Tag::mirror)
                   setProperty(P_ID::MIRROR_HEAD, Ms::getProperty(P_ID::MIRROR_HEAD, e));
-            else if (tag == "dotPosition")
+            else if (tag == Tag::dotPosition)
                   setProperty(P_ID::DOT_POSITION, Ms::getProperty(P_ID::DOT_POSITION, e));
-            else if (tag == "onTimeType") { //obsolete
+            else if (tag == Tag::onTimeType) { //obsolete
                   if (e.readElementText() == "offset")
                         _onTimeType = 2;
                   else
                         _onTimeType = 1;
                   }
-            else if (tag == "offTimeType") { //obsolete
+            else if (tag == Tag::offTimeType) { //obsolete
                   if (e.readElementText() == "offset")
                         _offTimeType = 2;
                   else
                         _offTimeType = 1;
             }
-            else if (tag == "onTimeOffset") {// obsolete
+            else if (tag == Tag::onTimeOffset) {// obsolete
                   if (_onTimeType == 1)
                         setOnTimeOffset(e.readInt() * 1000 / chord()->actualTicks());
                   else
                         setOnTimeOffset(e.readInt() * 10);
                   }
-            else if (tag == "offTimeOffset") {// obsolete
+            else if (tag == Tag::offTimeOffset) {// obsolete
                   if (_offTimeType == 1)
                         setOffTimeOffset(e.readInt() * 1000 / chord()->actualTicks());
                   else
                         setOffTimeOffset(e.readInt() * 10);
                   }
-            else if (tag == "head")
+            else if (tag == Tag::head)
                   setProperty(P_ID::HEAD_GROUP, Ms::getProperty(P_ID::HEAD_GROUP, e));
-            else if (tag == "velocity")
+            else if (tag == Tag::velocity)
                   setVeloOffset(e.readInt());
-            else if (tag == "play")
+            else if (tag == Tag::play)
                   setPlay(e.readInt());
-            else if (tag == "tuning")
+            else if (tag == Tag::tuning)
                   setTuning(e.readDouble());
-            else if (tag == "fret")
+            else if (tag == Tag::fret)
                   setFret(e.readInt());
-            else if (tag == "string")
+            else if (tag == Tag::string)
                   setString(e.readInt());
-            else if (tag == "ghost")
+            else if (tag == Tag::ghost)
                   setGhost(e.readInt());
-            else if (tag == "headType")
+            else if (tag == Tag::headType)
                   if (score()->mscVersion() <= 114)
                         setProperty(P_ID::HEAD_TYPE, Ms::getProperty(P_ID::HEAD_TYPE, e).toInt() - 1);
                   else
                         setProperty(P_ID::HEAD_TYPE, Ms::getProperty(P_ID::HEAD_TYPE, e).toInt());
-            else if (tag == "veloType")
+            else if (tag == Tag::veloType)
                   setProperty(P_ID::VELO_TYPE, Ms::getProperty(P_ID::VELO_TYPE, e));
-            else if (tag == "line")
+            else if (tag == Tag::line)
                   _line = e.readInt();
-            else if (tag == "Tie") {
+            else if (tag == Tag::Tie) {
                   _tieFor = new Tie(score());
                   _tieFor->setTrack(track());
                   _tieFor->read(e);
                   _tieFor->setStartNote(this);
                   score()->addSpanner(_tieFor);
                   }
-            else if (tag == "Fingering" || tag == "Text") {       // Text is obsolete
+            else if (tag == Tag::Fingering || tag == Tag::Text) {       // Text is obsolete
                   Fingering* f = new Fingering(score());
                   f->setTextStyleType(TextStyleType::FINGERING);
                   f->read(e);
                   add(f);
                   }
-            else if (tag == "Symbol") {
+            else if (tag == Tag::Symbol) {
                   Symbol* s = new Symbol(score());
                   s->setTrack(track());
                   s->read(e);
                   add(s);
                   }
-            else if (tag == "Image") {
+            else if (tag == Tag::Image) {
                   if (MScore::noImages)
                         e.skipCurrentElement();
                   else {
@@ -895,7 +895,7 @@ void Note::read(XmlReader& e)
                         add(image);
                         }
                   }
-            else if (tag == "userAccidental") {
+            else if (tag == Tag::userAccidental) {
                   QString val(e.readElementText());
                   bool ok;
                   int k = val.toInt(&ok);
@@ -950,7 +950,7 @@ void Note::read(XmlReader& e)
                         hasAccidental = true;   // we now have an accidental
                         }
                   }
-            else if (tag == "Accidental") {
+            else if (tag == Tag::Accidental) {
                   // on older scores, a note could have both a <userAccidental> tag and an <Accidental> tag
                   // if a userAccidental has some other property set (like for instance offset)
                   Accidental* a;
@@ -967,15 +967,15 @@ void Note::read(XmlReader& e)
                   if (score()->mscVersion() < 117)
                         hasAccidental = true;   // we now have an accidental
                   }
-            else if (tag == "move")             // obsolete
+            else if (tag == Tag::move)             // obsolete
                   chord()->setStaffMove(e.readInt());
-            else if (tag == "Bend") {
+            else if (tag == Tag::Bend) {
                   Bend* b = new Bend(score());
                   b->setTrack(track());
                   b->read(e);
                   add(b);
                   }
-            else if (tag == "NoteDot") {
+            else if (tag == Tag::NoteDot) {
                   NoteDot* dot = new NoteDot(score());
                   dot->read(e);
                   for (int i = 0; i < 3; ++i) {
@@ -991,11 +991,11 @@ void Note::read(XmlReader& e)
                         delete dot;
                         }
                   }
-            else if (tag == "Events") {
+            else if (tag == Tag::Events) {
                   _playEvents.clear();    // remove default event
                   while (e.readNextStartElement()) {
-                        const QStringRef& tag(e.name());
-                        if (tag == "Event") {
+                        const Tag tag = e.tag();
+                        if (tag == Tag::Event) {
                               NoteEvent ne;
                               ne.read(e);
                               _playEvents.append(ne);
@@ -1006,7 +1006,7 @@ void Note::read(XmlReader& e)
                   if (chord())
                         chord()->setPlayEventType(PlayEventType::User);
                   }
-            else if (tag == "endSpanner") {
+            else if (tag == Tag::endSpanner) {
                   int id = e.intAttribute("id");
                   Spanner* sp = score()->findSpanner(id);
                   if (sp) {
@@ -1021,8 +1021,8 @@ void Note::read(XmlReader& e)
                         qDebug("Note::read(): cannot find spanner %d", id);
                   e.readNext();
                   }
-            else if (tag == "TextLine") {
-                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(tag, score()));
+            else if (tag == Tag::TextLine) {
+                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(e.name(), score()));
                   sp->setTrack(track());
                   sp->read(e);
                   sp->setAnchor(Spanner::Anchor::NOTE);
@@ -1032,13 +1032,13 @@ void Note::read(XmlReader& e)
                   sp->setParent(this);
                   score()->addSpanner(sp);
                   }
-            else if (tag == "onTimeType")                   // obsolete
+            else if (tag == Tag::onTimeType)                   // obsolete
                   e.skipCurrentElement(); // _onTimeType = readValueType(e);
-            else if (tag == "offTimeType")                  // obsolete
+            else if (tag == Tag::offTimeType)                  // obsolete
                   e.skipCurrentElement(); // _offTimeType = readValueType(e);
-            else if (tag == "tick")                         // bad input file
+            else if (tag == Tag::tick)                         // bad input file
                   e.skipCurrentElement();
-            else if (tag == "offset") {
+            else if (tag == Tag::offset) {
                   if (score()->mscVersion() > 114) // || voice() >= 2)
                         Element::readProperties(e);
                   else
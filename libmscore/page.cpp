@@ -146,6 +146,8 @@ QList<Element*> Page::items(const QRectF& r)
 #ifdef USE_BSP
       if (!bspTreeValid)
             doRebuildBspTree();
+      else if (!bspDirty.isEmpty())
+            updateBspTree();
       QList<Element*> el = bspTree.items(r);
       return el;
 #else
@@ -158,6 +160,8 @@ QList<Element*> Page::items(const QPointF& p)
 #ifdef USE_BSP
       if (!bspTreeValid)
             doRebuildBspTree();
+      else if (!bspDirty.isEmpty())
+            updateBspTree();
       return bspTree.items(p);
 #else
       return QList<Element*>();
@@ -462,32 +466,105 @@ void PageFormat::write(Xml& xml) const
       }
 
 //---------------------------------------------------------
-//   doRebuildBspTree
+//   rebuildBspTree
+//    only the elements of system s changed, moved to
+//    or left this page
 //---------------------------------------------------------
 
+void Page::rebuildBspTree(System* s)
+      {
+#ifdef USE_BSP
+      if (bspTreeValid)
+            bspDirty.insert(s);
+#else
+      Q_UNUSED(s);
+#endif
+      }
+
 #ifdef USE_BSP
+//---------------------------------------------------------
+//   collectSystem
+//---------------------------------------------------------
+
+static void collectSystem(System* s, QList<Element*>* el)
+      {
+      for (MeasureBase* m : s->measures())
+            m->scanElements(el, collectElements, false);
+      s->scanElements(el, collectElements, false);
+      }
+
+//---------------------------------------------------------
+//   bspRect
+//---------------------------------------------------------
+
+static QRectF bspRect(Page* page)
+      {
+      if (page->score()->layoutMode() == LayoutMode::LINE) {
+            System* s = page->systems()->front();
+            MeasureBase* mb = s->measures().back();
+            return QRectF(0.0, 0.0, mb->x() + mb->width(), s->height());
+            }
+      return page->abbox();
+      }
+
+//---------------------------------------------------------
+//   doRebuildBspTree
+//    file all elements; the tree is only reinitialized if
+//    the page size or the number of elements changed a
+//    lot, otherwise moved, new and removed elements are
+//    updated in place
+//---------------------------------------------------------
+
 void Page::doRebuildBspTree()
       {
+      bspElements.clear();
+      bspDirty.clear();
       QList<Element*> el;
       for (System* s : _systems) {
-            for (MeasureBase* m : s->measures())
-                  m->scanElements(&el, collectElements, false);
+            QList<Element*>& sl = bspElements[s];
+            collectSystem(s, &sl);
+            el.append(sl);
             }
-      scanElements(&el, collectElements, false);
+      el.append(this);
 
       int n = el.size();
-      if (score()->layoutMode() == LayoutMode::LINE) {
-            qreal h = _systems.front()->height();
-            MeasureBase* mb = _systems.front()->measures().back();
-            qreal w = mb->x() + mb->width();
-            bspTree.initialize(QRectF(0.0, 0.0, w, h), n);
+      QRectF r = bspRect(this);
+      if (bspTree.fits(r, n))
+            bspTree.sync(el);
+      else {
+            bspTree.initialize(r, n);
+            for (int i = 0; i < n; ++i)
+                  bspTree.insert(el.at(i));
             }
-      else
-            bspTree.initialize(abbox(), n);
-      for (int i = 0; i < n; ++i)
-            bspTree.insert(el.at(i));
       bspTreeValid = true;
       }
+
+//---------------------------------------------------------
+//   updateBspTree
+//    remove the elements filed for the dirty systems and
+//    insert the current elements of those still on this
+//    page; all old elements are removed first, elements
+//    can move between dirty systems
+//---------------------------------------------------------
+
+void Page::updateBspTree()
+      {
+      for (System* s : bspDirty) {
+            for (Element* e : bspElements.take(s))
+                  bspTree.remove(e);
+            }
+      for (System* s : bspDirty) {
+            if (!_systems.contains(s))
+                  continue;
+            QList<Element*>& sl = bspElements[s];
+            collectSystem(s, &sl);
+            for (Element* e : sl)
+                  bspTree.insert(e);
+            }
+      bspDirty.clear();
+      if (!bspTree.fits(bspRect(this), bspTree.count()))
+            doRebuildBspTree();
+      }
 #endif
 
 //---------------------------------------------------------
@@ -789,6 +866,56 @@ QList<const Element*> Page::elements()
       return el;
       }
 
+//---------------------------------------------------------
+//   render
+//    rasterize the elements of this page at dpi;
+//    the layout is only read, so several pages can be
+//    rendered at the same time
+//---------------------------------------------------------
+
+QImage Page::render(const QList<const Element*>& el, double dpi, bool transparent, QImage::Format format) const
+      {
+      QRectF r = abbox();
+      int w = lrint(r.width()  * dpi / MScore::DPI);
+      int h = lrint(r.height() * dpi / MScore::DPI);
+
+      QImage image(w, h, format != QImage::Format_Indexed8 ? format : QImage::Format_ARGB32_Premultiplied);
+      image.setDotsPerMeterX(lrint((dpi * 1000) / INCH));
+      image.setDotsPerMeterY(lrint((dpi * 1000) / INCH));
+      image.fill(transparent ? 0 : 0xffffffff);
+
+      double mag = dpi / MScore::DPI;
+      QPainter p(&image);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(mag, mag);
+      foreach(const Element* e, el) {
+            if (!e->visible())
+                  continue;
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      p.end();
+
+      if (format == QImage::Format_Indexed8) {
+            //convert to grayscale & respect alpha
+            QVector<QRgb> colorTable;
+            colorTable.push_back(QColor(0, 0, 0, 0).rgba());
+            if (!transparent) {
+                  for (int i = 1; i < 256; i++)
+                        colorTable.push_back(QColor(i, i, i).rgb());
+                  }
+            else {
+                  for (int i = 1; i < 256; i++)
+                        colorTable.push_back(QColor(0, 0, 0, i).rgba());
+                  }
+            image = image.convertToFormat(QImage::Format_Indexed8, colorTable);
+            }
+      return image;
+      }
+
 //---------------------------------------------------------
 //   tm
 //---------------------------------------------------------
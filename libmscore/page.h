@@ -126,7 +126,10 @@ class Page : public Element {
       int _no;                      // page number
 #ifdef USE_BSP
       BspTree bspTree;
+      QHash<System*, QList<Element*> > bspElements;   // filed elements by system
+      QSet<System*> bspDirty;                         // systems to refile
       void doRebuildBspTree();
+      void updateBspTree();
 #endif
       bool bspTreeValid;
 
@@ -161,12 +164,14 @@ class Page : public Element {
       QList<Element*> items(const QRectF& r);
       QList<Element*> items(const QPointF& p);
       void rebuildBspTree()   { bspTreeValid = false; }
+      void rebuildBspTree(System*);
       QPointF pagePos() const { return QPointF(); }     ///< position in page coordinates
       QList<System*> searchSystem(const QPointF& pos) const;
       Measure* searchMeasure(const QPointF& p) const;
       MeasureBase* pos2measure(const QPointF&, int* staffIdx, int* pitch,
          Segment**, QPointF* offset) const;
       QList<const Element*> elements();         ///< list of visible elements
+      QImage render(const QList<const Element*>&, double dpi, bool transparent, QImage::Format) const;
       };
 
 extern const PaperSize paperSizes[];
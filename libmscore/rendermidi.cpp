@@ -247,10 +247,13 @@ static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMa
 
 //---------------------------------------------------------
 //   collectMeasureEvents
+//    return true if a note of the measure is tied into
+//    the next measure
 //---------------------------------------------------------
 
-static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int tickOffset)
+static bool collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int tickOffset)
       {
+      bool tied = false;
       int firstStaffIdx = staff->idx();
       int nextStaffIdx  = firstStaffIdx + 1;
 
@@ -284,8 +287,11 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                         for (const Note* note : c->notes())
                               collectNote(events, channel, note, velocity, tickOffset);
                         }
-                  foreach (const Note* note, chord->notes())
+                  foreach (const Note* note, chord->notes()) {
                         collectNote(events, channel, note, velocity, tickOffset);
+                        if (note->tieFor())
+                              tied = true;
+                        }
                   }
             }
 
@@ -302,7 +308,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   const StaffText* st = static_cast<const StaffText*>(e);
                   int tick = s->tick() + tickOffset;
 
-                  Instrument* instr = e->staff()->part()->instr(tick);
+                  Instrument* instr = e->staff()->part()->instr(s->tick());
                   foreach (const ChannelActions& ca, *st->channelActions()) {
                         int channel = ca.channel;
                         foreach(const QString& ma, ca.midiActionNames) {
@@ -319,7 +325,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   if (st->setAeolusStops()) {
                         Staff* staff = st->staff();
                         int voice   = 0;
-                        int channel = staff->channel(tick, voice);
+                        int channel = staff->channel(s->tick(), voice);
 
                         for (int i = 0; i < 4; ++i) {
                               static int num[4] = { 12, 13, 16, 16 };
@@ -329,6 +335,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                         }
                   }
             }
+      return tied;
       }
 
 //---------------------------------------------------------
@@ -342,8 +349,10 @@ void Score::updateRepeatList(bool expandRepeats)
                   delete s;
             repeatList()->clear();
             Measure* m = lastMeasure();
-            if (m == 0)
+            if (m == 0) {
+                  repeatList()->invalidate();
                   return;
+                  }
             RepeatSegment* s = new RepeatSegment;
             s->tick  = 0;
             s->len   = m->tick() + m->ticks();
@@ -351,6 +360,7 @@ void Score::updateRepeatList(bool expandRepeats)
             s->utime = 0.0;
             s->timeOffset = 0.0;
             repeatList()->append(s);
+            repeatList()->invalidate();
             }
       else
             repeatList()->unwind();
@@ -496,26 +506,205 @@ void Score::updateVelo()
             }
       }
 
+//---------------------------------------------------------
+//   firstDifference
+//    return the first tick at which the lists differ
+//    or -1 if they are equal
+//---------------------------------------------------------
+
+template <class T, class Equal>
+static int firstDifference(const QMap<int, T>& a, const QMap<int, T>& b, Equal equal)
+      {
+      auto i = a.begin();
+      auto k = b.begin();
+      for (; i != a.end() && k != b.end(); ++i, ++k) {
+            if (i.key() != k.key())
+                  return qMin(i.key(), k.key());
+            if (!equal(i.value(), k.value()))
+                  return i.key();
+            }
+      if (i != a.end())
+            return i.key();
+      if (k != b.end())
+            return k.key();
+      return -1;
+      }
+
+static int firstDifference(const QMap<int, int>& a, const QMap<int, int>& b)
+      {
+      return firstDifference(a, b, [](int v1, int v2) { return v1 == v2; });
+      }
+
+//---------------------------------------------------------
+//   RenderInstrument
+//---------------------------------------------------------
+
+RenderInstrument::RenderInstrument(const Instrument& instr)
+   : articulation(instr.articulation())
+      {
+      for (const Channel& c : instr.channel())
+            channels.append(RenderChannel { c.channel, c.program, c.bank, c.articulation });
+      }
+
+//---------------------------------------------------------
+//   renderInstruments
+//    only const access, the instrument data of the part
+//    must not be detached
+//---------------------------------------------------------
+
+static QMap<int, RenderInstrument> renderInstruments(const InstrumentList* il)
+      {
+      QMap<int, RenderInstrument> map;
+      for (const auto& i : *il)
+            map.insert(i.first, RenderInstrument(i.second));
+      return map;
+      }
+
+//---------------------------------------------------------
+//   minTick
+//    earliest of two ticks, -1 meaning none
+//---------------------------------------------------------
+
+static int minTick(int t1, int t2)
+      {
+      if (t1 == -1)
+            return t2;
+      if (t2 == -1)
+            return t1;
+      return qMin(t1, t2);
+      }
+
+//---------------------------------------------------------
+//   updateRenderState
+//    compare velocities, pitch offsets, channels and
+//    instruments of staff with the state the cached
+//    events were rendered with and drop the events from
+//    the first difference on
+//---------------------------------------------------------
+
+void Score::updateRenderState(Staff* staff)
+      {
+      RenderState& rs = staff->renderState();
+      int tick = firstDifference(rs.velocities, staff->velocities(),
+         [](const VeloEvent& v1, const VeloEvent& v2) { return v1.type == v2.type && v1.val == v2.val; });
+      if (tick > 0) {
+            // a velocity ramp reaches back to the previous event
+            auto i = staff->velocities().lowerBound(tick);
+            if (i != staff->velocities().begin())
+                  tick = (--i).key();
+            auto k = rs.velocities.lowerBound(tick);
+            if (k != rs.velocities.begin())
+                  tick = qMin(tick, (--k).key());
+            }
+      tick = minTick(tick, firstDifference(rs.pitchOffsets, staff->pitchOffsets()));
+      for (int voice = 0; voice < VOICES; ++voice)
+            tick = minTick(tick, firstDifference(rs.channels[voice], *staff->channelList(voice)));
+      QMap<int, RenderInstrument> instruments = renderInstruments(staff->part()->instrList());
+      tick = minTick(tick, firstDifference(rs.instruments, instruments,
+         [](const RenderInstrument& i1, const RenderInstrument& i2) { return i1 == i2; }));
+      if (tick == -1)
+            return;
+
+      int staffIdx = staff->idx();
+      for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
+            if (m->tick() + m->ticks() <= tick)
+                  continue;
+            MStaff* ms = m->mstaff(staffIdx);
+            delete ms->_events;
+            ms->_events = 0;
+            }
+      rs.velocities   = staff->velocities();
+      rs.pitchOffsets = staff->pitchOffsets();
+      for (int voice = 0; voice < VOICES; ++voice)
+            rs.channels[voice] = *staff->channelList(voice);
+      rs.instruments  = instruments;
+      }
+
+//---------------------------------------------------------
+//   measureEvents
+//    return the events of staff in measure m with ticks
+//    relative to the start of the measure; they are
+//    collected on first use and cached in the MStaff
+//---------------------------------------------------------
+
+const EventMap* Score::measureEvents(Measure* m, Staff* staff)
+      {
+      MStaff* ms = m->mstaff(staff->idx());
+      if (!ms->_events) {
+            if (staff->primaryStaff()) {
+                  int strack = staff->idx() * VOICES;
+                  for (int track = strack; track < strack + VOICES; ++track) {
+                        for (Segment* seg = m->first(SegmentType::ChordRest); seg; seg = seg->next(SegmentType::ChordRest)) {
+                              Element* e = seg->element(track);
+                              if (e && e->type() == ElementType::CHORD)
+                                    createPlayEvents(static_cast<Chord*>(e));
+                              }
+                        }
+                  }
+            ms->_events     = new EventMap;
+            ms->_eventsTied = collectMeasureEvents(ms->_events, m, staff, -m->tick());
+            }
+      return ms->_events;
+      }
+
+//---------------------------------------------------------
+//   invalidateMidiCache
+//    drop the cached events of all measures touching
+//    [stick, etick] and of the measures tied into them
+//---------------------------------------------------------
+
+void Score::invalidateMidiCache(int stick, int etick)
+      {
+      Measure* fm = tick2measure(stick);
+      if (!fm)
+            return;
+      for (Measure* m = fm; m && m->tick() <= etick; m = m->nextMeasure()) {
+            for (MStaff* ms : *m->staffList()) {
+                  delete ms->_events;
+                  ms->_events = 0;
+                  }
+            }
+      for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+            for (Measure* m = fm->prevMeasure(); m; m = m->prevMeasure()) {
+                  MStaff* ms = m->mstaff(staffIdx);
+                  if (!ms->_events || !ms->_eventsTied)
+                        break;
+                  delete ms->_events;
+                  ms->_events = 0;
+                  }
+            }
+      }
+
+void Score::invalidateMidiCache()
+      {
+      for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
+            for (MStaff* ms : *m->staffList()) {
+                  delete ms->_events;
+                  ms->_events = 0;
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   renderStaff
+//    merge the cached measure events along the unwound
+//    repeat list
 //---------------------------------------------------------
 
 void Score::renderStaff(EventMap* events, Staff* staff)
       {
+      updateRenderState(staff);
+
       Measure* lastMeasure = 0;
       foreach (const RepeatSegment* rs, *repeatList()) {
             int startTick  = rs->tick;
             int endTick    = startTick + rs->len;
             int tickOffset = rs->utick - rs->tick;
             for (Measure* m = tick2measure(startTick); m; m = m->nextMeasure()) {
-                  if (lastMeasure && m->isRepeatMeasure(staff->part())) {
-                        int offset = m->tick() - lastMeasure->tick();
-                        collectMeasureEvents(events, lastMeasure, staff, tickOffset + offset);
-                        }
-                  else {
+                  int offset = m->tick() + tickOffset;
+                  if (!lastMeasure || !m->isRepeatMeasure(staff->part()))
                         lastMeasure = m;
-                        collectMeasureEvents(events, lastMeasure, staff, tickOffset);
-                        }
+                  events->append(*measureEvents(lastMeasure, staff), offset);
                   if (m->tick() + m->ticks() >= endTick)
                         break;
                   }
@@ -791,8 +980,6 @@ void Score::createPlayEvents()
 
 void Score::renderMidi(EventMap* events)
       {
-      createPlayEvents();
-
       updateRepeatList(MScore::playRepeats);
       _foundPlayPosAfterRepeats = false;
       updateChannel();
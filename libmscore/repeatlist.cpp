@@ -118,9 +118,8 @@ RepeatSegment::RepeatSegment()
 
 RepeatList::RepeatList(Score* s)
       {
-      _score = s;
-      idx1  = 0;
-      idx2  = 0;
+      _score   = s;
+      _tempoSN = 0;
       }
 
 //---------------------------------------------------------
@@ -155,6 +154,64 @@ void RepeatList::update()
             utick        += s->len;
             t            += tl->tick2time(s->tick + s->len) - ct;
             }
+      invalidate();
+      }
+
+//---------------------------------------------------------
+//   invalidate
+//    the segments changed, rebuild the time table
+//---------------------------------------------------------
+
+void RepeatList::invalidate()
+      {
+      _lock.lockForWrite();
+      _tempoSN = 0;
+      _lock.unlock();
+      }
+
+//---------------------------------------------------------
+//   lockTable
+//    lock the time table for reading, rebuild it first
+//    if it is out of date
+//---------------------------------------------------------
+
+void RepeatList::lockTable() const
+      {
+      const TempoMap* tl = _score->tempomap();
+      _lock.lockForRead();
+      if (_tempoSN == tl->tempoSN())
+            return;
+      _lock.unlock();
+      _lock.lockForWrite();
+      if (_tempoSN != tl->tempoSN()) {
+            _table.clear();
+            _relTempo = tl->relTempo();
+            for (const RepeatSegment* s : *this) {
+                  // tempo map event in effect at the segment start
+                  TimeEntry te { s->utick, 0.0, 0, 0.0, 2.0, s->utick - s->tick, s->timeOffset };
+                  auto e = tl->upper_bound(s->tick);
+                  if (e != tl->begin()) {
+                        --e;
+                        te.tick  = e->first;
+                        te.time  = e->second.time;
+                        te.tempo = e->second.tempo;
+                        }
+                  te.utime = te.time + (s->tick - te.tick) / (MScore::division * te.tempo * _relTempo) + te.timeOffset;
+                  _table.append(te);
+                  // tempo changes inside the segment
+                  for (e = tl->upper_bound(s->tick); e != tl->end() && e->first < s->tick + s->len; ++e) {
+                        te.utick = e->first + te.tickOffset;
+                        te.tick  = e->first;
+                        te.time  = e->second.time;
+                        te.tempo = e->second.tempo;
+                        te.utime = te.time + te.timeOffset;
+                        _table.append(te);
+                        }
+                  }
+            _tempoSN = tl->tempoSN();
+            }
+      _lock.unlock();
+      _lock.lockForRead();
       }
 
 //---------------------------------------------------------
@@ -168,17 +225,16 @@ int RepeatList::utick2tick(int tick) const
             return tick;
       if (tick < 0)
             return 0;
-      unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-      for (unsigned i = ii; i < n; ++i) {
-            if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i+1)->utick))) {
-                  idx1 = i;
-                  return tick - (at(i)->utick - at(i)->tick);
-                  }
-            }
-      if (MScore::debugMode) {
-            qFatal("utick %d not found in RepeatList\n", tick);
+      // last segment starting at or before tick
+      auto i = std::upper_bound(begin(), end(), tick,
+         [](int t, const RepeatSegment* s) { return t < s->utick; });
+      if (i == begin()) {
+            if (MScore::debugMode)
+                  qFatal("utick %d not found in RepeatList\n", tick);
+            return 0;
             }
-      return 0;
+      --i;
+      return tick - ((*i)->utick - (*i)->tick);
       }
 
 //---------------------------------------------------------
@@ -200,16 +256,17 @@ int RepeatList::tick2utick(int tick) const
 
 qreal RepeatList::utick2utime(int tick) const
       {
-      unsigned n = size();
-      unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-      for (unsigned i = ii; i < n; ++i) {
-            if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i+1)->utick))) {
-                  int t     = tick - (at(i)->utick - at(i)->tick);
-                  qreal tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
-                  return tt;
-                  }
+      lockTable();
+      qreal tt = 0.0;
+      auto i = std::upper_bound(_table.begin(), _table.end(), tick,
+         [](int t, const TimeEntry& e) { return t < e.utick; });
+      if (i != _table.begin()) {
+            --i;
+            int t = tick - i->tickOffset;
+            tt = i->time + qreal(t - i->tick) / (MScore::division * i->tempo * _relTempo) + i->timeOffset;
             }
-      return 0.0;
+      _lock.unlock();
+      return tt;
       }
 
 //---------------------------------------------------------
@@ -218,18 +275,20 @@ qreal RepeatList::utick2utime(int tick) const
 
 int RepeatList::utime2utick(qreal t) const
       {
-      unsigned n = size();
-      unsigned ii = (idx2 < n) && (t >= at(idx2)->utime) ? idx2 : 0;
-      for (unsigned i = ii; i < n; ++i) {
-            if ((t >= at(i)->utime) && ((i + 1 == n) || (t < at(i+1)->utime))) {
-                  idx2 = i;
-                  return _score->tempomap()->time2tick(t - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
-                  }
-            }
-      if (MScore::debugMode) {
-            qFatal("time %f not found in RepeatList\n", t);
+      lockTable();
+      auto i = std::upper_bound(_table.begin(), _table.end(), t,
+         [](qreal v, const TimeEntry& e) { return v < e.utime; });
+      if (i == _table.begin()) {
+            _lock.unlock();
+            if (MScore::debugMode && !isEmpty())
+                  qFatal("time %f not found in RepeatList\n", t);
+            return 0;
             }
-      return 0;
+      --i;
+      qreal delta = t - i->timeOffset - i->time;
+      int tick    = i->tick + lrint(delta * _relTempo * MScore::division * i->tempo) + i->tickOffset;
+      _lock.unlock();
+      return tick;
       }
 
 //---------------------------------------------------------
@@ -266,6 +325,7 @@ void RepeatList::unwind()
       {
       qDeleteAll(*this);
       clear();
+      invalidate();
       Measure* fm = _score->firstMeasure();
       if (!fm)
             return;
@@ -33,6 +33,21 @@ class RepeatSegment {
       RepeatSegment();
       };
 
+//---------------------------------------------------------
+//   TimeEntry
+//    piece of the unwound score with constant tempo
+//---------------------------------------------------------
+
+struct TimeEntry {
+      int utick;              // start of the piece
+      qreal utime;
+      int tick;               // tempo map event in effect
+      qreal time;
+      qreal tempo;
+      int tickOffset;         // utick - tick of the repeat segment
+      qreal timeOffset;       // of the repeat segment
+      };
+
 //---------------------------------------------------------
 //   RepeatList
 //---------------------------------------------------------
@@ -40,11 +55,18 @@ class RepeatSegment {
 class RepeatList: public QList<RepeatSegment*>
       {
       Score* _score;
-      mutable unsigned idx1, idx2;   // cached values
+
+      // utick <-> utime table, rebuilt on first use after
+      // the tempo map or the repeat list changed
+      mutable QVector<TimeEntry> _table;
+      mutable int _tempoSN;
+      mutable qreal _relTempo;
+      mutable QReadWriteLock _lock;
 
       RepeatSegment* rs;            // tmp value during unwind()
 
       Measure* jumpToStartRepeat(Measure*);
+      void lockTable() const;
 
    public:
       RepeatList(Score* s);
@@ -55,6 +77,7 @@ class RepeatList: public QList<RepeatSegment*>
       int utime2utick(qreal) const;
       qreal utick2utime(int) const;
       void update();
+      void invalidate();
       int ticks();
       };
 
@@ -406,7 +406,12 @@ class Score : public QObject {
       bool doReLayout();
 
       void layoutStage2();
+      void layoutStage2(Measure* sm, Measure* em);
       void layoutStage3();
+      void layoutStage3(Measure* sm, Measure* em);
+      void layoutStage4(Segment* fs, int etick);
+      bool layoutSystems(bool firstSystem, bool startWithLongNames, int etick, const QList<MeasureBase*>& oldStart);
+      void renumberMeasures();
       void beamGraceNotes(Chord*, bool);
 
       void hideEmptyStaves(System* system, bool isFirstSystem);
@@ -424,6 +429,8 @@ class Score : public QObject {
       void removeGeneratedElements(Measure* mb, Measure* end);
       qreal cautionaryWidth(Measure* m);
       void createPlayEvents();
+      const EventMap* measureEvents(Measure*, Staff*);
+      void updateRenderState(Staff*);
 
       void selectSingle(Element* e, int staffIdx);
       void selectAdd(Element* e);
@@ -710,6 +717,8 @@ class Score : public QObject {
       void pasteSymbols(XmlReader& e, ChordRest* dst);
       void renderMidi(EventMap* events);
       void renderStaff(EventMap* events, Staff*);
+      void invalidateMidiCache(int stick, int etick);
+      void invalidateMidiCache();
       int mscVersion() const    { return _mscVersion; }
       void setMscVersion(int v) { _mscVersion = v; }
 
@@ -832,6 +841,7 @@ class Score : public QObject {
       void enqueueMidiEvent(MidiInputEvent ev) { midiInputQueue.enqueue(ev); }
 
       Q_INVOKABLE void doLayout();
+      void doLayoutRange(int stick, int etick);
       void layoutSystems();
       void layoutSystems2();
       void layoutLinear();
@@ -26,6 +26,7 @@
 #include "keylist.h"
 #include "stafftype.h"
 #include "groups.h"
+#include "instrument.h"
 
 namespace Ms {
 
@@ -78,6 +79,47 @@ struct BracketItem {
             }
       };
 
+//---------------------------------------------------------
+//   RenderInstrument
+///   Values of an instrument the rendered midi events
+///   depend on. A deep copy, so that the instrument
+///   data of the part is not shared.
+//---------------------------------------------------------
+
+struct RenderInstrument {
+      struct RenderChannel {
+            int channel;
+            int program;
+            int bank;
+            QList<MidiArticulation> articulation;
+            bool operator==(const RenderChannel& c) const {
+                  return channel == c.channel && program == c.program && bank == c.bank
+                     && articulation == c.articulation;
+                  }
+            };
+      QList<MidiArticulation> articulation;
+      QList<RenderChannel> channels;
+
+      RenderInstrument() {}
+      RenderInstrument(const Instrument&);
+      bool operator==(const RenderInstrument& i) const {
+            return articulation == i.articulation && channels == i.channels;
+            }
+      };
+
+//---------------------------------------------------------
+//   RenderState
+///   Staff wide data the cached midi events of the
+///   measures were rendered with.
+//---------------------------------------------------------
+
+struct RenderState {
+      VeloList velocities;
+      PitchList pitchOffsets;
+      QMap<int,int> channels[VOICES];
+      QMap<int, RenderInstrument> instruments;
+      };
+
 //---------------------------------------------------------
 //    Staff
 ///    Global staff data not directly related to drawing.
@@ -112,6 +154,7 @@ class Staff : public QObject {
 
       VeloList _velocities;         ///< cached value
       PitchList _pitchOffsets;      ///< cached value
+      RenderState _renderState;
 
    public:
       Staff(Score* = 0);
@@ -199,6 +242,7 @@ class Staff : public QObject {
 
       VeloList& velocities()           { return _velocities;     }
       PitchList& pitchOffsets()        { return _pitchOffsets;   }
+      RenderState& renderState()       { return _renderState;    }
       int pitchOffset(int tick)        { return _pitchOffsets.pitchOffset(tick);   }
       void updateOttava(Ottava*);
 
@@ -10,6 +10,9 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
 #include "style.h"
 #include "sym.h"
 #include "utils.h"
@@ -5314,6 +5317,31 @@ void ScoreFont::load()
       // down by a factor 100. See issue #25142: "Stem slightly misaligned on upstem notes"
       // TODO : Investigate the possible use of QGlyphRun instead
 
+      _fm = new QFontMetricsF(font());
+
+      //
+      // glyph metrics are taken from a cache file if one matches
+      // the font, else they are measured and the cache is written
+      //
+      QByteArray key = metricsKey();
+      QString name   = QString("%1-%2.fm").arg(_name.toLower()).arg(QString(key.toHex()));
+      QString shared = MScore::globalShare() + "fonts/" + name;
+      QString cache  = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fontmetrics/" + name;
+      if (!loadMetrics(shared, key) && !loadMetrics(cache, key)) {
+            computeMetrics(font2);
+            saveMetrics(cache, key);
+            }
+      loaded = true;
+      }
+
+//---------------------------------------------------------
+//   computeMetrics
+//    measure all glyphs and read the anchors from the
+//    font metadata
+//---------------------------------------------------------
+
+void ScoreFont::computeMetrics(const QFont& font2)
+      {
       QFile fi(_fontPath + "glyphnames.json");
       if (!fi.open(QIODevice::ReadOnly))
             qDebug("ScoreFont: open glyph names file <%s> failed", qPrintable(fi.fileName()));
@@ -5323,7 +5351,6 @@ void ScoreFont::load()
             qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
                error.offset, qPrintable(error.errorString()));
 
-      _fm = new QFontMetricsF(font());
       QFontMetrics fm2(font2);         // See comment above
       for (auto i : o.keys()) {
             bool ok;
@@ -5519,13 +5546,146 @@ void ScoreFont::load()
             if (!sym.isValid())
                   qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
             }*/
-      loaded = true;
+      }
+
+//---------------------------------------------------------
+//   glyph metrics cache
+//    a versioned binary file with one fixed size record
+//    per symbol; the file is mapped and copied into
+//    _symbols
+//---------------------------------------------------------
+
+static const quint32 METRICS_VERSION = 1;
+static const int METRICS_MAX_CODES   = 15;
+
+struct MetricsHeader {
+      char magic[4];          // "MSFM"
+      quint32 version;
+      quint32 symbols;
+      quint32 recordSize;
+      char key[16];
+      };
+
+struct SymMetrics {
+      double width;
+      double bbox[4];
+      double attach[2];
+      double cutOut[8];       // NE, NW, SE, SW
+      quint16 length;
+      quint16 code[METRICS_MAX_CODES];
+      };
+
+//---------------------------------------------------------
+//   metricsKey
+//    md5 of everything the metrics depend on: font file,
+//    glyph names, metadata, resolution and the Qt font
+//    engine
+//---------------------------------------------------------
+
+QByteArray ScoreFont::metricsKey() const
+      {
+      QCryptographicHash h(QCryptographicHash::Md5);
+      for (const QString& fn : { _filename, QString("glyphnames.json"), QString("metadata.json") }) {
+            QFile f(_fontPath + fn);
+            if (f.open(QIODevice::ReadOnly))
+                  h.addData(f.readAll());
+            }
+      h.addData(QString("%1 %2 %3 %4").arg(METRICS_VERSION).arg(MScore::DPI).arg(PPI).arg(qVersion()).toLatin1());
+      return h.result();
+      }
+
+//---------------------------------------------------------
+//   loadMetrics
+//    return false if there is no valid cache file for key
+//---------------------------------------------------------
+
+bool ScoreFont::loadMetrics(const QString& path, const QByteArray& key)
+      {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly))
+            return false;
+      int n = _symbols.size();
+      qint64 size = sizeof(MetricsHeader) + n * sizeof(SymMetrics);
+      if (f.size() != size)
+            return false;
+      const uchar* data = f.map(0, size);
+      if (!data)
+            return false;
+      const MetricsHeader* h = reinterpret_cast<const MetricsHeader*>(data);
+      if (memcmp(h->magic, "MSFM", 4) || h->version != METRICS_VERSION || h->symbols != quint32(n)
+         || h->recordSize != sizeof(SymMetrics) || memcmp(h->key, key.constData(), sizeof(h->key))) {
+            qDebug("ScoreFont: stale glyph metrics cache <%s>", qPrintable(path));
+            return false;
+            }
+      const SymMetrics* m = reinterpret_cast<const SymMetrics*>(data + sizeof(MetricsHeader));
+      for (int i = 0; i < n; ++i, ++m) {
+            Sym* sym = &_symbols[i];
+            sym->setString(QString(reinterpret_cast<const QChar*>(m->code), m->length));
+            sym->setWidth(m->width);
+            sym->setBbox(QRectF(m->bbox[0], m->bbox[1], m->bbox[2], m->bbox[3]));
+            sym->setAttach(QPointF(m->attach[0], m->attach[1]));
+            sym->setCutOutNE(QPointF(m->cutOut[0], m->cutOut[1]));
+            sym->setCutOutNW(QPointF(m->cutOut[2], m->cutOut[3]));
+            sym->setCutOutSE(QPointF(m->cutOut[4], m->cutOut[5]));
+            sym->setCutOutSW(QPointF(m->cutOut[6], m->cutOut[7]));
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   saveMetrics
+//---------------------------------------------------------
+
+void ScoreFont::saveMetrics(const QString& path, const QByteArray& key) const
+      {
+      MetricsHeader h;
+      memcpy(h.magic, "MSFM", 4);
+      h.version    = METRICS_VERSION;
+      h.symbols    = _symbols.size();
+      h.recordSize = sizeof(SymMetrics);
+      memcpy(h.key, key.constData(), sizeof(h.key));
+
+      QByteArray data(reinterpret_cast<const char*>(&h), sizeof(h));
+      data.reserve(sizeof(h) + _symbols.size() * sizeof(SymMetrics));
+      for (const Sym& sym : _symbols) {
+            SymMetrics m;
+            memset(&m, 0, sizeof(m));
+            if (sym.string().size() > METRICS_MAX_CODES) {
+                  qDebug("ScoreFont: glyph string too long for metrics cache");
+                  return;
+                  }
+            m.length = sym.string().size();
+            memcpy(m.code, sym.string().utf16(), m.length * sizeof(quint16));
+            m.width  = sym.isValid() ? sym.width() : 0.0;
+            QRectF r = sym.bbox();
+            m.bbox[0] = r.x();
+            m.bbox[1] = r.y();
+            m.bbox[2] = r.width();
+            m.bbox[3] = r.height();
+            m.attach[0] = sym.attach().x();
+            m.attach[1] = sym.attach().y();
+            QPointF co[4] = { sym.cutOutNE(), sym.cutOutNW(), sym.cutOutSE(), sym.cutOutSW() };
+            for (int i = 0; i < 4; ++i) {
+                  m.cutOut[i * 2]     = co[i].x();
+                  m.cutOut[i * 2 + 1] = co[i].y();
+                  }
+            data.append(reinterpret_cast<const char*>(&m), sizeof(m));
+            }
+
+      QDir().mkpath(QFileInfo(path).absolutePath());
+      QSaveFile f(path);            // several converters may start at once
+      if (!f.open(QIODevice::WriteOnly) || f.write(data) != data.size() || !f.commit())
+            qDebug("ScoreFont: cannot write glyph metrics cache <%s>", qPrintable(path));
       }
 
 //---------------------------------------------------------
 //   fontFactory
+//    fonts are loaded on first use; layout can run on
+//    several threads, so loading is serialized
 //---------------------------------------------------------
 
+static QMutex fontLoadMutex;
+
 ScoreFont* ScoreFont::fontFactory(QString s)
       {
       ScoreFont* f = 0;
@@ -5537,6 +5697,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
             }
       Q_ASSERT(f);
 
+      QMutexLocker locker(&fontLoadMutex);
       if (!f->loaded)
             f->load();
       return f;
@@ -5549,6 +5710,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 ScoreFont* ScoreFont::fallbackFont()
       {
       ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
+      QMutexLocker locker(&fontLoadMutex);
       if (!f->loaded)
             f->load();
       return f;
@@ -2513,6 +2513,10 @@ class ScoreFont {
       static QVector<ScoreFont> _scoreFonts;
       const Sym& sym(SymId id) const { return _symbols[int(id)]; }
       void load();
+      void computeMetrics(const QFont&);
+      QByteArray metricsKey() const;
+      bool loadMetrics(const QString& path, const QByteArray& key);
+      void saveMetrics(const QString& path, const QByteArray& key) const;
 
    public:
       ScoreFont() {}
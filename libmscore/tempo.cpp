@@ -94,6 +94,7 @@ void TempoMap::normalize()
       qreal time  = 0;
       int tick    = 0;
       qreal tempo = 2.0;
+      _events.clear();
       for (auto e = begin(); e != end(); ++e) {
             int delta = e->first - tick;
             time += qreal(delta) / (MScore::division * tempo * _relTempo);
@@ -101,6 +102,7 @@ void TempoMap::normalize()
             e->second.time = time;
             tick  = e->first;
             tempo = e->second.tempo;
+            _events.push_back(*e);
             }
       ++_tempoSN;
       }
@@ -124,6 +126,7 @@ void TempoMap::dump() const
 void TempoMap::clear()
       {
       std::map<int,TEvent>::clear();
+      _events.clear();
       ++_tempoSN;
       }
 
@@ -257,12 +260,14 @@ int TempoMap::time2tick(qreal time, int* sn) const
 
       delta = 0.0;
       tempo = 2.0;
-      for (auto e = begin(); e != end(); ++e) {
-            if (e->second.time >= time)
-                  break;
-            delta = e->second.time;
-            tick  = e->first;
-            tempo = e->second.tempo;
+      // last event before time; event times never decrease
+      auto i = std::lower_bound(_events.begin(), _events.end(), time,
+         [](const std::pair<int, TEvent>& e, qreal t) { return e.second.time < t; });
+      if (i != _events.begin()) {
+            --i;
+            delta = i->second.time;
+            tick  = i->first;
+            tempo = i->second.tempo;
             }
       delta = time - delta;
       tick += lrint(delta * _relTempo * MScore::division * tempo);
@@ -43,6 +43,7 @@ class TempoMap : public std::map<int, TEvent> {
       int _tempoSN;           // serial no to track tempo changes
       qreal _tempo;           // tempo if not using tempo list (beats per second)
       qreal _relTempo;        // rel. tempo
+      std::vector<std::pair<int, TEvent>> _events;    // copy of the events, for binary search by time
 
       void normalize();
       void del(int tick);
@@ -20,6 +20,7 @@
 #include "textframe.h"
 #include "sym.h"
 #include "xml.h"
+#include <atomic>
 
 namespace Ms {
 
@@ -29,6 +30,60 @@ static const qreal superScriptOffset = -0.5;       // of x-height
 
 TextCursor Text::_cursor;
 
+static std::atomic<int> fontHits, fontMisses, layoutHits, layoutMisses;
+
+//---------------------------------------------------------
+//   TextFont::get
+//    layout runs on several threads and tiles are drawn
+//    concurrently, so the font table is locked
+//---------------------------------------------------------
+
+static QReadWriteLock textFontLock;
+static QHash<TextFontKey, TextFont*> textFonts;
+
+const TextFont* TextFont::get(const TextFontKey& key)
+      {
+      textFontLock.lockForRead();
+      TextFont* tf = textFonts.value(key);
+      textFontLock.unlock();
+      if (tf) {
+            ++fontHits;
+            return tf;
+            }
+      ++fontMisses;
+      QFont font;
+      font.setFamily(key.family);
+      font.setBold(key.flags & TextFontKey::BOLD);
+      font.setItalic(key.flags & TextFontKey::ITALIC);
+      font.setUnderline(key.flags & TextFontKey::UNDERLINE);
+      if (key.flags & TextFontKey::SYMBOL) {
+            font.setWeight(QFont::Normal);  // if not set we get system default
+            font.setStyleStrategy(QFont::NoFontMerging);
+            }
+      if (key.flags & TextFontKey::HINTED)
+            font.setHintingPreference(QFont::PreferVerticalHinting);
+      font.setPixelSize(key.pixelSize);
+
+      QWriteLocker locker(&textFontLock);
+      TextFont*& ntf = textFonts[key];
+      if (!ntf)
+            ntf = new TextFont(font);
+      return ntf;
+      }
+
+const TextFont* TextFont::get(const QFont& f)
+      {
+      TextFontKey key;
+      key.family    = f.family();
+      key.pixelSize = f.pixelSize();
+      key.flags     = (f.bold() ? TextFontKey::BOLD : 0)
+         | (f.italic() ? TextFontKey::ITALIC : 0)
+         | (f.underline() ? TextFontKey::UNDERLINE : 0)
+         | ((f.styleStrategy() & QFont::NoFontMerging) ? TextFontKey::SYMBOL : 0)
+         | (f.hintingPreference() == QFont::PreferVerticalHinting ? TextFontKey::HINTED : 0);
+      return get(key);
+      }
+
 //---------------------------------------------------------
 //   operator==
 //---------------------------------------------------------
@@ -165,55 +220,94 @@ bool TextFragment::operator ==(const TextFragment& f) const
 
 //---------------------------------------------------------
 //   draw
+//    symbol text must be up to date (done in layout)
 //---------------------------------------------------------
 
 void TextFragment::draw(QPainter* p, const Text* t) const
       {
-      p->setFont(font(t));
+      p->setFont(textFont(t)->font);
       p->drawText(pos, text);
       }
 
 //---------------------------------------------------------
-//   font
+//   scoreFont
+//    font for a symbol fragment
 //---------------------------------------------------------
 
-QFont TextFragment::font(const Text* t) const
+ScoreFont* TextFragment::scoreFont(const Text* t) const
       {
-      QFont font;
+      for (SymId id : ids) {
+            if (!t->symIsValid(id))
+                  return ScoreFont::fallbackFont();
+            }
+      return t->score()->scoreFont();
+      }
+
+//---------------------------------------------------------
+//   updateSymbols
+//    generate text of a symbol fragment
+//---------------------------------------------------------
+
+void TextFragment::updateSymbols(const Text* t) const
+      {
+      ScoreFont* f = scoreFont(t);
+      text.clear();
+      for (SymId id : ids)
+            text.append(f->toString(id));
+      }
+
+//---------------------------------------------------------
+//   textFont
+//---------------------------------------------------------
+
+const TextFont* TextFragment::textFont(const Text* t) const
+      {
+      TextFontKey key;
+      key.flags = format.underline() ? TextFontKey::UNDERLINE : 0;
 
       qreal m = format.fontSize() * MScore::DPI / PPI;
       if (t->textStyle().sizeIsSpatiumDependent())
             m *= t->spatium() / ( SPATIUM20 * MScore::DPI);
 
-      font.setUnderline(format.underline());
       if (format.type() == CharFormatType::TEXT) {
-            font.setFamily(format.fontFamily());
-            font.setBold(format.bold());
-            font.setItalic(format.italic());
+            key.family = format.fontFamily();
+            if (format.bold())
+                  key.flags |= TextFontKey::BOLD;
+            if (format.italic())
+                  key.flags |= TextFontKey::ITALIC;
             }
       else {
-            bool fallback = false;
-            for (SymId id : ids) {
-                  if (!t->symIsValid(id)) {
-                        fallback = true;
-                        break;
-                        }
-                  }
-            ScoreFont* f = fallback ? ScoreFont::fallbackFont() : t->score()->scoreFont();
-            text.clear();
-            for (SymId id : ids)
-                  text.append(f->toString(id));
-            font.setFamily(f->family());
-            font.setWeight(QFont::Normal);  // if not set we get system default
-            font.setStyleStrategy(QFont::NoFontMerging);
-            font.setHintingPreference(QFont::PreferVerticalHinting);
+            key.family = scoreFont(t)->family();
+            key.flags |= TextFontKey::SYMBOL | TextFontKey::HINTED;
             // if (f->family() == "Bravura")       // HACK: why are bravura dynamics are so small?
             //       m *= 1.9;
             }
       if (format.valign() != VerticalAlignment::AlignNormal)
             m *= subScriptSize;
-      font.setPixelSize(lrint(m));
-      return font;
+      key.pixelSize = lrint(m);
+      return TextFont::get(key);
+      }
+
+//---------------------------------------------------------
+//   fontMetrics
+//---------------------------------------------------------
+
+const QFontMetricsF& TextFragment::fontMetrics(const Text* t) const
+      {
+      if (format.type() == CharFormatType::SYMBOL)
+            updateSymbols(t);
+      return textFont(t)->fm;
+      }
+
+//---------------------------------------------------------
+//   font
+//---------------------------------------------------------
+
+QFont TextFragment::font(const Text* t) const
+      {
+      if (format.type() == CharFormatType::SYMBOL)
+            updateSymbols(t);
+      return textFont(t)->font;
       }
 
 //---------------------------------------------------------
@@ -255,14 +349,14 @@ void TextBlock::layout(Text* t)
                   }
             }
       if (_text.isEmpty()) {
-            QFontMetricsF fm(t->textStyle().fontPx(t->spatium()));
+            const QFontMetricsF& fm = t->styleFont()->fm;
             _bbox.setRect(0.0, -fm.ascent(), 1.0, fm.ascent());
             _lineSpacing = fm.lineSpacing();
             }
       else {
             for (TextFragment& f : _text) {
                   f.pos.setX(x);
-                  QFontMetricsF fm(f.font(t));
+                  const QFontMetricsF& fm = f.fontMetrics(t);
                   if (f.format.valign() != VerticalAlignment::AlignNormal) {
                         qreal voffset = fm.xHeight() / subScriptSize;   // use original height
                         if (f.format.valign() != VerticalAlignment::AlignNormal) {
@@ -307,7 +401,7 @@ qreal TextBlock::xpos(int column, const Text* t) const
       for (const TextFragment& f : _text) {
             if (column == col)
                   return f.pos.x();
-            QFontMetricsF fm(f.font(t));
+            const QFontMetricsF& fm = f.fontMetrics(t);
             int idx = 0;
             for (const QChar& c : f.text) {
                   ++idx;
@@ -402,7 +496,7 @@ int TextBlock::column(qreal x, Text* t) const
                   ++idx;
                   if (c.isHighSurrogate())
                         continue;
-                  QFontMetricsF fm(f.font(t));
+                  const QFontMetricsF& fm = f.fontMetrics(t);
                   qreal xo;
                   if (f.format.type() == CharFormatType::TEXT)
                         xo = fm.width(f.text.left(idx));
@@ -786,6 +880,7 @@ Text::Text(Score* s)
             _textStyle = s->textStyle(TextStyleType::DEFAULT);
       _layoutToParentWidth = false;
       _editMode            = false;
+      _layoutValid         = false;
       setFlag(ElementFlag::MOVABLE, true);
       }
 
@@ -799,6 +894,9 @@ Text::Text(const Text& st)
       _layoutToParentWidth = st._layoutToParentWidth;
       _editMode            = false;
       _textStyle           = st._textStyle;
+      _layoutValid         = st._layoutValid && !st._editMode;
+      _layoutText          = st._layoutText;
+      _layoutFormat        = st._layoutFormat;
       }
 
 //---------------------------------------------------------
@@ -928,19 +1026,15 @@ QRectF Text::cursorRect() const
       qreal ascent;
       if (fragment) {
             QFont font = fragment->font(this);
-            if (font.family() == score()->scoreFont()->font().family()) {
-                  QFontMetricsF fm = QFontMetricsF(_textStyle.fontPx(spatium()));
-                  ascent = fm.ascent();
-                  }
+            if (font.family() == score()->scoreFont()->font().family())
+                  ascent = styleFont()->fm.ascent();
             else {
                   QFontMetricsF fm = QFontMetrics(font);
                   ascent = fm.ascent();
                   }
             }
-      else {
-            QFontMetricsF fm = QFontMetricsF(_textStyle.fontPx(spatium()));
-            ascent = fm.ascent();
-            }
+      else
+            ascent = styleFont()->fm.ascent();
 
       ascent *= 0.7;
       qreal h = ascent;       // lineSpacing();
@@ -1035,6 +1129,9 @@ void Text::createLayout()
       _layout.clear();
       TextCursor cursor;
       cursor.initFromStyle(textStyle());
+      _layoutValid  = true;
+      _layoutText   = _text;
+      _layoutFormat = *cursor.format();
 
       int state = 0;
       QString token;
@@ -1138,8 +1235,16 @@ void Text::layout()
 
 void Text::layout1()
       {
-      if (!_editMode)
-            createLayout();
+      if (!_editMode) {
+            TextCursor cursor;
+            cursor.initFromStyle(textStyle());
+            if (_layoutValid && _text == _layoutText && *cursor.format() == _layoutFormat)
+                  ++layoutHits;
+            else {
+                  ++layoutMisses;
+                  createLayout();
+                  }
+            }
 
       if (_layout.isEmpty())
             _layout.append(TextBlock());
@@ -1227,7 +1332,7 @@ void Text::layoutFrame()
 
 qreal Text::lineSpacing() const
       {
-      return QFontMetricsF(textStyle().fontPx(spatium())).lineSpacing();
+      return styleFont()->fm.lineSpacing();
       }
 
 //---------------------------------------------------------
@@ -1236,7 +1341,7 @@ qreal Text::lineSpacing() const
 
 qreal Text::lineHeight() const
       {
-      return QFontMetricsF(textStyle().fontPx(spatium())).height();
+      return styleFont()->fm.height();
       }
 
 //---------------------------------------------------------
@@ -1245,7 +1350,33 @@ qreal Text::lineHeight() const
 
 qreal Text::baseLine() const
       {
-      return QFontMetricsF(textStyle().fontPx(spatium())).ascent();
+      return styleFont()->fm.ascent();
+      }
+
+//---------------------------------------------------------
+//   styleFont
+//---------------------------------------------------------
+
+const TextFont* Text::styleFont() const
+      {
+      return TextFont::get(textStyle().fontPx(spatium()));
+      }
+
+//---------------------------------------------------------
+//   layoutStats
+//---------------------------------------------------------
+
+TextLayoutStats Text::layoutStats()
+      {
+      return TextLayoutStats { fontHits, fontMisses, layoutHits, layoutMisses };
+      }
+
+void Text::resetLayoutStats()
+      {
+      fontHits     = 0;
+      fontMisses   = 0;
+      layoutHits   = 0;
+      layoutMisses = 0;
       }
 
 //---------------------------------------------------------
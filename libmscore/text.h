@@ -95,6 +95,51 @@ class TextCursor {
       };
 
 class Text;
+class ScoreFont;
+
+//---------------------------------------------------------
+//   TextFontKey
+//---------------------------------------------------------
+
+struct TextFontKey {
+      enum { BOLD = 1, ITALIC = 2, UNDERLINE = 4, SYMBOL = 8, HINTED = 16 };
+      QString family;
+      int pixelSize;
+      int flags;
+
+      bool operator==(const TextFontKey& k) const {
+            return pixelSize == k.pixelSize && flags == k.flags && family == k.family;
+            }
+      };
+
+inline uint qHash(const TextFontKey& k) { return qHash(k.family) ^ qHash((k.pixelSize << 5) | k.flags); }
+
+//---------------------------------------------------------
+//   TextFont
+//    interned font and font metrics; instances are
+//    shared by all texts and never deleted
+//---------------------------------------------------------
+
+struct TextFont {
+      QFont font;
+      QFontMetricsF fm;
+
+      TextFont(const QFont& f) : font(f), fm(f) {}
+      static const TextFont* get(const TextFontKey&);
+      static const TextFont* get(const QFont&);
+      };
+
+//---------------------------------------------------------
+//   TextLayoutStats
+//    cache counters, see Text::layoutStats()
+//---------------------------------------------------------
+
+struct TextLayoutStats {
+      int fontHits;
+      int fontMisses;
+      int layoutHits;         // layout1() could reuse the parsed text
+      int layoutMisses;
+      };
 
 //---------------------------------------------------------
 //   TextFragment
@@ -119,6 +164,10 @@ class TextFragment {
       TextFragment split(int column);
       void draw(QPainter*, const Text*) const;
       QFont font(const Text*) const;
+      const TextFont* textFont(const Text*) const;
+      const QFontMetricsF& fontMetrics(const Text*) const;
+      ScoreFont* scoreFont(const Text*) const;
+      void updateSymbols(const Text*) const;
       int columns() const;
       void changeFormat(FormatId id, QVariant data);
       };
@@ -186,6 +235,12 @@ class Text : public Element {
       bool _editMode;
       TextStyle _textStyle;
 
+      // _layout was parsed from _layoutText with _layoutFormat
+      // as initial format
+      bool _layoutValid;
+      QString _layoutText;
+      CharFormat _layoutFormat;
+
       static TextCursor _cursor;       // used during editing
 
       QRectF cursorRect() const;
@@ -220,7 +275,7 @@ class Text : public Element {
       virtual void draw(QPainter*) const override;
 
       bool editMode() const                   { return _editMode; }
-      void setEditMode(bool val)              { _editMode = val;  }
+      void setEditMode(bool val)              { _editMode = val; _layoutValid = false; }
 
       virtual void setTextStyle(const TextStyle& st);
       const TextStyle& textStyle() const      { return _textStyle; }
@@ -240,6 +295,10 @@ class Text : public Element {
       qreal lineSpacing() const;
       qreal lineHeight() const;
       virtual qreal baseLine() const override;
+      const TextFont* styleFont() const;
+
+      static TextLayoutStats layoutStats();
+      static void resetLayoutStats();
 
       bool isEmpty() const                { return _text.isEmpty(); }
       void clear()                        { _text.clear();          }
@@ -72,6 +72,14 @@
 #include "chordline.h"
 #include "tremolo.h"
 #include "sym.h"
+#include "style_p.h"
+#include "stem.h"
+#include "hook.h"
+#include "notedot.h"
+#include "ledgerline.h"
+#include "timesig.h"
+#include "lyrics.h"
+#include "text.h"
 
 namespace Ms {
 
@@ -164,6 +172,174 @@ void UndoCommand::unwind()
             }
       }
 
+//---------------------------------------------------------
+//   layoutRange
+//    compute the tick range [stick, etick] touched by
+//    the child commands of a macro
+//    return false if the layout of the whole score may
+//    be affected
+//---------------------------------------------------------
+
+bool UndoCommand::layoutRange(int& stick, int& etick) const
+      {
+      stick = -1;
+      etick = -1;
+      for (const UndoCommand* c : childList) {
+            if (!c->affectedTicks(stick, etick))
+                  return false;
+            }
+      return stick != -1;
+      }
+
+//---------------------------------------------------------
+//   memoryUsage
+//    estimated bytes held by the command and its
+//    children; elements taken out of the score are
+//    added by the UndoStack, see detached()
+//---------------------------------------------------------
+
+int UndoCommand::memoryUsage() const
+      {
+      int n = sizeof(UndoCommand) + childList.size() * sizeof(void*);
+      for (const UndoCommand* c : childList)
+            n += c->memoryUsage();
+      return n;
+      }
+
+//---------------------------------------------------------
+//   detached
+//    collect the elements the command holds outside of
+//    the score when it is done (or undone); for every
+//    element the last command touching it decides
+//---------------------------------------------------------
+
+void UndoCommand::detached(bool done, QHash<Element*, bool>& el) const
+      {
+      if (done) {
+            for (const UndoCommand* c : childList)
+                  c->detached(done, el);
+            }
+      else {
+            for (int i = childList.size() - 1; i >= 0; --i)
+                  childList[i]->detached(done, el);
+            }
+      }
+
+//---------------------------------------------------------
+//   elementSize
+//    size of one element by its real type; element types
+//    not listed count as their base class
+//---------------------------------------------------------
+
+static int elementSize(const Element* e)
+      {
+      switch (e->type()) {
+            case ElementType::NOTE:             return sizeof(Note);
+            case ElementType::CHORD:            return sizeof(Chord);
+            case ElementType::REST:             return sizeof(Rest);
+            case ElementType::STEM:             return sizeof(Stem);
+            case ElementType::HOOK:             return sizeof(Hook);
+            case ElementType::BEAM:             return sizeof(Beam);
+            case ElementType::ACCIDENTAL:       return sizeof(Accidental);
+            case ElementType::NOTEDOT:          return sizeof(NoteDot);
+            case ElementType::LEDGER_LINE:      return sizeof(LedgerLine);
+            case ElementType::ARTICULATION:     return sizeof(Articulation);
+            case ElementType::TREMOLO:          return sizeof(Tremolo);
+            case ElementType::CHORDLINE:        return sizeof(ChordLine);
+            case ElementType::BREATH:           return sizeof(Breath);
+            case ElementType::BEND:             return sizeof(Bend);
+            case ElementType::TREMOLOBAR:       return sizeof(TremoloBar);
+            case ElementType::TUPLET:           return sizeof(Tuplet);
+            case ElementType::CLEF:             return sizeof(Clef);
+            case ElementType::KEYSIG:           return sizeof(KeySig);
+            case ElementType::TIMESIG:          return sizeof(TimeSig);
+            case ElementType::BAR_LINE:         return sizeof(BarLine);
+            case ElementType::LAYOUT_BREAK:     return sizeof(LayoutBreak);
+            case ElementType::IMAGE:            return sizeof(Image);
+            case ElementType::TIE:              return sizeof(Tie);
+            case ElementType::SLUR:             return sizeof(Slur);
+            case ElementType::HAIRPIN:          return sizeof(Hairpin);
+            case ElementType::VOLTA:            return sizeof(Volta);
+            case ElementType::MEASURE:          return sizeof(Measure);
+            case ElementType::HBOX:
+            case ElementType::VBOX:
+            case ElementType::TBOX:
+            case ElementType::FBOX:             return sizeof(Box);
+            default:
+                  break;
+            }
+      if (e->isText()) {
+            const Text* t = static_cast<const Text*>(e);
+            int n;
+            switch (e->type()) {
+                  case ElementType::HARMONY:           n = sizeof(Harmony);       break;
+                  case ElementType::DYNAMIC:           n = sizeof(Dynamic);       break;
+                  case ElementType::FINGERING:         n = sizeof(Fingering);     break;
+                  case ElementType::LYRICS:            n = sizeof(Lyrics);        break;
+                  case ElementType::TEMPO_TEXT:        n = sizeof(TempoText);     break;
+                  case ElementType::STAFF_TEXT:        n = sizeof(StaffText);     break;
+                  case ElementType::REHEARSAL_MARK:    n = sizeof(RehearsalMark); break;
+                  case ElementType::INSTRUMENT_CHANGE: n = sizeof(InstrumentChange); break;
+                  default:                             n = sizeof(Text);          break;
+                  }
+            return n + t->text().size() * int(sizeof(QChar));
+            }
+      return sizeof(Element);
+      }
+
+static void addElementSize(void* data, Element* e)
+      {
+      *static_cast<int*>(data) += elementSize(e);
+      }
+
+//---------------------------------------------------------
+//   elementMemory
+//    memory held by a detached element and everything
+//    in it; scanElements() does not report measures,
+//    frames and segments themselves
+//---------------------------------------------------------
+
+static int elementMemory(Element* e)
+      {
+      int n = 0;
+      e->scanElements(&n, addElementSize, true);
+      switch (e->type()) {
+            case ElementType::MEASURE:
+                  for (Segment* s = static_cast<Measure*>(e)->first(); s; s = s->next())
+                        n += sizeof(Segment);
+                  // fall through
+            case ElementType::HBOX:
+            case ElementType::VBOX:
+            case ElementType::TBOX:
+            case ElementType::FBOX:
+                  n += elementSize(e);
+                  break;
+            default:
+                  break;
+            }
+      return n;
+      }
+
+//---------------------------------------------------------
+//   stepMemory
+//    memory of a done undo step including the elements
+//    it took out of the score; the elements stay alive
+//    when the step is dropped, other parts of the
+//    program may still refer to them
+//---------------------------------------------------------
+
+static int stepMemory(const UndoCommand* cmd)
+      {
+      int n = cmd->memoryUsage();
+      QHash<Element*, bool> el;
+      cmd->detached(true, el);
+      for (auto i = el.cbegin(); i != el.cend(); ++i) {
+            if (i.value())
+                  n += elementMemory(i.key());
+            }
+      return n;
+      }
+
 //---------------------------------------------------------
 //   UndoStack
 //---------------------------------------------------------
@@ -171,8 +347,10 @@ void UndoCommand::unwind()
 UndoStack::UndoStack()
       {
       curCmd   = 0;
+      lastCmd  = 0;
       curIdx   = 0;
       cleanIdx = 0;
+      _memory  = 0;
       }
 
 //---------------------------------------------------------
@@ -193,7 +371,8 @@ void UndoStack::beginMacro()
             qDebug("UndoStack:beginMacro(): already active");
             return;
             }
-      curCmd = new UndoCommand();
+      curCmd  = new UndoCommand();
+      lastCmd = 0;
       if (MScore::debugMode)
             qDebug("UndoStack::beginMacro %p, UndoStack %p", curCmd, this);
       }
@@ -215,12 +394,45 @@ void UndoStack::endMacro(bool rollback)
       else {
             while (list.size() > curIdx) {
                   UndoCommand* cmd = list.takeLast();
+                  _memory -= sizes.takeLast();
                   delete cmd;
                   }
+            int n = stepMemory(curCmd);
             list.append(curCmd);
+            sizes.append(n);
+            _memory += n;
             ++curIdx;
+            if (MScore::debugMode)
+                  qDebug("UndoStack: macro %d bytes, %d steps %lld bytes", n, list.size(), _memory);
+            trim();
+            }
+      curCmd  = 0;
+      lastCmd = 0;
+      }
+
+//---------------------------------------------------------
+//   trim
+//    drop the oldest undo steps until the stack fits
+//    into MScore::undoLimit and MScore::undoMemoryLimit;
+//    the last step is always kept
+//---------------------------------------------------------
+
+void UndoStack::trim()
+      {
+      while (curIdx > 1) {
+            bool tooMany = MScore::undoLimit && list.size() > MScore::undoLimit;
+            bool tooBig  = MScore::undoMemoryLimit && _memory > MScore::undoMemoryLimit;
+            if (!tooMany && !tooBig)
+                  break;
+            UndoCommand* cmd = list.takeFirst();
+            _memory -= sizes.takeFirst();
+            if (cmd == lastCmd)
+                  lastCmd = 0;
+            delete cmd;
+            --curIdx;
+            // the clean state may no longer be reachable
+            cleanIdx = cleanIdx > 0 ? cleanIdx - 1 : -1;
             }
-      curCmd = 0;
       }
 
 //---------------------------------------------------------
@@ -298,7 +510,8 @@ void UndoStack::undo()
             Q_ASSERT(curIdx >= 0);
             if (MScore::debugMode)
                   qDebug("--undo index %d", curIdx);
-            list[curIdx]->undo();
+            lastCmd = list[curIdx];
+            lastCmd->undo();
             }
       }
 
@@ -311,7 +524,8 @@ void UndoStack::redo()
       if (canRedo()) {
             if (MScore::debugMode)
                   qDebug("--redo index %d", curIdx);
-            list[curIdx++]->redo();
+            lastCmd = list[curIdx++];
+            lastCmd->redo();
             }
       }
 
@@ -342,6 +556,15 @@ void SaveState::redo()
       score->setSelection(redoSelection);
       }
 
+//---------------------------------------------------------
+//   memoryUsage
+//---------------------------------------------------------
+
+int SaveState::memoryUsage() const
+      {
+      return sizeof(SaveState) + (undoSelection.elements().size() + redoSelection.elements().size()) * sizeof(void*);
+      }
+
 //---------------------------------------------------------
 //   undoChangeProperty
 //---------------------------------------------------------
@@ -1250,6 +1473,79 @@ void Score::undoChangeTpc(Note* note, int v)
       note->undoChangeProperty(P_ID::TPC1, v);
       }
 
+//---------------------------------------------------------
+//   elementTicks
+//    extend [stick, etick] by the ticks occupied by e
+//    return false if a change of e can affect the layout
+//    outside of the measures it lives in
+//---------------------------------------------------------
+
+static bool elementTicks(Element* e, int& stick, int& etick)
+      {
+      int t1;
+      int t2;
+      switch (e->type()) {
+            case ElementType::SLUR:
+            case ElementType::HAIRPIN: {
+                  Spanner* sp = static_cast<Spanner*>(e);
+                  t1 = sp->tick();
+                  t2 = sp->tick2();
+                  }
+                  break;
+            case ElementType::TIE: {
+                  Tie* tie = static_cast<Tie*>(e);
+                  if (!tie->startNote())
+                        return false;
+                  t1 = tie->startNote()->chord()->tick();
+                  t2 = tie->endNote() ? tie->endNote()->chord()->tick() : t1;
+                  }
+                  break;
+            case ElementType::BEAM: {
+                  Beam* beam = static_cast<Beam*>(e);
+                  if (beam->elements().isEmpty())
+                        return false;
+                  t1 = beam->elements().front()->tick();
+                  t2 = beam->elements().back()->tick();
+                  }
+                  break;
+            case ElementType::NOTE:
+            case ElementType::CHORD:
+            case ElementType::REST:
+            case ElementType::ACCIDENTAL:
+            case ElementType::ARTICULATION:
+            case ElementType::FINGERING:
+            case ElementType::LYRICS:
+            case ElementType::STAFF_TEXT:
+            case ElementType::DYNAMIC:
+            case ElementType::HARMONY:
+            case ElementType::ARPEGGIO:
+            case ElementType::TREMOLO:
+            case ElementType::BREATH:
+            case ElementType::CHORDLINE:
+            case ElementType::NOTEDOT:
+            case ElementType::STEM:
+            case ElementType::STEM_SLASH:
+            case ElementType::HOOK: {
+                  Element* p = e;
+                  while (p && p->type() != ElementType::SEGMENT)
+                        p = p->parent();
+                  if (!p)
+                        return false;
+                  t1 = t2 = static_cast<Segment*>(p)->tick();
+                  }
+                  break;
+            default:
+                  return false;
+            }
+      if (t1 < 0 || t2 < t1)
+            return false;
+      if (stick == -1 || t1 < stick)
+            stick = t1;
+      if (t2 > etick)
+            etick = t2;
+      return true;
+      }
+
 //---------------------------------------------------------
 //   AddElement
 //---------------------------------------------------------
@@ -1259,6 +1555,11 @@ AddElement::AddElement(Element* e)
       element = e;
       }
 
+bool AddElement::affectedTicks(int& stick, int& etick) const
+      {
+      return elementTicks(element, stick, etick);
+      }
+
 //---------------------------------------------------------
 //   undoRemoveTuplet
 //---------------------------------------------------------
@@ -1391,6 +1692,11 @@ RemoveElement::RemoveElement(Element* e)
             }
       }
 
+bool RemoveElement::affectedTicks(int& stick, int& etick) const
+      {
+      return elementTicks(element, stick, etick);
+      }
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -1675,6 +1981,11 @@ void ChangePitch::flip()
       note->score()->setLayoutAll(true);
       }
 
+bool ChangePitch::affectedTicks(int& stick, int& etick) const
+      {
+      return elementTicks(note, stick, etick);
+      }
+
 //---------------------------------------------------------
 //   ChangeElement
 //---------------------------------------------------------
@@ -1685,6 +1996,18 @@ ChangeElement::ChangeElement(Element* oe, Element* ne)
       newElement = ne;
       }
 
+//---------------------------------------------------------
+//   detached
+//    the replaced element is out of the score while the
+//    command is done, its clone while it is undone
+//---------------------------------------------------------
+
+void ChangeElement::detached(bool done, QHash<Element*, bool>& el) const
+      {
+      el[oldElement] = done;
+      el[newElement] = !done;
+      }
+
 void ChangeElement::flip()
       {
 //      qDebug("ChangeElement::flip() %s(%p) -> %s(%p) links %d",
@@ -2265,6 +2588,15 @@ ChangePageFormat::~ChangePageFormat()
       delete pf;
       }
 
+//---------------------------------------------------------
+//   memoryUsage
+//---------------------------------------------------------
+
+int ChangePageFormat::memoryUsage() const
+      {
+      return sizeof(ChangePageFormat) + sizeof(PageFormat);
+      }
+
 //---------------------------------------------------------
 //   flip
 //---------------------------------------------------------
@@ -2536,6 +2868,18 @@ ChangeStyle::ChangeStyle(Score* s, const MStyle& st)
       {
       }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    the saved style is usually detached from the score
+//    style
+//---------------------------------------------------------
+
+int ChangeStyle::memoryUsage() const
+      {
+      return sizeof(ChangeStyle) + sizeof(StyleData) + int(StyleIdx::STYLES) * sizeof(QVariant)
+         + style.textStyles().size() * (sizeof(TextStyle) + sizeof(TextStyleData));
+      }
+
 static void updateTimeSigs(void*, Element* e)
       {
       if (e->type() == ElementType::TIMESIG) {
@@ -2770,6 +3114,19 @@ void RemoveMeasures::redo()
       fm->score()->setLayoutAll(true);
       }
 
+//---------------------------------------------------------
+//   detached
+//---------------------------------------------------------
+
+void RemoveMeasures::detached(bool done, QHash<Element*, bool>& el) const
+      {
+      for (MeasureBase* m = fm; m; m = m->next()) {
+            el[m] = done;
+            if (m == lm)
+                  break;
+            }
+      }
+
 //---------------------------------------------------------
 //   undo
 //    insert back measures
@@ -2793,6 +3150,19 @@ void InsertMeasures::redo()
       fm->score()->connectTies();
       }
 
+//---------------------------------------------------------
+//   detached
+//---------------------------------------------------------
+
+void InsertMeasures::detached(bool done, QHash<Element*, bool>& el) const
+      {
+      for (MeasureBase* m = fm; m; m = m->next()) {
+            el[m] = !done;
+            if (m == lm)
+                  break;
+            }
+      }
+
 //---------------------------------------------------------
 //   flip
 //---------------------------------------------------------
@@ -3154,6 +3524,39 @@ void ChangeProperty::flip()
       propertyStyle = ps;
       }
 
+//---------------------------------------------------------
+//   ChangeProperty::affectedTicks
+//    line break hints and stretch of a measure only
+//    change the breaking of its system
+//---------------------------------------------------------
+
+bool ChangeProperty::affectedTicks(int& stick, int& etick) const
+      {
+      if (element->type() == ElementType::MEASURE) {
+            if (id != P_ID::BREAK_HINT && id != P_ID::USER_STRETCH)
+                  return false;
+            Measure* m = static_cast<Measure*>(element);
+            if (stick == -1 || m->tick() < stick)
+                  stick = m->tick();
+            if (m->tick() > etick)
+                  etick = m->tick();
+            return true;
+            }
+      return elementTicks(element, stick, etick);
+      }
+
+//---------------------------------------------------------
+//   ChangeProperty::memoryUsage
+//---------------------------------------------------------
+
+int ChangeProperty::memoryUsage() const
+      {
+      int n = sizeof(ChangeProperty);
+      if (property.type() == QVariant::String)
+            n += property.toString().size() * sizeof(QChar);
+      return n;
+      }
+
 //---------------------------------------------------------
 //   ChangeMetaText::flip
 //---------------------------------------------------------
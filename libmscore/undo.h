@@ -106,6 +106,10 @@ class UndoCommand {
       UndoCommand* removeChild()         { return childList.takeLast(); }
       int childCount() const             { return childList.size();     }
       void unwind();
+      virtual bool affectedTicks(int&, int&) const { return false; }
+      bool layoutRange(int& stick, int& etick) const;
+      virtual int memoryUsage() const;
+      virtual void detached(bool done, QHash<Element*, bool>& el) const;
 #ifdef DEBUG_UNDO
       virtual const char* name() const  { return "UndoCommand"; }
 #endif
@@ -117,10 +121,15 @@ class UndoCommand {
 
 class UndoStack {
       UndoCommand* curCmd;
+      UndoCommand* lastCmd;         ///< last undone or redone command
       QList<UndoCommand*> list;
+      QList<int> sizes;             ///< memoryUsage() of the commands in list
+      qint64 _memory;               ///< sum of sizes
       int curIdx;
       int cleanIdx;
 
+      void trim();
+
    public:
       UndoStack();
       ~UndoStack();
@@ -136,8 +145,13 @@ class UndoStack {
       bool canRedo() const          { return curIdx < list.size(); }
       bool isClean() const          { return cleanIdx == curIdx;   }
       UndoCommand* current() const  { return curCmd;               }
+      UndoCommand* last() const     { return lastCmd;              }
       void undo();
       void redo();
+
+      int count() const                 { return list.size();  }
+      int memoryUsage(int idx) const    { return sizes[idx];   }
+      qint64 memoryUsage() const        { return _memory;      }
       };
 
 //---------------------------------------------------------
@@ -155,6 +169,8 @@ class SaveState : public UndoCommand {
       SaveState(Score*);
       virtual void undo();
       virtual void redo();
+      virtual bool affectedTicks(int&, int&) const { return true; }
+      virtual int memoryUsage() const;
       UNDO_NAME("SaveState")
       };
 
@@ -326,6 +342,7 @@ class ChangePitch : public UndoCommand {
 
    public:
       ChangePitch(Note* note, int pitch, int tpc1, int tpc2);
+      virtual bool affectedTicks(int& stick, int& etick) const;
       UNDO_NAME("ChangePitch")
       };
 
@@ -370,6 +387,7 @@ class ChangeElement : public UndoCommand {
 
    public:
       ChangeElement(Element* oldElement, Element* newElement);
+      virtual void detached(bool done, QHash<Element*, bool>& el) const;
       UNDO_NAME("ChangeElement")
       };
 
@@ -641,6 +659,8 @@ class AddElement : public UndoCommand {
       AddElement(Element*);
       virtual void undo();
       virtual void redo();
+      virtual bool affectedTicks(int& stick, int& etick) const;
+      virtual void detached(bool done, QHash<Element*, bool>& el) const { el[element] = !done; }
 #ifdef DEBUG_UNDO
       virtual const char* name() const;
 #endif
@@ -657,6 +677,8 @@ class RemoveElement : public UndoCommand {
       RemoveElement(Element*);
       virtual void undo();
       virtual void redo();
+      virtual bool affectedTicks(int& stick, int& etick) const;
+      virtual void detached(bool done, QHash<Element*, bool>& el) const { el[element] = done; }
 #ifdef DEBUG_UNDO
       virtual const char* name() const;
 #endif
@@ -725,6 +747,7 @@ class ChangePageFormat : public UndoCommand {
    public:
       ChangePageFormat(Score*, PageFormat*, qreal sp, int po);
       ~ChangePageFormat();
+      virtual int memoryUsage() const;
       virtual void undo() { flip(); }
       virtual void redo() { flip(); }
       UNDO_NAME("ChangePageFormat")
@@ -853,6 +876,7 @@ class ChangeStyle : public UndoCommand {
 
    public:
       ChangeStyle(Score*, const MStyle&);
+      virtual int memoryUsage() const;
       UNDO_NAME("ChangeStyle")
       };
 
@@ -949,6 +973,7 @@ class RemoveMeasures : public UndoCommand {
       RemoveMeasures(Measure*, Measure*);
       virtual void undo();
       virtual void redo();
+      virtual void detached(bool done, QHash<Element*, bool>& el) const;
       UNDO_NAME("RemoveMeasures")
       };
 
@@ -964,6 +989,7 @@ class InsertMeasures : public UndoCommand {
       InsertMeasures(Measure* m1, Measure* m2) : fm(m1), lm(m2) {}
       virtual void undo();
       virtual void redo();
+      virtual void detached(bool done, QHash<Element*, bool>& el) const;
       UNDO_NAME("InsertMeasures")
       };
 
@@ -1222,6 +1248,8 @@ class ChangeProperty : public UndoCommand {
       ChangeProperty(Element* e, P_ID i, const QVariant& v, PropertyStyle ps = PropertyStyle::NOSTYLE)
          : element(e), id(i), property(v), propertyStyle(ps) {}
       P_ID getId() const  { return id; }
+      virtual bool affectedTicks(int& stick, int& etick) const;
+      virtual int memoryUsage() const;
       UNDO_NAME("ChangeProperty")
       };
 
@@ -22,22 +22,222 @@ namespace Ms {
 
 QString docName;
 
+//---------------------------------------------------------
+//   tagNames
+//    must be in sync with enum class Tag
+//---------------------------------------------------------
+
+static const char* tagNames[] = {
+      "",
+      "Accidental",
+      "Ambitus",
+      "Arpeggio",
+      "Articulation",
+      "Attribute",
+      "BarLine",
+      "Beam",
+      "BeamMode",
+      "Bend",
+      "Breath",
+      "Chord",
+      "ChordLine",
+      "Clef",
+      "Dynamic",
+      "Event",
+      "Events",
+      "FiguredBass",
+      "Fingering",
+      "FretDiagram",
+      "Glissando",
+      "HairPin",
+      "Harmony",
+      "Hook",
+      "Image",
+      "InstrumentChange",
+      "Jump",
+      "KeySig",
+      "LayoutBreak",
+      "Lyrics",
+      "Marker",
+      "MeasureNumber",
+      "Note",
+      "NoteDot",
+      "Ottava",
+      "Pedal",
+      "RehearsalMark",
+      "RepeatMeasure",
+      "Rest",
+      "Segment",
+      "Slur",
+      "StaffState",
+      "StaffText",
+      "Stem",
+      "StemDirection",
+      "Symbol",
+      "Tempo",
+      "Text",
+      "TextLine",
+      "Tie",
+      "TimeSig",
+      "Tremolo",
+      "Trill",
+      "Tuplet",
+      "Volta",
+      "acciaccatura",
+      "appoggiatura",
+      "breakMultiMeasureRest",
+      "color",
+      "dotPosition",
+      "dots",
+      "duration",
+      "durationType",
+      "endRepeat",
+      "endSpanner",
+      "fret",
+      "ghost",
+      "grace16",
+      "grace16after",
+      "grace32",
+      "grace32after",
+      "grace4",
+      "grace8after",
+      "head",
+      "headType",
+      "irregular",
+      "leadingSpace",
+      "lid",
+      "line",
+      "mirror",
+      "move",
+      "multiMeasureRest",
+      "noOffset",
+      "noStem",
+      "offTimeOffset",
+      "offTimeType",
+      "offset",
+      "onTimeOffset",
+      "onTimeType",
+      "pitch",
+      "placement",
+      "play",
+      "pos",
+      "selected",
+      "slashStyle",
+      "small",
+      "startRepeat",
+      "stretch",
+      "string",
+      "tag",
+      "tick",
+      "tickOffset",
+      "ticklen",
+      "tpc",
+      "tpc2",
+      "track",
+      "trailingSpace",
+      "tuning",
+      "userAccidental",
+      "userOff",
+      "veloType",
+      "velocity",
+      "visible",
+      "voice",
+      "vspacer",
+      "vspacerDown",
+      "vspacerUp",
+      };
+
+//---------------------------------------------------------
+//   TagTable
+//    open addressing hash table from element name to
+//    Tag; lookups compare against the latin1 names and
+//    never allocate
+//---------------------------------------------------------
+
+struct TagTable {
+      static const int SIZE = 512;        // power of two, > 2 * Tag::TAGS
+      unsigned char slot[SIZE];
+
+      TagTable() {
+            static_assert(sizeof(tagNames)/sizeof(*tagNames) == size_t(Tag::TAGS), "tagNames out of sync with Tag");
+            memset(slot, 0, sizeof(slot));
+            for (int i = 1; i < int(Tag::TAGS); ++i) {
+                  QString name(QLatin1String(tagNames[i]));
+                  uint h = qHash(QStringRef(&name)) & (SIZE - 1);
+                  while (slot[h])
+                        h = (h + 1) & (SIZE - 1);
+                  slot[h] = i;
+                  }
+            }
+      Tag lookup(const QStringRef& name) const {
+            uint h = qHash(name) & (SIZE - 1);
+            while (slot[h]) {
+                  if (name == QLatin1String(tagNames[slot[h]]))
+                        return Tag(slot[h]);
+                  h = (h + 1) & (SIZE - 1);
+                  }
+            return Tag::Unknown;
+            }
+      };
+
+//---------------------------------------------------------
+//   tag
+//    return the interned name of the current element
+//---------------------------------------------------------
+
+Tag XmlReader::tag() const
+      {
+      static const TagTable table;
+      return table.lookup(name());
+      }
+
+//---------------------------------------------------------
+//   readText
+//    like readElementText() but reuses a buffer owned
+//    by the reader; the result is valid until the next
+//    call
+//---------------------------------------------------------
+
+const QString& XmlReader::readText()
+      {
+      _text.resize(0);
+      if (!isStartElement())
+            return _text;
+      for (;;) {
+            switch (readNext()) {
+                  case Characters:
+                  case EntityReference:
+                        _text.append(text());
+                        break;
+                  case EndElement:
+                        return _text;
+                  case ProcessingInstruction:
+                  case Comment:
+                        break;
+                  default:
+                        if (!hasError())
+                              raiseError("Expected character data.");
+                        return _text;
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   intAttribute
 //---------------------------------------------------------
 
 int XmlReader::intAttribute(const char* s, int _default) const
       {
-      if (attributes().hasAttribute(s))
-            // return attributes().value(s).toString().toInt();
-            return attributes().value(s).toInt();
+      if (attributes().hasAttribute(QLatin1String(s)))
+            // return attributes().value(QLatin1String(s)).toString().toInt();
+            return attributes().value(QLatin1String(s)).toInt();
       else
             return _default;
       }
 
 int XmlReader::intAttribute(const char* s) const
       {
-      return attributes().value(s).toInt();
+      return attributes().value(QLatin1String(s)).toInt();
       }
 
 //---------------------------------------------------------
@@ -46,13 +246,13 @@ int XmlReader::intAttribute(const char* s) const
 
 double XmlReader::doubleAttribute(const char* s) const
       {
-      return attributes().value(s).toDouble();
+      return attributes().value(QLatin1String(s)).toDouble();
       }
 
 double XmlReader::doubleAttribute(const char* s, double _default) const
       {
-      if (attributes().hasAttribute(s))
-            return attributes().value(s).toDouble();
+      if (attributes().hasAttribute(QLatin1String(s)))
+            return attributes().value(QLatin1String(s)).toDouble();
       else
             return _default;
       }
@@ -63,8 +263,8 @@ double XmlReader::doubleAttribute(const char* s, double _default) const
 
 QString XmlReader::attribute(const char* s, const QString& _default) const
       {
-      if (attributes().hasAttribute(s))
-            return attributes().value(s).toString();
+      if (attributes().hasAttribute(QLatin1String(s)))
+            return attributes().value(QLatin1String(s)).toString();
       else
             return _default;
       }
@@ -75,7 +275,7 @@ QString XmlReader::attribute(const char* s, const QString& _default) const
 
 bool XmlReader::hasAttribute(const char* s) const
       {
-      return attributes().hasAttribute(s);
+      return attributes().hasAttribute(QLatin1String(s));
       }
 
 //---------------------------------------------------------
@@ -288,7 +488,7 @@ PlaceText readPlacement(XmlReader& e)
 
 void Xml::fTag(const char* name, const Fraction& f)
       {
-      tagE(QString("%1 z=\"%2\" n=\"%3\"").arg(name).arg(f.numerator()).arg(f.denominator()));
+      tagE("%s z=\"%d\" n=\"%d\"", name, f.numerator(), f.denominator());
       }
 
 //---------------------------------------------------------
@@ -297,9 +497,51 @@ void Xml::fTag(const char* name, const Fraction& f)
 
 void Xml::putLevel()
       {
-      int level = stack.size();
-      for (int i = 0; i < level * 2; ++i)
-            *this << ' ';
+      static const char spaces[] = "                                ";
+      const int n = sizeof(spaces) - 1;
+      for (int i = _levels.size() * 2; i > 0; i -= n)
+            *this << (spaces + n - qMin(i, n));
+      }
+
+//---------------------------------------------------------
+//   pushName
+//    remember the name of an opened tag, without its
+//    attributes
+//---------------------------------------------------------
+
+void Xml::pushName(const char* s)
+      {
+      _levels.append(_names.size());
+      const char* p = strchr(s, ' ');
+      _names.append(s, p ? p - s : int(strlen(s)));
+      _names.append('\0');
+      }
+
+void Xml::pushName(const QString& s)
+      {
+      _levels.append(_names.size());
+      int n = s.indexOf(' ');
+      if (n == -1)
+            n = s.size();
+      for (int i = 0; i < n; ++i)
+            _names.append(char(s.at(i).unicode()));
+      _names.append('\0');
+      }
+
+//---------------------------------------------------------
+//   putEndName
+//    </mops> for the tag opened as <mops attribute="value">
+//---------------------------------------------------------
+
+void Xml::putEndName(const char* s)
+      {
+      const char* p = strchr(s, ' ');
+      *this << "</";
+      if (p)
+            *this << QString::fromLatin1(s, p - s);
+      else
+            *this << s;
+      *this << ">\n";
       }
 
 //---------------------------------------------------------
@@ -316,22 +558,36 @@ void Xml::header()
 //    <mops attribute="value">
 //---------------------------------------------------------
 
+void Xml::stag(const char* s)
+      {
+      putLevel();
+      *this << '<' << s << ">\n";
+      pushName(s);
+      }
+
 void Xml::stag(const QString& s)
       {
       putLevel();
-      *this << '<' << s << '>' << endl;
-      stack.append(s.split(' ')[0]);
+      *this << '<' << s << ">\n";
+      pushName(s);
       }
 
 //---------------------------------------------------------
 //   etag
 //    </mops>
+//    output is flushed to the device only when the
+//    outermost tag is closed
 //---------------------------------------------------------
 
 void Xml::etag()
       {
       putLevel();
-      *this << "</" << stack.takeLast() << '>' << endl;
+      int idx = _levels.last();
+      _levels.removeLast();
+      *this << "</" << (_names.constData() + idx) << ">\n";
+      _names.resize(idx);
+      if (_levels.isEmpty())
+            flush();
       }
 
 //---------------------------------------------------------
@@ -349,7 +605,7 @@ void Xml::tagE(const char* format, ...)
       vsnprintf(buffer, BS, format, args);
       *this << buffer;
       va_end(args);
-      *this << "/>" << endl;
+      *this << "/>\n";
       }
 
 //---------------------------------------------------------
@@ -380,7 +636,9 @@ void Xml::ntag(const char* name)
 
 void Xml::netag(const char* s)
       {
-      *this << "</" << s << '>' << endl;
+      *this << "</" << s << ">\n";
+      if (_levels.isEmpty())
+            flush();
       }
 
 //---------------------------------------------------------
@@ -412,10 +670,10 @@ void Xml::tag(P_ID id, QVariant data, QVariant defaultData)
             case P_TYPE::DIRECTION:
                   switch(Direction(data.toInt())) {
                         case Direction::UP:
-                              tag(name, QVariant("up"));
+                              tag(name, "up");
                               break;
                         case Direction::DOWN:
-                              tag(name, QVariant("down"));
+                              tag(name, "down");
                               break;
                         case Direction::AUTO:
                               break;
@@ -424,10 +682,10 @@ void Xml::tag(P_ID id, QVariant data, QVariant defaultData)
             case P_TYPE::DIRECTION_H:
                   switch(DirectionH(data.toInt())) {
                         case DirectionH::DH_LEFT:
-                              tag(name, QVariant("left"));
+                              tag(name, "left");
                               break;
                         case DirectionH::DH_RIGHT:
-                              tag(name, QVariant("right"));
+                              tag(name, "right");
                               break;
                         case DirectionH::DH_AUTO:
                               break;
@@ -436,33 +694,33 @@ void Xml::tag(P_ID id, QVariant data, QVariant defaultData)
             case P_TYPE::LAYOUT_BREAK:
                   switch(LayoutBreak::LayoutBreakType(data.toInt())) {
                         case LayoutBreak::LayoutBreakType::LINE:
-                              tag(name, QVariant("line"));
+                              tag(name, "line");
                               break;
                         case LayoutBreak::LayoutBreakType::PAGE:
-                              tag(name, QVariant("page"));
+                              tag(name, "page");
                               break;
                         case LayoutBreak::LayoutBreakType::SECTION:
-                              tag(name, QVariant("section"));
+                              tag(name, "section");
                               break;
                         }
                   break;
             case P_TYPE::VALUE_TYPE:
                   switch(ValueType(data.toInt())) {
                         case ValueType::OFFSET_VAL:
-                              tag(name, QVariant("offset"));
+                              tag(name, "offset");
                               break;
                         case ValueType::USER_VAL:
-                              tag(name, QVariant("user"));
+                              tag(name, "user");
                               break;
                         }
                   break;
             case P_TYPE::PLACEMENT:
                   switch(Placement(data.toInt())) {
                         case Placement::ABOVE:
-                              tag(name, QVariant("above"));
+                              tag(name, "above");
                               break;
                         case Placement::BELOW:
-                              tag(name, QVariant("below"));
+                              tag(name, "below");
                               break;
                         }
                   break;
@@ -481,13 +739,51 @@ void Xml::tag(P_ID id, QVariant data, QVariant defaultData)
 
 void Xml::tag(const char* name, QVariant data, QVariant defaultData)
       {
-      if (data != defaultData)
-            tag(QString(name), data);
+      if (data == defaultData)
+            return;
+      switch(data.type()) {
+            case QVariant::Bool:
+            case QVariant::Char:
+            case QVariant::Int:
+            case QVariant::UInt:
+                  tag(name, data.toInt());
+                  break;
+            case QVariant::Double:
+                  tag(name, data.value<double>());
+                  break;
+            case QVariant::String:
+                  tag(name, data.value<QString>());
+                  break;
+            default:
+                  tag(QString(name), data);
+                  break;
+            }
+      }
+
+void Xml::tag(const char* name, int val)
+      {
+      putLevel();
+      *this << '<' << name << '>' << val;
+      putEndName(name);
+      }
+
+void Xml::tag(const char* name, double val)
+      {
+      putLevel();
+      *this << '<' << name << '>' << val;
+      putEndName(name);
+      }
+
+void Xml::tag(const char* name, const QString& s)
+      {
+      putLevel();
+      *this << '<' << name << '>' << xmlString(s);
+      putEndName(name);
       }
 
 void Xml::tag(const QString& name, QVariant data)
       {
-      QString ename(name.split(' ')[0]);
+      QString ename(name.left(name.indexOf(' ')));
 
       putLevel();
       switch(data.type()) {
@@ -558,6 +854,14 @@ void Xml::tag(const char* name, const QWidget* g)
 
 QString Xml::xmlString(const QString& s)
       {
+      int i = 0;
+      for (; i < s.size(); ++i) {
+            ushort c = s.at(i).unicode();
+            if (c == '<' || c == '>' || c == '&' || c == '\"' || (c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D))
+                  break;
+            }
+      if (i == s.size())
+            return s;         // nothing to escape, share the string
       QString escaped;
       escaped.reserve(s.size());
       for (int i = 0; i < s.size(); ++i) {
@@ -38,6 +38,134 @@ struct SpannerValues {
       int track2;
       };
 
+//---------------------------------------------------------
+//   Tag
+//    interned names of the elements read by the hot
+//    read() methods; must be in sync with tagNames[]
+//    in xml.cpp
+//---------------------------------------------------------
+
+enum class Tag : unsigned char {
+      Unknown,
+      Accidental,
+      Ambitus,
+      Arpeggio,
+      Articulation,
+      Attribute,
+      BarLine,
+      Beam,
+      BeamMode,
+      Bend,
+      Breath,
+      Chord,
+      ChordLine,
+      Clef,
+      Dynamic,
+      Event,
+      Events,
+      FiguredBass,
+      Fingering,
+      FretDiagram,
+      Glissando,
+      HairPin,
+      Harmony,
+      Hook,
+      Image,
+      InstrumentChange,
+      Jump,
+      KeySig,
+      LayoutBreak,
+      Lyrics,
+      Marker,
+      MeasureNumber,
+      Note,
+      NoteDot,
+      Ottava,
+      Pedal,
+      RehearsalMark,
+      RepeatMeasure,
+      Rest,
+      Segment,
+      Slur,
+      StaffState,
+      StaffText,
+      Stem,
+      StemDirection,
+      Symbol,
+      Tempo,
+      Text,
+      TextLine,
+      Tie,
+      TimeSig,
+      Tremolo,
+      Trill,
+      Tuplet,
+      Volta,
+      acciaccatura,
+      appoggiatura,
+      breakMultiMeasureRest,
+      color,
+      dotPosition,
+      dots,
+      duration,
+      durationType,
+      endRepeat,
+      endSpanner,
+      fret,
+      ghost,
+      grace16,
+      grace16after,
+      grace32,
+      grace32after,
+      grace4,
+      grace8after,
+      head,
+      headType,
+      irregular,
+      leadingSpace,
+      lid,
+      line,
+      mirror,
+      move,
+      multiMeasureRest,
+      noOffset,
+      noStem,
+      offTimeOffset,
+      offTimeType,
+      offset,
+      onTimeOffset,
+      onTimeType,
+      pitch,
+      placement,
+      play,
+      pos,
+      selected,
+      slashStyle,
+      small,
+      startRepeat,
+      stretch,
+      string,
+      tag,
+      tick,
+      tickOffset,
+      ticklen,
+      tpc,
+      tpc2,
+      track,
+      trailingSpace,
+      tuning,
+      userAccidental,
+      userOff,
+      veloType,
+      velocity,
+      visible,
+      voice,
+      vspacer,
+      vspacerDown,
+      vspacerUp,
+      TAGS
+      };
+
 //---------------------------------------------------------
 //   XmlReader
 //---------------------------------------------------------
@@ -55,6 +183,7 @@ class XmlReader : public XmlStreamReader {
       QList<StaffType> _staffTypes;
       void htmlToString(int level, QString*);
       Interval _transpose;
+      QString _text;    // buffer of readText()
 
    public:
       XmlReader(QFile* f) : XmlStreamReader(f), docName(f->fileName()) {}
@@ -65,7 +194,7 @@ class XmlReader : public XmlStreamReader {
       void unknown() const;
 
       // attribute helper routines:
-      QString attribute(const char* s) const { return attributes().value(s).toString(); }
+      QString attribute(const char* s) const { return attributes().value(QLatin1String(s)).toString(); }
       QString attribute(const char* s, const QString&) const;
       int intAttribute(const char* s) const;
       int intAttribute(const char* s, int _default) const;
@@ -73,11 +202,14 @@ class XmlReader : public XmlStreamReader {
       double doubleAttribute(const char* s, double _default) const;
       bool hasAttribute(const char* s) const;
 
-      // helper routines based on readElementText():
-      int readInt()         { return readElementText().toInt();    }
-      int readInt(bool* ok) { return readElementText().toInt(ok);  }
-      double readDouble()   { return readElementText().toDouble(); }
-      bool readBool()       { return readElementText().toInt() != 0; }
+      Tag tag() const;
+
+      // helper routines based on readText():
+      const QString& readText();
+      int readInt()         { return readText().toInt();    }
+      int readInt(bool* ok) { return readText().toInt(ok);  }
+      double readDouble()   { return readText().toDouble(); }
+      bool readBool()       { return readText().toInt() != 0; }
       QPointF readPoint();
       QSizeF readSize();
       QRectF readRect();
@@ -119,8 +251,12 @@ class XmlReader : public XmlStreamReader {
 class Xml : public QTextStream {
       static const int BS = 2048;
 
-      QList<QString> stack;
+      QByteArray _names;            // names of the open tags, '\0' separated
+      QVector<int> _levels;         // start of each open tag name in _names
       void putLevel();
+      void pushName(const char*);
+      void pushName(const QString&);
+      void putEndName(const char*);
       QList<Spanner*> _spanner;
 
    public:
@@ -142,12 +278,13 @@ class Xml : public QTextStream {
       Xml(QIODevice* dev);
       Xml();
 
-      void sTag(const char* name, Spatium sp) { Xml::tag(name, QVariant(sp.val())); }
+      void sTag(const char* name, Spatium sp) { Xml::tag(name, sp.val()); }
       void pTag(const char* name, PlaceText);
       void fTag(const char* name, const Fraction&);
 
       void header();
 
+      void stag(const char*);
       void stag(const QString&);
       void etag();
 
@@ -160,8 +297,11 @@ class Xml : public QTextStream {
       void tag(P_ID id, QVariant data, QVariant defaultData = QVariant());
       void tag(const char* name, QVariant data, QVariant defaultData = QVariant());
       void tag(const QString&, QVariant data);
-      void tag(const char* name, const char* s)    { tag(name, QVariant(s)); }
-      void tag(const char* name, const QString& s) { tag(name, QVariant(s)); }
+      void tag(const char* name, const char* s)    { tag(name, QString(s)); }
+      void tag(const char* name, const QString& s);
+      void tag(const char* name, int val);
+      void tag(const char* name, unsigned val)     { tag(name, int(val)); }
+      void tag(const char* name, double val);
       void tag(const char* name, const QWidget*);
 
       void writeXml(const QString&, QString s);
@@ -23,40 +23,78 @@
 #include "libmscore/score.h"
 #include "libmscore/note.h"
 #include "libmscore/part.h"
+#include "libmscore/tempo.h"
 #include "libmscore/mscore.h"
 #include "synthesizer/msynthesizer.h"
 #include "musescore.h"
 #include "preferences.h"
 
+#if defined(USE_SSE) && defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
 namespace Ms {
 
-#ifdef HAS_AUDIOFILE
+//---------------------------------------------------------
+//   computePeak
+//    return the maximum of current and the absolute
+//    values of n samples in buf
+//---------------------------------------------------------
+
+static float computePeak(const float* buf, unsigned n, float current)
+      {
+      unsigned i = 0;
+#if defined(USE_SSE) && defined(__SSE__)
+      const __m128 signMask = _mm_set1_ps(-0.0f);
+      __m128 vpeak = _mm_set1_ps(current);
+      for (; i + 4 <= n; i += 4)
+            vpeak = _mm_max_ps(vpeak, _mm_andnot_ps(signMask, _mm_loadu_ps(buf + i)));
+      float v[4];
+      _mm_storeu_ps(v, vpeak);
+      current = qMax(qMax(v[0], v[1]), qMax(v[2], v[3]));
+#endif
+      for (; i < n; ++i)
+            current = qMax(current, qAbs(buf[i]));
+      return current;
+      }
 
 //---------------------------------------------------------
-//   saveAudio
+//   applyGain
 //---------------------------------------------------------
 
-bool MuseScore::saveAudio(Score* score, const QString& name, const QString& ext)
+static void applyGain(float* buf, unsigned n, float gain)
       {
-      int format;
-      if (ext == "wav")
-            format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
-      else if (ext == "ogg")
-            format = SF_FORMAT_OGG | SF_FORMAT_VORBIS;
-      else if (ext == "flac")
-            format = SF_FORMAT_FLAC | SF_FORMAT_PCM_16;
-      else {
-            qDebug("unknown audio file type <%s>", qPrintable(ext));
-            return false;
-            }
+      unsigned i = 0;
+#if defined(USE_SSE) && defined(__SSE__)
+      const __m128 vgain = _mm_set1_ps(gain);
+      for (; i + 4 <= n; i += 4)
+            _mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), vgain));
+#endif
+      for (; i < n; ++i)
+            buf[i] *= gain;
+      }
+
+//---------------------------------------------------------
+//   renderAudio
+//    render score in a single pass through a new
+//    synthesizer with the export sample rate. Interleaved
+//    stereo float frames are written to device, the peak
+//    value is returned in peak.
+//    The progress bar is left open with range
+//    [0, 2 * frames]; the first half is used here, the
+//    second half is left to the encoder.
+//---------------------------------------------------------
 
+bool MuseScore::renderAudio(Score* score, QIODevice* device, float* peak)
+      {
       EventMap events;
       score->renderMidi(&events);
-      if(events.size() == 0)
+      if (events.size() == 0)
             return false;
 
       MasterSynthesizer* synti = synthesizerFactory();
       synti->init();
+      synti->setOffline(true);
       int sampleRate = preferences.exportAudioSampleRate;
       synti->setSampleRate(sampleRate);
       synti->setState(score->synthesizerState());
@@ -64,112 +102,163 @@ bool MuseScore::saveAudio(Score* score, const QString& name, const QString& ext)
       int oldSampleRate  = MScore::sampleRate;
       MScore::sampleRate = sampleRate;
 
-      SF_INFO info;
-      memset(&info, 0, sizeof(info));
-      info.channels   = 2;
-      info.samplerate = sampleRate;
-      info.format     = format;
-      SNDFILE* sf     = sf_open(qPrintable(name), SFM_WRITE, &info);
-      if (sf == 0) {
-            qDebug("open soundfile failed: %s", sf_strerror(sf));
-            delete synti;
-            MScore::sampleRate = oldSampleRate;
-            return false;
-            }
-
       QProgressBar* pBar = showProgressBar();
       pBar->reset();
 
-      float peak  = 0.0;
-      double gain = 1.0;
+      events.setFrames([score](int utick) { return int(score->utick2utime(utick) * MScore::sampleRate); },
+         score->tempomap()->relTempo());
+
       EventMap::const_iterator endPos = events.cend();
       --endPos;
       const int et = (score->utick2utime(endPos->first) + 1) * MScore::sampleRate;
-      pBar->setRange(0, et);
+      pBar->setRange(0, 2 * et);
 
-      for (int pass = 0; pass < 2; ++pass) {
-            EventMap::const_iterator playPos;
-            playPos = events.cbegin();
+      //
+      // init instruments
+      //
+      foreach(const Part* part, score->parts()) {
+            foreach(const Channel& a, part->instr()->channel()) {
+                  a.updateInitList();
+                  foreach(MidiCoreEvent e, a.init) {
+                        if (e.type() == ME_INVALID)
+                              continue;
+                        e.setChannel(a.channel);
+                        int syntiIdx= synti->index(score->midiMapping(a.channel)->articulation->synti);
+                        synti->play(e, syntiIdx);
+                        }
+                  }
+            }
+
+      static const unsigned FRAMES = 512;
+      float buffer[FRAMES * 2];
+      int playTime = 0;
+      bool ok      = true;
+      *peak        = 0.0;
+      EventMap::const_iterator playPos = events.cbegin();
 
+      for (;;) {
+            unsigned frames = FRAMES;
             //
-            // init instruments
+            // collect events for one segment
             //
-            foreach(const Part* part, score->parts()) {
-                  foreach(const Channel& a, part->instr()->channel()) {
-                        a.updateInitList();
-                        foreach(MidiCoreEvent e, a.init) {
-                              if (e.type() == ME_INVALID)
-                                    continue;
-                              e.setChannel(a.channel);
-                              int syntiIdx= synti->index(score->midiMapping(a.channel)->articulation->synti);
-                              synti->play(e, syntiIdx);
+            memset(buffer, 0, sizeof(float) * FRAMES * 2);
+            int endTime = playTime + frames;
+            float* p = buffer;
+            for (; playPos != events.cend(); ++playPos) {
+                  int f = events.frame(playPos);
+                  if (f >= endTime)
+                        break;
+                  int n = f - playTime;
+                  if (n) {
+                        synti->process(n, p);
+                        p += 2 * n;
+                        }
+
+                  playTime  += n;
+                  frames    -= n;
+                  const NPlayEvent& e = playPos->second;
+                  if (e.isChannelEvent()) {
+                        int channelIdx = e.channel();
+                        Channel* c = score->midiMapping(channelIdx)->articulation;
+                        if (!c->mute) {
+                              synti->play(e, synti->index(c->synti));
                               }
                         }
                   }
+            if (frames) {
+                  synti->process(frames, p);
+                  playTime += frames;
+                  }
+            *peak = computePeak(buffer, FRAMES * 2, *peak);
+            if (device->write((const char*)buffer, sizeof(buffer)) != qint64(sizeof(buffer))) {
+                  qDebug("renderAudio: write to spill file failed");
+                  ok = false;
+                  break;
+                  }
+            playTime = endTime;
+            pBar->setValue(playTime);
 
-            static const unsigned FRAMES = 512;
-            float buffer[FRAMES * 2];
-            int playTime = 0;
+            if (playTime >= et)
+                  break;
+            }
 
-            for (;;) {
-                  unsigned frames = FRAMES;
-                  //
-                  // collect events for one segment
-                  //
-                  memset(buffer, 0, sizeof(float) * FRAMES * 2);
-                  int endTime = playTime + frames;
-                  float* p = buffer;
-                  for (; playPos != events.cend(); ++playPos) {
-                        int f = score->utick2utime(playPos->first) * MScore::sampleRate;
-                        if (f >= endTime)
-                              break;
-                        int n = f - playTime;
-                        if (n) {
-                              synti->process(n, p);
-                              p += 2 * n;
-                              }
+      MScore::sampleRate = oldSampleRate;
+      delete synti;
+      return ok;
+      }
 
-                        playTime  += n;
-                        frames    -= n;
-                        const NPlayEvent& e = playPos->second;
-                        if (e.isChannelEvent()) {
-                              int channelIdx = e.channel();
-                              Channel* c = score->midiMapping(channelIdx)->articulation;
-                              if (!c->mute) {
-                                    synti->play(e, synti->index(c->synti));
-                                    }
-                              }
-                        }
-                  if (frames) {
-                        synti->process(frames, p);
-                        playTime += frames;
-                        }
-                  if (pass == 1) {
-                        for (unsigned i = 0; i < FRAMES * 2; ++i)
-                              buffer[i] *= gain;
-                        sf_writef_float(sf, buffer, FRAMES);
-                        }
-                  else {
-                        for (unsigned i = 0; i < FRAMES * 2; ++i)
-                              peak = qMax(peak, qAbs(buffer[i]));
-                        }
-                  playTime = endTime;
-                  pBar->setValue((pass * et + playTime) / 2);
+#ifdef HAS_AUDIOFILE
+
+//---------------------------------------------------------
+//   saveAudio
+//    the score is rendered once into a temporary file
+//    while the peak is measured; the normalized samples
+//    are then streamed from there into the encoder
+//---------------------------------------------------------
 
-                  if (playTime >= et)
+bool MuseScore::saveAudio(Score* score, const QString& name, const QString& ext)
+      {
+      int format;
+      if (ext == "wav")
+            format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+      else if (ext == "ogg")
+            format = SF_FORMAT_OGG | SF_FORMAT_VORBIS;
+      else if (ext == "flac")
+            format = SF_FORMAT_FLAC | SF_FORMAT_PCM_16;
+      else {
+            qDebug("unknown audio file type <%s>", qPrintable(ext));
+            return false;
+            }
+
+      QTemporaryFile spill;
+      if (!spill.open()) {
+            qDebug("saveAudio: cannot create temporary file");
+            return false;
+            }
+      float peak;
+      if (!renderAudio(score, &spill, &peak)) {
+            hideProgressBar();
+            return false;
+            }
+
+      SF_INFO info;
+      memset(&info, 0, sizeof(info));
+      info.channels   = 2;
+      info.samplerate = preferences.exportAudioSampleRate;
+      info.format     = format;
+      SNDFILE* sf     = sf_open(qPrintable(name), SFM_WRITE, &info);
+      if (sf == 0) {
+            qDebug("open soundfile failed: %s", sf_strerror(sf));
+            hideProgressBar();
+            return false;
+            }
+
+      if (peak == 0.0)
+            qDebug("song is empty");
+      else {
+            QProgressBar* pBar = showProgressBar();
+            const qint64 totalFrames = spill.size() / (2 * sizeof(float));
+            const float gain = 0.99 / peak;
+
+            static const unsigned FRAMES = 16384;
+            float* buffer = new float[FRAMES * 2];
+            qint64 frames = 0;
+            spill.seek(0);
+            for (;;) {
+                  qint64 n = spill.read((char*)buffer, sizeof(float) * FRAMES * 2);
+                  if (n <= 0)
                         break;
+                  n /= 2 * sizeof(float);
+                  applyGain(buffer, n * 2, gain);
+                  sf_writef_float(sf, buffer, n);
+                  frames += n;
+                  pBar->setValue(pBar->maximum() / 2 + int(frames * pBar->maximum() / (2 * totalFrames)));
                   }
-            if (pass == 0 && peak == 0.0) {
-                  qDebug("song is empty");
-                  break;
-                  }
-            gain = 0.99 / peak;
+            delete[] buffer;
             }
 
       hideProgressBar();
 
-      MScore::sampleRate = oldSampleRate;
-      delete synti;
       if (sf_close(sf)) {
             qDebug("close soundfile failed");
             return false;
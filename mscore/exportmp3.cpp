@@ -612,11 +612,6 @@ QString MP3Exporter::getLibraryTypeString()
 
 bool MuseScore::saveMp3(Score* score, const QString& name)
       {
-      EventMap events;
-      score->renderMidi(&events);
-      if(events.size() == 0)
-            return false;
-
       MP3Exporter exporter;
       if (!exporter.loadLibrary(MP3Exporter::Maybe)) {
             QSettings settings;
@@ -684,140 +679,55 @@ bool MuseScore::saveMp3(Score* score, const QString& name)
             return false;
             }
 
+      QTemporaryFile spill;
+      float peak;
+      if (!spill.open() || !renderAudio(score, &spill, &peak)) {
+            hideProgressBar();
+            MScore::sampleRate = oldSampleRate;
+            return false;
+            }
+      if (peak == 0.0)
+            qDebug("song is empty");
+
       int bufferSize   = exporter.getOutBufferSize();
       uchar* bufferOut = new uchar[bufferSize];
-      MasterSynthesizer* synti = synthesizerFactory();
-      synti->init();
-      synti->setSampleRate(sampleRate);
-      synti->setState(score->synthesizerState());
-
-      MScore::sampleRate = sampleRate;
 
       QProgressBar* pBar = showProgressBar();
-      pBar->reset();
+      const qint64 totalFrames = spill.size() / (2 * sizeof(float));
 
       static const int FRAMES = 512;
+      float buffer[FRAMES * 2];
       float bufferL[FRAMES];
       float bufferR[FRAMES];
 
-      float  peak = 0.0;
-      double gain = 1.0;
-      EventMap::const_iterator endPos = events.cend();
-      --endPos;
-      const int et = (score->utick2utime(endPos->first) + 1) * MScore::sampleRate;
-      pBar->setRange(0, et);
-
-      for (int pass = 0; pass < 2; ++pass) {
-            EventMap::const_iterator playPos;
-            playPos = events.cbegin();
-            //
-            // init instruments
-            //
-            foreach(const Part* part, score->parts()) {
-                  foreach(const Channel& a, part->instr()->channel()) {
-                        a.updateInitList();
-                        foreach(MidiCoreEvent e, a.init) {
-                              if (e.type() == ME_INVALID)
-                                    continue;
-                              e.setChannel(a.channel);
-                              int syntiIdx= synti->index(score->midiMapping(a.channel)->articulation->synti);
-                              synti->play(e, syntiIdx);
-                              }
-                        }
-                  }
-
-            int playTime = 0.0;
-
-            for (;;) {
-                  unsigned frames = FRAMES;
-                  //
-                  // collect events for one segment
-                  //
-                  memset(bufferL, 0, sizeof(float) * FRAMES);
-                  memset(bufferR, 0, sizeof(float) * FRAMES);
-                  double endTime = playTime + frames;
-
-                  float* l = bufferL;
-                  float* r = bufferR;
-
-                  for (; playPos != events.cend(); ++playPos) {
-                        double f = score->utick2utime(playPos->first) * MScore::sampleRate;
-                        if (f >= endTime)
-                              break;
-                        int n = f - playTime;
-                        if (n) {
-                              float bu[n * 2];
-                              memset(bu, 0, sizeof(float) * 2 * n);
-
-                              synti->process(n, bu);
-                              float* sp = bu;
-                              for (int i = 0; i < n; ++i) {
-                                    *l++ = *sp++;
-                                    *r++ = *sp++;
-                                    }
-                              playTime  += n;
-                              frames    -= n;
-                              }
-                        const NPlayEvent& e = playPos->second;
-                        if (e.isChannelEvent()) {
-                              int channelIdx = e.channel();
-                              Channel* c = score->midiMapping(channelIdx)->articulation;
-                              if (!c->mute) {
-                                    synti->play(e, synti->index(c->synti));
-                                    }
-                              }
-                        }
-                  if (frames) {
-                        float bu[frames * 2];
-                        memset(bu, 0, sizeof(float) * 2 * frames);
-                        synti->process(frames, bu);
-                        float* sp = bu;
-                        for (unsigned i = 0; i < frames; ++i) {
-                              *l++ = *sp++;
-                              *r++ = *sp++;
-                              }
-                        playTime += frames;
-                        }
-
-                  if (pass == 1) {
-                        for (int i = 0; i < FRAMES; ++i) {
-                              bufferL[i] *= gain;
-                              bufferR[i] *= gain;
-                              }
-                        long bytes;
-                        if (FRAMES < inSamples)
-                              bytes = exporter.encodeRemainder(bufferL, bufferR,  FRAMES , bufferOut);
-                        else
-                              bytes = exporter.encodeBuffer(bufferL, bufferR, bufferOut);
-                        if (bytes < 0) {
-                              if (MScore::noGui)
-                                    qDebug("exportmp3: error from encoder: %ld", bytes);
-                              else
-                                    QMessageBox::warning(0,
-                                       tr("Encoding Error"),
-                                       tr("Error %1 returned from MP3 encoder").arg(bytes),
-                                       QString::null, QString::null);
-                              break;
-                              }
-                        else
-                              file.write((char*)bufferOut, bytes);
-                        }
-                  else {
-                        for (int i = 0; i < FRAMES; ++i) {
-                              peak = qMax(peak, qAbs(bufferL[i]));
-                              peak = qMax(peak, qAbs(bufferR[i]));
-                              }
-                        }
-                  playTime = endTime;
-                  pBar->setValue((pass * et + playTime) / 2);
-                  if (playTime >= et)
-                        break;
+      const float gain = peak == 0.0 ? 1.0 : 0.99 / peak;
+      qint64 frames = 0;
+      spill.seek(0);
+      while (peak != 0.0 && spill.read((char*)buffer, sizeof(buffer)) == qint64(sizeof(buffer))) {
+            const float* sp = buffer;
+            for (int i = 0; i < FRAMES; ++i) {
+                  bufferL[i] = *sp++ * gain;
+                  bufferR[i] = *sp++ * gain;
                   }
-            if (pass == 0 && peak == 0.0) {
-                  qDebug("song is empty");
+            long bytes;
+            if (FRAMES < inSamples)
+                  bytes = exporter.encodeRemainder(bufferL, bufferR,  FRAMES , bufferOut);
+            else
+                  bytes = exporter.encodeBuffer(bufferL, bufferR, bufferOut);
+            if (bytes < 0) {
+                  if (MScore::noGui)
+                        qDebug("exportmp3: error from encoder: %ld", bytes);
+                  else
+                        QMessageBox::warning(0,
+                           tr("Encoding Error"),
+                           tr("Error %1 returned from MP3 encoder").arg(bytes),
+                           QString::null, QString::null);
                   break;
                   }
-            gain = 0.99 / peak;
+            else
+                  file.write((char*)bufferOut, bytes);
+            frames += FRAMES;
+            pBar->setValue(pBar->maximum() / 2 + int(frames * pBar->maximum() / (2 * totalFrames)));
             }
 
       long bytes = exporter.finishStream(bufferOut);
@@ -825,8 +735,7 @@ bool MuseScore::saveMp3(Score* score, const QString& name)
             file.write((char*)bufferOut, bytes);
 
       hideProgressBar();
-      delete synti;
-      delete bufferOut;
+      delete[] bufferOut;
       file.close();
       MScore::sampleRate = oldSampleRate;
       return true;
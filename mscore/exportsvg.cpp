@@ -0,0 +1,188 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2002-2014 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENSE.GPL
+//=============================================================================
+
+#include "config.h"
+#include "svggenerator.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/element.h"
+#include "libmscore/mscore.h"
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   paintElements
+//---------------------------------------------------------
+
+static void paintElements(QPainter& p, const QList<const Element*>& el)
+      {
+      foreach(const Element* e, el) {
+            if (!e->visible())
+                  continue;
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      }
+
+//---------------------------------------------------------
+//   SvgPage
+//---------------------------------------------------------
+
+struct SvgPage {
+      QList<const Element*> elements;
+      QPointF offset;         // position of the page in the drawing
+      QString idPrefix;       // keeps generated ids unique across fragments
+      QString path;           // own file; empty: fragment of the score drawing
+      QByteArray svg;         // fragment
+      bool ok;
+      };
+
+//---------------------------------------------------------
+//   saveSvg
+//    pages are painted into svg fragments which are written
+//    in page order, a few pages ahead of the file at most;
+//    with parallel set they are painted on the thread pool.
+//    With lastPage >= 0 the pages firstPage..lastPage (0
+//    based) are written to files of their own as soon as
+//    they are painted; a range without a page of the score
+//    is an error.
+//    return true on success
+//---------------------------------------------------------
+
+bool saveSvg(Score* score, const QString& saveName, double dpi, int firstPage, int lastPage, bool parallel)
+      {
+      QString title(score->metaTag("workTitle"));
+      if(title.isEmpty())
+            title = "MuseScore";
+      QString description = QString("Generated by MuseScore %1").arg(VERSION);
+      const PageFormat* pf = score->pageFormat();
+      double mag = dpi / MScore::DPI;
+
+      const QList<Page*>& pl = score->pages();
+      int pages = pl.size();
+      bool pageFiles = lastPage >= 0;
+      if (pageFiles) {
+            firstPage = qMax(firstPage, 0);
+            if (firstPage > lastPage || firstPage >= pages) {
+                  qDebug("saveSvg: no page %d-%d in a score of %d pages", firstPage + 1, lastPage + 1, pages);
+                  return false;
+                  }
+            lastPage = qMin(lastPage, pages - 1);
+            }
+      else {
+            firstPage = 0;
+            lastPage  = pages - 1;
+            }
+
+      qreal pw = pf->width() * MScore::DPI;
+      qreal w  = pageFiles ? pw : pw * pages;
+      qreal h  = pf->height() * MScore::DPI;
+      QSize size(w * mag, h * mag);
+      QRectF viewBox(0.0, 0.0, w * mag, h * mag);
+
+      auto paintPage = [=](SvgPage& page) {
+            SvgGenerator printer;
+            printer.setResolution(dpi);
+            printer.setTitle(title);
+            printer.setDescription(description);
+            printer.setSize(size);
+            printer.setViewBox(viewBox);
+            QBuffer buffer(&page.svg);
+            if (page.path.isEmpty()) {
+                  printer.setFragment(true);
+                  printer.setIdPrefix(page.idPrefix);
+                  printer.setOutputDevice(&buffer);
+                  }
+            else
+                  printer.setFileName(page.path);
+
+            QPainter p;
+            if (!p.begin(&printer)) {
+                  page.ok = false;
+                  return;
+                  }
+            p.setRenderHint(QPainter::Antialiasing, true);
+            p.setRenderHint(QPainter::TextAntialiasing, true);
+            p.scale(mag, mag);
+            p.translate(page.offset);
+            paintElements(p, page.elements);
+            page.ok = p.end();
+            };
+
+      SvgGenerator document;
+      document.setResolution(dpi);
+      document.setTitle(title);
+      document.setDescription(description);
+      document.setSize(size);
+      document.setViewBox(viewBox);
+      QFile f(saveName);
+      if (!pageFiles) {
+            if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                  qDebug("saveSvg: cannot open <%s>", qPrintable(saveName));
+                  return false;
+                  }
+            f.write(document.header().toUtf8());
+            }
+
+      QString baseName(saveName);
+      if (baseName.endsWith(".svg"))
+            baseName = baseName.left(baseName.size() - 4);
+      int padding = QString("%1").arg(pages).size();
+
+      parallel = parallel && lastPage > firstPage && QFontDatabase::supportsThreadedFontRendering();
+      int batch = parallel ? QThreadPool::globalInstance()->maxThreadCount() * 2 : 1;
+
+      score->setPrinting(true);
+      bool rv = true;
+      for (int first = firstPage; rv && first <= lastPage; first += batch) {
+            QVector<SvgPage> jobs;
+            for (int pageNumber = first; pageNumber <= lastPage && pageNumber < first + batch; ++pageNumber) {
+                  SvgPage job;
+                  job.elements = pl.at(pageNumber)->elements();
+                  if (pageFiles)
+                        job.path = baseName + QString("-%1.svg").arg(pageNumber+1, padding, 10, QLatin1Char('0'));
+                  else {
+                        job.offset   = QPointF(pw * pageNumber, 0.0);
+                        job.idPrefix = QString("p%1-").arg(pageNumber + 1);
+                        }
+                  job.ok = false;
+                  jobs.append(job);
+                  }
+            if (parallel)
+                  QtConcurrent::blockingMap(jobs, paintPage);
+            else {
+                  for (SvgPage& job : jobs)
+                        paintPage(job);
+                  }
+            for (const SvgPage& job : jobs) {
+                  if (!job.ok) {
+                        qDebug("saveSvg: cannot write <%s>", qPrintable(job.path.isEmpty() ? saveName : job.path));
+                        rv = false;
+                        break;
+                        }
+                  if (!pageFiles)
+                        f.write(job.svg);
+                  }
+            }
+      score->setPrinting(false);
+
+      if (!pageFiles) {
+            f.write(document.footer().toUtf8());
+            rv = rv && f.error() == QFile::NoError;
+            }
+      return rv;
+      }
+
+}
+
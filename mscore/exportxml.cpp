@@ -258,6 +258,7 @@ public:
 //---------------------------------------------------------
 
 typedef QHash<const Chord*, const Trill*> TrillHash;
+typedef QList<int> IntVector;
 
 class ExportMusicXml {
       Score* _score;
@@ -272,6 +273,8 @@ class ExportMusicXml {
       int tenths;
       TrillHash trillStart;
       TrillHash trillStop;
+      IntVector integers;           // used by calcDivisions()
+      IntVector primes;
 
       int findBracket(const TextLine* tl) const;
       void chord(Chord* chord, int staff, const QList<Lyrics*>* ll, bool useDrumset);
@@ -814,13 +817,9 @@ static void findTrills(Measure* measure, int strack, int etrack, TrillHash& tril
 // helpers for ::calcDivisions
 //---------------------------------------------------------
 
-typedef QList<int> IntVector;
-static IntVector integers;
-static IntVector primes;
-
 // check if all integers can be divided by d
 
-static bool canDivideBy(int d)
+static bool canDivideBy(const IntVector& integers, int d)
       {
       bool res = true;
       for (int i = 0; i < integers.count(); i++) {
@@ -833,14 +832,14 @@ static bool canDivideBy(int d)
 
 // divide all integers by d
 
-static void divideBy(int d)
+static void divideBy(IntVector& integers, int d)
       {
       for (int i = 0; i < integers.count(); i++) {
             integers[i] /= d;
             }
       }
 
-static void addInteger(int len)
+static void addInteger(IntVector& integers, int len)
       {
       if (!integers.contains(len)) {
             integers.append(len);
@@ -857,13 +856,13 @@ void ExportMusicXml::calcDivMoveToTick(int t)
 #ifdef DEBUG_TICK
             qDebug("backup %d", tick - t);
 #endif
-            addInteger(tick - t);
+            addInteger(integers, tick - t);
             }
       else if (t > tick) {
 #ifdef DEBUG_TICK
             qDebug("forward %d", t - tick);
 #endif
-            addInteger(t - tick);
+            addInteger(integers, t - tick);
             }
       tick = t;
       }
@@ -952,7 +951,7 @@ void ExportMusicXml::calcDivisions()
 #ifdef DEBUG_TICK
                                     qDebug("chordrest %d", l);
 #endif
-                                    addInteger(l);
+                                    addInteger(integers, l);
                                     tick += l;
                                     }
                               }
@@ -964,8 +963,8 @@ void ExportMusicXml::calcDivisions()
 
       // do it: divide by all primes as often as possible
       for (int u = 0; u < primes.count(); u++)
-            while (canDivideBy(primes[u]))
-                  divideBy(primes[u]);
+            while (canDivideBy(integers, primes[u]))
+                  divideBy(integers, primes[u]);
 
       div = MScore::division / integers[0];
 #ifdef DEBUG_TICK
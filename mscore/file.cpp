@@ -79,7 +79,6 @@
 #include "libmscore/sym.h"
 #include "libmscore/image.h"
 #include "synthesizer/msynthesizer.h"
-#include "svggenerator.h"
 
 #ifdef OMR
 #include "omr/omr.h"
@@ -109,24 +108,9 @@ extern Score::FileError importCapXml(Score*, const QString& name);
 extern Score::FileError readScore(Score* score, QString name, bool ignoreVersionError);
 
 extern bool savePositions(Score*, const QString& name);
+extern bool saveSvg(Score*, const QString& name, double dpi, int firstPage, int lastPage, bool parallel);
 extern MasterSynthesizer* synti;
 
-//---------------------------------------------------------
-//   paintElements
-//---------------------------------------------------------
-
-static void paintElements(QPainter& p, const QList<const Element*>& el)
-      {
-      foreach(const Element* e, el) {
-            if (!e->visible())
-                  continue;
-            QPointF pos(e->pagePos());
-            p.translate(pos);
-            e->draw(&p);
-            p.translate(-pos);
-            }
-      }
-
 //---------------------------------------------------------
 //   createDefaultFileName
 //---------------------------------------------------------
@@ -1539,6 +1523,18 @@ bool MuseScore::exportFile()
       return saveAs(cs, true, fn, ext);
       }
 
+//---------------------------------------------------------
+//   PartExport
+//---------------------------------------------------------
+
+struct PartExport {
+      Score* score;
+      QString path;
+      bool ok;
+      QString error;
+      qint64 elapsed;         // ms
+      };
+
 //---------------------------------------------------------
 //   exportParts
 //    return true on success
@@ -1594,6 +1590,7 @@ bool MuseScore::exportParts()
             thisScore = thisScore->parentScore();
       bool overwrite = false;
       bool noToAll = false;
+      QList<PartExport> jobs;
       foreach(Excerpt* e, thisScore->excerpts())  {
             Score* pScore = e->score();
             QString partfn = fi.absolutePath() + QDir::separator() + fi.baseName() + "-" + pScore->name() + "." + ext;
@@ -1620,14 +1617,131 @@ bool MuseScore::exportParts()
                         continue;
                   }
 
-            if (!saveAs(pScore, true, partfn, ext))
-                  return false;
+            jobs.append({ pScore, partfn, true, QString(), 0 });
+            }
+
+      //
+      // parts are independent scores: the file formats which
+      // only read the layout are written in parallel
+      //
+      bool parallel = jobs.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1
+         && (ext == "mscx" || ext == "mscz" || ext == "xml" || ext == "mxl"
+            || (ext == "pdf" && QFontDatabase::supportsThreadedFontRendering()));
+
+      QProgressBar* pBar = showProgressBar();
+      pBar->reset();
+      pBar->setRange(0, jobs.size());
+      QElapsedTimer total;
+      total.start();
+      if (parallel) {
+            auto exportPart = [this, ext](PartExport& job) {
+                  QElapsedTimer timer;
+                  timer.start();
+                  job.ok = savePart(job.score, job.path, ext, &job.error);
+                  job.elapsed = timer.elapsed();
+                  };
+            QFutureWatcher<void> watcher;
+            QEventLoop loop;
+            connect(&watcher, SIGNAL(progressValueChanged(int)), pBar, SLOT(setValue(int)));
+            connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+            watcher.setFuture(QtConcurrent::map(jobs, exportPart));
+            loop.exec(QEventLoop::ExcludeUserInputEvents);
+            }
+      else {
+            for (PartExport& job : jobs) {
+                  QElapsedTimer timer;
+                  timer.start();
+                  job.ok = saveAs(job.score, true, job.path, ext);
+                  job.elapsed = timer.elapsed();
+                  pBar->setValue(pBar->value() + 1);
+                  qApp->processEvents(QEventLoop::ExcludeUserInputEvents);
+                  if (!job.ok)
+                        break;
+                  }
+            }
+      hideProgressBar();
+
+      //
+      // timing report
+      //
+      QString report;
+      bool ok = true;
+      for (const PartExport& job : jobs) {
+            report += QString("%1: %2 s%3\n").arg(job.score->name()).arg(job.elapsed / 1000.0, 0, 'f', 2)
+               .arg(job.ok ? QString() : " " + tr("failed") + " " + job.error);
+            ok = ok && job.ok;
+            }
+      report += tr("Total: %1 s").arg(total.elapsed() / 1000.0, 0, 'f', 2);
+      if (MScore::debugMode)
+            qDebug("exportParts %s:\n%s", parallel ? "parallel" : "serial", qPrintable(report));
+      if (!ok) {
+            if (parallel) {
+                  QMessageBox msgBox(QMessageBox::Critical, tr("MuseScore: Export Parts"), tr("Export of parts failed"));
+                  msgBox.setDetailedText(report);
+                  msgBox.exec();
+                  }
+            return false;
+            }
+      if (!noToAll) {
+            QMessageBox msgBox(QMessageBox::Information, tr("MuseScore: Export Parts"), tr("Parts were successfully exported"));
+            msgBox.setDetailedText(report);
+            msgBox.exec();
             }
-      if(!noToAll)
-            QMessageBox::information(this, tr("MuseScore: Export Parts"), tr("Parts were successfully exported"));
       return true;
       }
 
+//---------------------------------------------------------
+//   savePart
+//    save a part without user interaction; called from
+//    worker threads by exportParts(), so errors are
+//    returned in error instead of MScore::lastError
+//---------------------------------------------------------
+
+bool MuseScore::savePart(Score* score, const QString& path, const QString& ext, QString* error)
+      {
+      if (ext == "pdf" || ext == "xml" || ext == "mxl") {
+            bool rv;
+            if (ext == "pdf")
+                  rv = savePdf(score, path);
+            else if (ext == "xml")
+                  rv = saveXml(score, path);
+            else
+                  rv = saveMxl(score, path);
+            if (!rv)
+                  *error = tr("Cannot write %1").arg(QDir::toNativeSeparators(path));
+            return rv;
+            }
+
+      bool rv = true;
+      QFileInfo fi(path);
+      // the score file name is used to resolve resources
+      QString originalScoreFName(score->absoluteFilePath());
+      score->fileInfo()->setFile(path);
+      try {
+            // open the file here, Score::saveFile() and strerror()
+            // are not safe to use from several threads
+            QFile fp(path);
+            if (fp.open(QIODevice::WriteOnly)) {
+                  if (ext == "mscz")
+                        score->saveCompressedFile(&fp, fi, false);
+                  else
+                        score->saveFile(&fp, false);
+                  fp.close();
+                  }
+            else {
+                  rv = false;
+                  *error = tr("Open File\n%1\nfailed: %2").arg(path).arg(fp.errorString());
+                  }
+            }
+      catch (QString s) {
+            rv = false;
+            *error = s;
+            }
+      score->fileInfo()->setFile(originalScoreFName);
+      return rv;
+      }
+
+
 //---------------------------------------------------------
 //   saveAs
 //---------------------------------------------------------
@@ -2039,7 +2153,8 @@ void MuseScore::addImage(Score* score, Element* e)
 
 bool MuseScore::savePng(Score* score, const QString& name)
       {
-      return savePng(score, name, false, true, converterDpi, QImage::Format_ARGB32_Premultiplied );
+      return savePng(score, name, false, true, converterDpis.isEmpty() ? QList<double>() << converterDpi : converterDpis,
+         QImage::Format_ARGB32_Premultiplied, converterFirstPage, converterLastPage);
       }
 
 //---------------------------------------------------------
@@ -2049,91 +2164,139 @@ bool MuseScore::savePng(Score* score, const QString& name)
 
 bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool transparent, double convDpi, QImage::Format format)
       {
-      bool rv = true;
-      score->setPrinting(!screenshot);    // dont print page break symbols etc.
-
-      QImage::Format f;
-      if (format != QImage::Format_Indexed8)
-          f = format;
-      else
-          f = QImage::Format_ARGB32_Premultiplied;
+      return savePng(score, name, screenshot, transparent, QList<double>() << convDpi, format, 0, -1);
+      }
 
-      const QList<Page*>& pl = score->pages();
-      int pages = pl.size();
+//---------------------------------------------------------
+//   PngImage
+//    one page at one resolution
+//---------------------------------------------------------
 
-      int padding = QString("%1").arg(pages).size();
-      bool overwrite = false;
-      bool noToAll = false;
-      for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
-            Page* page = pl.at(pageNumber);
+struct PngImage {
+      double dpi;
+      QString path;
+      bool ok;
+      };
 
-            QRectF r = page->abbox();
-            int w = lrint(r.width()  * convDpi / MScore::DPI);
-            int h = lrint(r.height() * convDpi / MScore::DPI);
+//---------------------------------------------------------
+//   PngPage
+//    all images of one page; the resolutions of a page
+//    are rendered one after the other so that no element
+//    is drawn by two threads at once
+//---------------------------------------------------------
 
-            QImage printer(w, h, f);
-            printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
-            printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
+struct PngPage {
+      Page* page;
+      QList<const Element*> elements;
+      QList<PngImage> images;
+      };
 
-            printer.fill(transparent ? 0 : 0xffffffff);
+//---------------------------------------------------------
+//   savePng with page range and resolutions
+//    pages firstPage..lastPage (0 based, -1 is the last page)
+//    are written once for every resolution; all questions
+//    are asked first, then the images are rasterized and
+//    encoded in parallel; a range without a page of the
+//    score is an error
+//---------------------------------------------------------
 
-            double mag = convDpi / MScore::DPI;
-            QPainter p(&printer);
+bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool transparent,
+   const QList<double>& dpis, QImage::Format format, int firstPage, int lastPage)
+      {
+      const QList<Page*>& pl = score->pages();
+      int pages = pl.size();
+      if (lastPage < 0 || lastPage >= pages)
+            lastPage = pages - 1;
+      if (firstPage < 0)
+            firstPage = 0;
+      if (firstPage > lastPage) {
+            qDebug("savePng: no page %d-%d in a score of %d pages", firstPage + 1, lastPage + 1, pages);
+            return false;
+            }
 
-            p.setRenderHint(QPainter::Antialiasing, true);
-            p.setRenderHint(QPainter::TextAntialiasing, true);
-            p.scale(mag, mag);
+      score->setPrinting(!screenshot);    // dont print page break symbols etc.
 
-            paintElements(p, page->elements());
+      QString baseName(name);
+      if (baseName.endsWith(".png"))
+            baseName = baseName.left(baseName.size() - 4);
 
-            if (format == QImage::Format_Indexed8) {
-                  //convert to grayscale & respect alpha
-                  QVector<QRgb> colorTable;
-                  colorTable.push_back(QColor(0, 0, 0, 0).rgba());
-                  if (!transparent) {
-                        for (int i = 1; i < 256; i++)
-                              colorTable.push_back(QColor(i, i, i).rgb());
-                        }
-                  else {
-                        for (int i = 1; i < 256; i++)
-                              colorTable.push_back(QColor(0, 0, 0, i).rgba());
+      int padding = QString("%1").arg(pages).size();
+      bool overwrite = false;
+      bool noToAll = false;
+      QVector<PngPage> jobs;
+      for (int pageNumber = firstPage; pageNumber <= lastPage; ++pageNumber) {
+            PngPage job;
+            job.page = pl.at(pageNumber);
+            for (double dpi : dpis) {
+                  QString fileName = baseName + QString("-%1").arg(pageNumber+1, padding, 10, QLatin1Char('0'));
+                  if (dpis.size() > 1)
+                        fileName += QString("-%1dpi").arg(dpi);
+                  fileName += ".png";
+                  if (!converterMode) {
+                        QFileInfo fip(fileName);
+                        if(fip.exists() && !overwrite) {
+                              if(noToAll)
+                                    continue;
+                              QMessageBox msgBox( QMessageBox::Question, tr("Confirm Replace"),
+                                    tr("\"%1\" already exists.\nDo you want to replace it?\n").arg(QDir::toNativeSeparators(fileName)),
+                                    QMessageBox::Yes |  QMessageBox::YesToAll | QMessageBox::No |  QMessageBox::NoToAll);
+                              msgBox.setButtonText(QMessageBox::Yes, tr("Replace"));
+                              msgBox.setButtonText(QMessageBox::No, tr("Skip"));
+                              msgBox.setButtonText(QMessageBox::YesToAll, tr("Replace All"));
+                              msgBox.setButtonText(QMessageBox::NoToAll, tr("Skip All"));
+                              int sb = msgBox.exec();
+                              if(sb == QMessageBox::YesToAll) {
+                                    overwrite = true;
+                                    }
+                              else if (sb == QMessageBox::NoToAll) {
+                                    noToAll = true;
+                                    continue;
+                                    }
+                              else if (sb == QMessageBox::No)
+                                    continue;
+                              }
                         }
-                  printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
+                  job.images.append({ dpi, fileName, false });
                   }
+            if (!job.images.isEmpty()) {
+                  job.elements = job.page->elements();
+                  jobs.append(job);
+                  }
+            }
 
-            QString fileName(name);
-            if (fileName.endsWith(".png"))
-                  fileName = fileName.left(fileName.size() - 4);
-            fileName += QString("-%1.png").arg(pageNumber+1, padding, 10, QLatin1Char('0'));
-            if (!converterMode) {
-                  QFileInfo fip(fileName);
-                  if(fip.exists() && !overwrite) {
-                        if(noToAll)
-                              continue;
-                        QMessageBox msgBox( QMessageBox::Question, tr("Confirm Replace"),
-                              tr("\"%1\" already exists.\nDo you want to replace it?\n").arg(QDir::toNativeSeparators(fileName)),
-                              QMessageBox::Yes |  QMessageBox::YesToAll | QMessageBox::No |  QMessageBox::NoToAll);
-                        msgBox.setButtonText(QMessageBox::Yes, tr("Replace"));
-                        msgBox.setButtonText(QMessageBox::No, tr("Skip"));
-                        msgBox.setButtonText(QMessageBox::YesToAll, tr("Replace All"));
-                        msgBox.setButtonText(QMessageBox::NoToAll, tr("Skip All"));
-                        int sb = msgBox.exec();
-                        if(sb == QMessageBox::YesToAll) {
-                              overwrite = true;
-                              }
-                        else if (sb == QMessageBox::NoToAll) {
-                              noToAll = true;
-                              continue;
-                              }
-                        else if (sb == QMessageBox::No)
-                              continue;
+      auto savePage = [transparent, format](PngPage& job) {
+            for (PngImage& image : job.images) {
+                  QImage printer = job.page->render(job.elements, image.dpi, transparent, format);
+                  image.ok = printer.save(image.path, "png");
+                  if (!image.ok)
+                        break;
+                  }
+            };
+      if (jobs.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1
+         && QFontDatabase::supportsThreadedFontRendering()) {
+            QtConcurrent::blockingMap(jobs, savePage);
+            }
+      else {
+            for (PngPage& job : jobs) {
+                  savePage(job);
+                  if (!job.images.last().ok)
+                        break;
+                  }
+            }
+
+      bool rv = true;
+      for (const PngPage& job : jobs) {
+            for (const PngImage& image : job.images) {
+                  if (!image.ok) {
+                        qDebug("savePng: cannot write <%s>", qPrintable(image.path));
+                        rv = false;
+                        break;
                         }
                   }
-            rv = printer.save(fileName, "png");
             if (!rv)
                   break;
             }
-      cs->setPrinting(false);
+      score->setPrinting(false);
       return rv;
       }
 
@@ -2233,41 +2396,14 @@ QString MuseScore::getWallpaper(const QString& caption)
 
 //---------------------------------------------------------
 //   saveSvg
+//    with a page range (-P) every page is written to a
+//    file of its own
 //---------------------------------------------------------
 
 bool MuseScore::saveSvg(Score* score, const QString& saveName)
       {
-      SvgGenerator printer;
-      printer.setResolution(converterDpi);
-      QString title(score->metaTag("workTitle"));
-      if(title.isEmpty())
-            title = "MuseScore";
-      printer.setTitle(title);
-      printer.setDescription(QString("Generated by MuseScore %1").arg(VERSION));
-      printer.setFileName(saveName);
-      const PageFormat* pf = cs->pageFormat();
-      double mag = converterDpi / MScore::DPI;
-
-      qreal w = pf->width() * MScore::DPI * score->pages().size();
-      qreal h = pf->height() * MScore::DPI;
-      printer.setSize(QSize(w * mag, h * mag));
-      printer.setViewBox(QRectF(0.0, 0.0, w * mag, h * mag));
-
-      score->setPrinting(true);
-
-      QPainter p(&printer);
-      p.setRenderHint(QPainter::Antialiasing, true);
-      p.setRenderHint(QPainter::TextAntialiasing, true);
-      p.scale(mag, mag);
-
-      foreach (Page* page, score->pages()) {
-            paintElements(p, page->elements());
-            p.translate(QPointF(pf->width() * MScore::DPI, 0.0));
-            }
-
-      score->setPrinting(false);
-      p.end();
-      return true;
+      return Ms::saveSvg(score, saveName, converterDpi, converterFirstPage, converterLastPage,
+         QThreadPool::globalInstance()->maxThreadCount() > 1);
       }
 
 }
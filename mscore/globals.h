@@ -32,6 +32,9 @@ extern bool midiOutputTrace;  ///< debug option: dump midi output
 extern bool noGui;
 extern bool converterMode;
 extern double converterDpi;
+extern QList<double> converterDpis;   ///< all resolutions of "-r dpi,dpi,..."
+extern int converterFirstPage;        ///< png page range of "-P first-last", 0 based
+extern int converterLastPage;
 
 //---------------------------------------------------------
 //    ScoreState
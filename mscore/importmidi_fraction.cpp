@@ -81,17 +81,20 @@ namespace {
 
 int gcd(int a, int b)
       {
+      while (b != 0) {
 
-      Q_ASSERT_X(!isUnaryNegationOverflow(a),
-                 "ReducedFraction, gcd", "Unary negation overflow");
+            Q_ASSERT_X(!isRemainderOverflow(a, b),
+                       "ReducedFraction, gcd", "Remainder overflow");
 
-      if (b == 0)
-            return a < 0 ? -a : a;
+            const int tmp = a % b;
+            a = b;
+            b = tmp;
+            }
 
-      Q_ASSERT_X(!isRemainderOverflow(a, b),
-                 "ReducedFraction, gcd", "Remainder overflow");
+      Q_ASSERT_X(!isUnaryNegationOverflow(a),
+                 "ReducedFraction, gcd", "Unary negation overflow");
 
-      return gcd(b, a % b);
+      return a < 0 ? -a : a;
       }
 
 // least common multiple
@@ -212,11 +215,26 @@ int fractionPart(int lcmPart, int numerator, int denominator)
       return numerator * part;
       }
 
+// helper function: fractions are compared by cross multiplication,
+// the product of two ints always fits into 64 bits
+// so neither lcm nor gcd is needed
+
+inline qint64 crossProduct(int numerator, int denominator)
+      {
+      return qint64(numerator) * denominator;
+      }
+
 ReducedFraction& ReducedFraction::operator+=(const ReducedFraction& val)
       {
       preventOverflow();
-      ReducedFraction value = val;
-      value.preventOverflow();
+      if (denominator_ == val.denominator_) {
+
+            Q_ASSERT_X(!isAdditionOverflow(numerator_, val.numerator_),
+                       "ReducedFraction::operator+=", "Addition overflow");
+
+            numerator_ += val.numerator_;
+            return *this;
+            }
 
       const int tmp = lcm(denominator_, val.denominator_);
       numerator_ = fractionPart(tmp, numerator_, denominator_)
@@ -228,8 +246,14 @@ ReducedFraction& ReducedFraction::operator+=(const ReducedFraction& val)
 ReducedFraction& ReducedFraction::operator-=(const ReducedFraction& val)
       {
       preventOverflow();
-      ReducedFraction value = val;
-      value.preventOverflow();
+      if (denominator_ == val.denominator_) {
+
+            Q_ASSERT_X(!isSubtractionOverflow(numerator_, val.numerator_),
+                       "ReducedFraction::operator-=", "Subtraction overflow");
+
+            numerator_ -= val.numerator_;
+            return *this;
+            }
 
       const int tmp = lcm(denominator_, val.denominator_);
       numerator_ = fractionPart(tmp, numerator_, denominator_)
@@ -241,8 +265,6 @@ ReducedFraction& ReducedFraction::operator-=(const ReducedFraction& val)
 ReducedFraction& ReducedFraction::operator*=(const ReducedFraction& val)
       {
       preventOverflow();
-      ReducedFraction value = val;
-      value.preventOverflow();
 
       Q_ASSERT_X(!isMultiplicationOverflow(numerator_, val.numerator_),
                  "ReducedFraction::operator*=", "Multiplication overflow");
@@ -268,8 +290,6 @@ ReducedFraction& ReducedFraction::operator*=(int val)
 ReducedFraction& ReducedFraction::operator/=(const ReducedFraction& val)
       {
       preventOverflow();
-      ReducedFraction value = val;
-      value.preventOverflow();
 
       Q_ASSERT_X(!isMultiplicationOverflow(numerator_, val.denominator_),
                  "ReducedFraction::operator/=", "Multiplication overflow");
@@ -294,44 +314,38 @@ ReducedFraction& ReducedFraction::operator/=(int val)
 
 bool ReducedFraction::operator<(const ReducedFraction& val) const
       {
-      const int v = lcm(denominator_, val.denominator_);
-      return fractionPart(v, numerator_, denominator_)
-                  < fractionPart(v, val.numerator_, val.denominator_);
+      return crossProduct(numerator_, val.denominator_)
+                  < crossProduct(val.numerator_, denominator_);
       }
 
 bool ReducedFraction::operator<=(const ReducedFraction& val) const
       {
-      const int v = lcm(denominator_, val.denominator_);
-      return fractionPart(v, numerator_, denominator_)
-                  <= fractionPart(v, val.numerator_, val.denominator_);
+      return crossProduct(numerator_, val.denominator_)
+                  <= crossProduct(val.numerator_, denominator_);
       }
 
 bool ReducedFraction::operator>(const ReducedFraction& val) const
       {
-      const int v = lcm(denominator_, val.denominator_);
-      return fractionPart(v, numerator_, denominator_)
-                  > fractionPart(v, val.numerator_, val.denominator_);
+      return crossProduct(numerator_, val.denominator_)
+                  > crossProduct(val.numerator_, denominator_);
       }
 
 bool ReducedFraction::operator>=(const ReducedFraction& val) const
       {
-      const int v = lcm(denominator_, val.denominator_);
-      return fractionPart(v, numerator_, denominator_)
-                  >= fractionPart(v, val.numerator_, val.denominator_);
+      return crossProduct(numerator_, val.denominator_)
+                  >= crossProduct(val.numerator_, denominator_);
       }
 
 bool ReducedFraction::operator==(const ReducedFraction& val) const
       {
-      const int v = lcm(denominator_, val.denominator_);
-      return fractionPart(v, numerator_, denominator_)
-                  == fractionPart(v, val.numerator_, val.denominator_);
+      return crossProduct(numerator_, val.denominator_)
+                  == crossProduct(val.numerator_, denominator_);
       }
 
 bool ReducedFraction::operator!=(const ReducedFraction& val) const
       {
-      const int v = lcm(denominator_, val.denominator_);
-      return fractionPart(v, numerator_, denominator_)
-                  != fractionPart(v, val.numerator_, val.denominator_);
+      return crossProduct(numerator_, val.denominator_)
+                  != crossProduct(val.numerator_, denominator_);
       }
 
 
@@ -566,15 +566,50 @@ bool isInCommonIndexes(
       return false;
       }
 
+// chords of the tuplet candidates are numbered once per bar
+// and regular quantization errors of all tuplet chords are found once,
+// so the error of every tested tuplet combination is a sum over arrays
+
+struct TupletChordIndex
+      {
+      std::vector<std::vector<int>> chords;                       // chord numbers of each tuplet
+      std::vector<std::vector<ReducedFraction>> regularErrors;    // errors of each tuplet chord
+      int chordCount = 0;
+      };
+
+TupletChordIndex findTupletChordIndex(const std::vector<TupletInfo> &tuplets)
+      {
+      TupletChordIndex index;
+      index.chords.resize(tuplets.size());
+      index.regularErrors.resize(tuplets.size());
+                  // <chord address, chord number>
+      std::map<std::pair<const ReducedFraction, MidiChord> *, int> numbers;
+
+      for (size_t i = 0; i != tuplets.size(); ++i) {
+            const auto &tuplet = tuplets[i];
+            for (const auto &chord: tuplet.chords) {
+                  const int number = numbers.size();
+                  const auto it = numbers.insert({&*chord.second, number}).first;
+                  index.chords[i].push_back(it->second);
+                  index.regularErrors[i].push_back(
+                              findQuantizationError(chord.first, tuplet.regularQuant));
+                  }
+            }
+      index.chordCount = numbers.size();
+
+      return index;
+      }
+
 TupletErrorResult findTupletError(const std::vector<int> &tupletIndexes,
                                   const std::vector<TupletInfo> &tuplets,
+                                  const TupletChordIndex &chordIndex,
                                   size_t voiceCount)
       {
       ReducedFraction sumError{0, 1};
       ReducedFraction sumLengthOfRests{0, 1};
       int sumChordCount = 0;
       int sumChordPlaces = 0;
-      std::set<std::pair<const ReducedFraction, MidiChord> *> usedChords;
+      std::vector<char> usedChords(chordIndex.chordCount, 0);
       std::vector<char> usedIndexes(tuplets.size(), 0);
 
       for (int i: tupletIndexes) {
@@ -586,18 +621,18 @@ TupletErrorResult findTupletError(const std::vector<int> &tupletIndexes,
             sumChordPlaces += tuplet.tupletNumber;
 
             usedIndexes[i] = 1;
-            for (const auto &chord: tuplet.chords)
-                  usedChords.insert(&*chord.second);
+            for (int chord: chordIndex.chords[i])
+                  usedChords[chord] = 1;
             }
                   // add quant error of all chords excluded from tuplets
       for (size_t i = 0; i != tuplets.size(); ++i) {
             if (usedIndexes[i])
                   continue;
-            const auto &tuplet = tuplets[i];
-            for (const auto &chord: tuplet.chords) {
-                  if (usedChords.find(&*chord.second) != usedChords.end())
+            const auto &chords = chordIndex.chords[i];
+            for (size_t k = 0; k != chords.size(); ++k) {
+                  if (usedChords[chords[k]])
                         continue;
-                  sumError += findQuantizationError(chord.first, tuplet.regularQuant);
+                  sumError += chordIndex.regularErrors[i][k];
                   }
             }
 
@@ -726,10 +761,11 @@ void tryUpdateBestIndexes(
             TupletErrorResult &minCurrentError,
             const std::vector<int> &selectedTuplets,
             const std::vector<TupletInfo> &tuplets,
+            const TupletChordIndex &chordIndex,
             const std::map<int, std::vector<std::pair<ReducedFraction, ReducedFraction>>> &voiceIntervals)
       {
       const size_t voiceCount = voiceIntervals.size();
-      const auto error = findTupletError(selectedTuplets, tuplets, voiceCount);
+      const auto error = findTupletError(selectedTuplets, tuplets, chordIndex, voiceCount);
       if (!minCurrentError.isInitialized() || error < minCurrentError) {
             minCurrentError = error;
             bestTupletIndexes = selectedTuplets;
@@ -826,6 +862,7 @@ void findNextTuplet(
             TupletErrorResult &minCurrentError,
             const std::vector<TupletCommon> &tupletCommons,
             const std::vector<TupletInfo> &tuplets,
+            const TupletChordIndex &chordIndex,
             const std::vector<std::pair<ReducedFraction, ReducedFraction> > &tupletIntervals,
             size_t commonsSize)
       {
@@ -860,7 +897,7 @@ void findNextTuplet(
                         }
                   if (!canAddMoreIndexes) {
                         tryUpdateBestIndexes(bestTupletIndexes, minCurrentError,
-                                             selectedTuplets, tuplets, voiceIntervals);
+                                             selectedTuplets, tuplets, chordIndex, voiceIntervals);
                         }
                   return;
                   }
@@ -896,12 +933,12 @@ void findNextTuplet(
                         }
                   if (!canAddMoreIndexes) {
                         tryUpdateBestIndexes(bestTupletIndexes, minCurrentError,
-                                             selectedTuplets, tuplets, voiceIntervals);
+                                             selectedTuplets, tuplets, chordIndex, voiceIntervals);
                         }
                   }
             else {
                   findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                                 tupletCommons, tuplets, tupletIntervals, commonsSize);
+                                 tupletCommons, tuplets, chordIndex, tupletIntervals, commonsSize);
                   }
 
             selectedTuplets.pop_back();
@@ -935,11 +972,12 @@ std::vector<int> findBestTuplets(
       std::vector<int> selectedTuplets;
       TupletErrorResult minCurrentError;
       const auto tupletIntervals = findTupletIntervals(tuplets);
+      const auto chordIndex = findTupletChordIndex(tuplets);
 
       ValidTuplets validTuplets(tuplets.size());
 
       findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                     tupletCommons, tuplets, tupletIntervals, commonsSize);
+                     tupletCommons, tuplets, chordIndex, tupletIntervals, commonsSize);
 
       return bestTupletIndexes;
       }
@@ -120,6 +120,9 @@ bool externalIcons = false;
 static bool pluginMode = false;
 static bool startWithNewScore = false;
 double converterDpi = 0;
+QList<double> converterDpis;
+int converterFirstPage = 0;
+int converterLastPage = -1;
 
 QString mscoreGlobalShare;
 static QStringList recentScores;
@@ -127,6 +130,7 @@ static QString outFileName;
 static QString audioDriver;
 static QString pluginName;
 static QString styleFile;
+static QString jobFile;
 QString localeName;
 bool useFactorySettings = false;
 bool deletePreferences = false;
@@ -1403,7 +1407,11 @@ static void usage()
         "   -I        dump midi input\n"
         "   -O        dump midi output\n"
         "   -o file   export to 'file'; format depends on file extension\n"
+        "   -j file   process a conversion job file (json)\n"
         "   -r dpi    set output resolution for image export\n"
+        "             png export accepts a list: -r 72,300\n"
+        "   -P pages  export only page 'n' or pages 'n-m' to png,\n"
+        "             to one svg file per page\n"
         "   -S style  load style file\n"
         "   -p name   execute named plugin\n"
         "   -F        use factory settings\n"
@@ -2158,22 +2166,280 @@ static void loadScores(const QStringList& argv)
       mscore->setCurrentView(1, currentScoreView);
       }
 
+//---------------------------------------------------------
+//   convert
+//    export score to file fn; the format depends on the
+//    file extension
+//---------------------------------------------------------
+
+static bool convert(Score* cs, const QString& fn)
+      {
+      if (fn.endsWith(".mscx")) {
+            QFileInfo fi(fn);
+            try {
+                  cs->saveFile(fi);
+                  }
+            catch(QString) {
+                  return false;
+                  }
+            return true;
+            }
+      if (fn.endsWith(".mscz")) {
+            QFileInfo fi(fn);
+            try {
+                  cs->saveCompressedFile(fi, false);
+                  }
+            catch(QString) {
+                  return false;
+                  }
+            return true;
+            }
+      if (fn.endsWith(".xml"))
+            return saveXml(cs, fn);
+      if (fn.endsWith(".mxl"))
+            return saveMxl(cs, fn);
+      if (fn.endsWith(".mid"))
+            return mscore->saveMidi(cs, fn);
+      if (fn.endsWith(".pdf"))
+            return mscore->savePdf(cs, fn);
+      if (fn.endsWith(".png"))
+            return mscore->savePng(cs, fn);
+      if (fn.endsWith(".svg"))
+            return mscore->saveSvg(cs, fn);
+//      if (fn.endsWith(".ly"))
+//            return mscore->saveLilypond(cs, fn);
+#ifdef HAS_AUDIOFILE
+      if (fn.endsWith(".wav"))
+            return mscore->saveAudio(cs, fn, "wav");
+      if (fn.endsWith(".ogg"))
+            return mscore->saveAudio(cs, fn, "ogg");
+      if (fn.endsWith(".flac"))
+            return mscore->saveAudio(cs, fn, "flac");
+#endif
+      if (fn.endsWith(".mp3"))
+            return mscore->saveMp3(cs, fn);
+      if (fn.endsWith(".pos"))
+            return savePositions(cs, fn);
+      qDebug("dont know how to convert to %s", qPrintable(fn));
+      return false;
+      }
+
+//---------------------------------------------------------
+//   loadStyleFile
+//---------------------------------------------------------
+
+static void loadStyleFile(Score* cs)
+      {
+      if (styleFile.isEmpty())
+            return;
+      QFile f(styleFile);
+      if (f.open(QIODevice::ReadOnly))
+            cs->style()->load(&f);
+      }
+
+//---------------------------------------------------------
+//   JobOutput
+//    one output file of a job file entry
+//---------------------------------------------------------
+
+struct JobOutput {
+      QString file;
+      bool threaded;          // written by a worker thread
+      bool ok;
+      double time;
+      QString error;
+      };
+
+//---------------------------------------------------------
+//   ConversionJob
+//    one entry of a job file
+//---------------------------------------------------------
+
+struct ConversionJob {
+      QString in;
+      Score* score;
+      double loadTime;
+      QList<JobOutput> out;
+      QFuture<void> exports;  // threaded outputs
+      };
+
+//---------------------------------------------------------
+//   threadedExport
+//    the formats savePart() writes from worker threads,
+//    the same set exportParts() writes in parallel
+//---------------------------------------------------------
+
+static bool threadedExport(const QString& fn)
+      {
+      return fn.endsWith(".mscx") || fn.endsWith(".mscz") || fn.endsWith(".xml") || fn.endsWith(".mxl")
+         || (fn.endsWith(".pdf") && QFontDatabase::supportsThreadedFontRendering());
+      }
+
+//---------------------------------------------------------
+//   finishJob
+//    wait for the threaded outputs of job and free
+//    its score
+//---------------------------------------------------------
+
+static void finishJob(ConversionJob& job)
+      {
+      job.exports.waitForFinished();
+      delete job.score;
+      job.score = 0;
+      }
+
+//---------------------------------------------------------
+//   processJobFile
+//    run all conversions of a job file in this process,
+//    so fonts, styles, instrument templates and the
+//    synthesizer are set up only once. A job file is a json
+//    array of jobs:
+//          [ { "in": "a.mscz", "out": "a.pdf" },
+//            { "in": "b.mscx", "out": [ "b.pdf", "b.mid" ] } ]
+//    Scores are read and laid out one after the other in
+//    this thread, reading touches global state. Every
+//    score is independent after layout: its score files,
+//    MusicXML and pdf (with threaded font rendering) are
+//    written by savePart() on a worker thread while the
+//    next scores are read. Only as many scores as there are
+//    workers are kept in memory. The other formats use
+//    the synthesizer or QPixmap and are written here.
+//    A report with status and timing of every job is
+//    written to stdout as json. A page range (-P) does not
+//    apply to the jobs, they export all pages.
+//    return false if any job failed
+//---------------------------------------------------------
+
+static bool processJobFile(const QString& path)
+      {
+      if (converterLastPage >= 0) {
+            qDebug("page range -P is ignored for job file <%s>", qPrintable(path));
+            converterFirstPage = 0;
+            converterLastPage  = -1;
+            }
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly)) {
+            qDebug("cannot open job file <%s>", qPrintable(path));
+            return false;
+            }
+      QJsonParseError pe;
+      QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &pe);
+      f.close();
+      if (pe.error != QJsonParseError::NoError || !doc.isArray()) {
+            qDebug("bad job file <%s>: %s", qPrintable(path), qPrintable(pe.errorString()));
+            return false;
+            }
+
+      int workers   = QThreadPool::globalInstance()->maxThreadCount();
+      bool parallel = workers > 1;
+
+      QList<ConversionJob> jobs;
+      for (const QJsonValue& v : doc.array()) {
+            QJsonObject o = v.toObject();
+            ConversionJob job;
+            job.in       = o.value("in").toString();
+            job.score    = 0;
+            job.loadTime = 0.0;
+            QStringList outFiles;
+            QJsonValue out = o.value("out");
+            if (out.isArray()) {
+                  for (const QJsonValue& fn : out.toArray())
+                        outFiles.append(fn.toString());
+                  }
+            else
+                  outFiles.append(out.toString());
+            for (const QString& fn : outFiles)
+                  job.out.append({ fn, parallel && threadedExport(fn), false, 0.0, QString() });
+            jobs.append(job);
+            }
+
+      QElapsedTimer timer;
+      for (int i = 0; i < jobs.size(); ++i) {
+            if (i >= workers)
+                  finishJob(jobs[i - workers]);
+            ConversionJob* job = &jobs[i];
+            timer.start();
+            job->score = mscore->readScore(job->in);
+            job->loadTime = double(timer.elapsed()) / 1000.0;
+            if (!job->score) {
+                  for (JobOutput& o : job->out)
+                        o.error = MuseScore::tr("Cannot read file %1").arg(job->in);
+                  continue;
+                  }
+            loadStyleFile(job->score);
+
+            bool threaded = false;
+            for (JobOutput& o : job->out) {
+                  if (o.threaded) {
+                        threaded = true;
+                        continue;
+                        }
+                  timer.start();
+                  o.ok   = convert(job->score, o.file);
+                  o.time = double(timer.elapsed()) / 1000.0;
+                  if (!o.ok)
+                        o.error = MuseScore::tr("Cannot write %1").arg(o.file);
+                  }
+            if (threaded) {
+                  job->exports = QtConcurrent::run([job] {
+                        for (JobOutput& o : job->out) {
+                              if (!o.threaded)
+                                    continue;
+                              QElapsedTimer t;
+                              t.start();
+                              o.ok   = mscore->savePart(job->score, o.file, QFileInfo(o.file).suffix(), &o.error);
+                              o.time = double(t.elapsed()) / 1000.0;
+                              }
+                        });
+                  }
+            else
+                  finishJob(*job);
+            }
+      for (ConversionJob& job : jobs)
+            finishJob(job);
+
+      bool result = true;
+      QJsonArray report;
+      for (const ConversionJob& job : jobs) {
+            QJsonObject jobReport;
+            jobReport.insert("in", job.in);
+            jobReport.insert("loadTime", job.loadTime);
+            bool ok = true;
+            QJsonArray outReport;
+            for (const JobOutput& o : job.out) {
+                  QJsonObject r;
+                  r.insert("file", o.file);
+                  r.insert("ok", o.ok);
+                  r.insert("time", o.time);
+                  if (!o.error.isEmpty())
+                        r.insert("error", o.error);
+                  outReport.append(r);
+                  ok = ok && o.ok;
+                  }
+            jobReport.insert("out", outReport);
+            jobReport.insert("ok", ok);
+            report.append(jobReport);
+            result = result && ok;
+            }
+      QTextStream(stdout) << QJsonDocument(report).toJson();
+      return result;
+      }
+
 //---------------------------------------------------------
 //   processNonGui
 //---------------------------------------------------------
 
 static bool processNonGui()
       {
+      if (!jobFile.isEmpty())
+            return processJobFile(jobFile);
+
       if (pluginMode) {
             QString pn(pluginName);
             bool res = false;
             if (mscore->loadPlugin(pn)){
                   Score* cs = mscore->currentScore();
-                  if (!styleFile.isEmpty()) {
-                        QFile f(styleFile);
-                        if (f.open(QIODevice::ReadOnly))
-                              cs->style()->load(&f);
-                        }
+                  loadStyleFile(cs);
                   cs->startCmd();
                   cs->setLayoutAll(true);
                   cs->endCmd();
@@ -2185,64 +2451,9 @@ static bool processNonGui()
             }
 
       if (converterMode) {
-            QString fn(outFileName);
             Score* cs = mscore->currentScore();
-            if (!styleFile.isEmpty()) {
-                  QFile f(styleFile);
-                  if (f.open(QIODevice::ReadOnly)) {
-                        cs->style()->load(&f);
-                        }
-                  }
-            if (fn.endsWith(".mscx")) {
-                  QFileInfo fi(fn);
-                  try {
-                        cs->saveFile(fi);
-                        }
-                  catch(QString) {
-                        return false;
-                        }
-                  return true;
-                  }
-            if (fn.endsWith(".mscz")) {
-                  QFileInfo fi(fn);
-                  try {
-                        cs->saveCompressedFile(fi, false);
-                        }
-                  catch(QString) {
-                        return false;
-                        }
-                  return true;
-                  }
-            if (fn.endsWith(".xml"))
-                  return saveXml(cs, fn);
-            if (fn.endsWith(".mxl"))
-                  return saveMxl(cs, fn);
-            if (fn.endsWith(".mid"))
-                  return mscore->saveMidi(cs, fn);
-            if (fn.endsWith(".pdf"))
-                  return mscore->savePdf(fn);
-            if (fn.endsWith(".png"))
-                  return mscore->savePng(cs, fn);
-            if (fn.endsWith(".svg"))
-                  return mscore->saveSvg(cs, fn);
-//            if (fn.endsWith(".ly"))
-//                  return mscore->saveLilypond(cs, fn);
-#ifdef HAS_AUDIOFILE
-            if (fn.endsWith(".wav"))
-                  return mscore->saveAudio(cs, fn, "wav");
-            if (fn.endsWith(".ogg"))
-                  return mscore->saveAudio(cs, fn, "ogg");
-            if (fn.endsWith(".flac"))
-                  return mscore->saveAudio(cs, fn, "flac");
-#endif
-            if (fn.endsWith(".mp3"))
-                  return mscore->saveMp3(cs, fn);
-            if (fn.endsWith(".pos"))
-                  return savePositions(cs, fn);
-            else {
-                  qDebug("dont know how to convert to %s", qPrintable(outFileName));
-                  return false;
-                  }
+            loadStyleFile(cs);
+            return convert(cs, outFileName);
             }
       return true;
       }
@@ -4440,7 +4651,7 @@ void MuseScore::switchLayoutMode(int val)
                   cs->setLayoutMode(LayoutMode::LINE);
             cs->doLayout();
             cs->setUpdateAll(true);
-            cv->update();
+            cv->updateAll();
             cv->loopUpdate(getAction("loop")->isChecked());
             }
       }
@@ -4625,6 +4836,13 @@ int main(int argc, char* av[])
                               usage();
                         outFileName = argv.takeAt(i + 1);
                         break;
+                  case 'j':
+                        converterMode = true;
+                        MScore::noGui = true;
+                        if (argv.size() - i < 2)
+                              usage();
+                        jobFile = argv.takeAt(i + 1);
+                        break;
                   case 'p':
                         pluginMode = true;
                         MScore::noGui = true;
@@ -4635,7 +4853,22 @@ int main(int argc, char* av[])
                   case 'r':
                         if (argv.size() - i < 2)
                               usage();
-                        converterDpi = argv.takeAt(i + 1).toDouble();
+                        foreach (const QString& dpi, argv.takeAt(i + 1).split(','))
+                              converterDpis.append(dpi.toDouble());
+                        converterDpi = converterDpis.first();
+                        break;
+                  case 'P':
+                        {
+                        if (argv.size() - i < 2)
+                              usage();
+                        QStringList range = argv.takeAt(i + 1).split('-');
+                        bool ok1, ok2;
+                        converterFirstPage = range.first().toInt(&ok1) - 1;
+                        converterLastPage  = range.last().toInt(&ok2) - 1;
+                        if (!ok1 || !ok2 || range.size() > 2 || converterFirstPage < 0
+                           || converterFirstPage > converterLastPage)
+                              usage();
+                        }
                         break;
                   case 'S':
                         if (argv.size() - i < 2)
@@ -4927,7 +5160,8 @@ int main(int argc, char* av[])
 
       int files = 0;
       if (MScore::noGui) {
-            loadScores(argv);
+            if (jobFile.isEmpty())
+                  loadScores(argv);
             exit(processNonGui() ? 0 : -1);
             }
       else {
@@ -580,6 +580,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool exportFile();
       bool exportParts();
       bool saveAs(Score*, bool saveCopy, const QString& path, const QString& ext);
+      bool savePart(Score*, const QString& path, const QString& ext, QString* error);
       bool savePdf(const QString& saveName);
       bool savePdf(Score* cs, const QString& saveName);
 
@@ -590,6 +591,9 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       void addImage(Score*, Element*);
 
       bool savePng(Score*, const QString& name, bool screenshot, bool transparent, double convDpi, QImage::Format format);
+      bool savePng(Score*, const QString& name, bool screenshot, bool transparent, const QList<double>& dpis,
+         QImage::Format format, int firstPage, int lastPage);
+      bool renderAudio(Score*, QIODevice* device, float* peak);
       bool saveAudio(Score*, const QString& name, const QString& type);
       bool saveMp3(Score*, const QString& name);
       bool saveSvg(Score*, const QString& name);
@@ -149,6 +149,8 @@ void Preferences::init()
       midiExpandRepeats        = true;
       MScore::playRepeats      = true;
       MScore::panPlayback      = true;
+      MScore::undoLimit        = 0;
+      MScore::undoMemoryLimit  = 256 * 1024 * 1024;
       instrumentList1          = ":/data/instruments.xml";
       instrumentList2          = "";
 
@@ -313,6 +315,8 @@ void Preferences::write()
       s.setValue("importCharsetOve", importCharsetOve);
       s.setValue("importCharsetGP", importCharsetGP);
       s.setValue("warnPitchRange", MScore::warnPitchRange);
+      s.setValue("undoLimit", MScore::undoLimit);
+      s.setValue("undoMemoryLimit", MScore::undoMemoryLimit / (1024 * 1024));      // MB
       s.setValue("followSong", followSong);
 
       s.setValue("useOsc", useOsc);
@@ -450,6 +454,8 @@ void Preferences::read()
       importCharsetOve          = s.value("importCharsetOve", importCharsetOve).toString();
       importCharsetGP          = s.value("importCharsetGP", importCharsetGP).toString();
       MScore::warnPitchRange = s.value("warnPitchRange", MScore::warnPitchRange).toBool();
+      MScore::undoLimit      = s.value("undoLimit", MScore::undoLimit).toInt();
+      MScore::undoMemoryLimit = s.value("undoMemoryLimit", MScore::undoMemoryLimit / (1024 * 1024)).toLongLong() * 1024 * 1024;
       followSong             = s.value("followSong", followSong).toBool();
 
       useOsc                 = s.value("useOsc", useOsc).toBool();
@@ -961,6 +967,8 @@ void PreferenceDialog::updateValues()
             }
 
       warnPitchRange->setChecked(MScore::warnPitchRange);
+      undoLimit->setValue(MScore::undoLimit);
+      undoMemoryLimit->setValue(MScore::undoMemoryLimit / (1024 * 1024));
 
       language->blockSignals(true);
       language->clear();
@@ -1407,6 +1415,8 @@ void PreferenceDialog::apply()
       prefs.importCharsetOve = importCharsetListOve->currentText();
       prefs.importCharsetGP = importCharsetListGP->currentText();
       MScore::warnPitchRange = warnPitchRange->isChecked();
+      MScore::undoLimit      = undoLimit->value();
+      MScore::undoMemoryLimit = qint64(undoMemoryLimit->value()) * 1024 * 1024;
 
       prefs.useOsc  = oscServer->isChecked();
       prefs.oscPort = oscPort->value();
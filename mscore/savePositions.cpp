@@ -31,7 +31,7 @@ static void saveMeasureEvents(Xml& xml, Measure* m, int offset)
       for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
             int tick = s->tick() + offset;
             int id = segs[(void*)s];
-            int time = lrint(m->score()->repeatList()->utick2utime(tick) * 1000);
+            int time = lrint(m->score()->utick2utime(tick) * 1000);
             xml.tagE(QString("event elid=\"%1\" position=\"%2\"")
                .arg(id)
                .arg(time)
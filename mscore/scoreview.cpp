@@ -651,6 +651,8 @@ ScoreView::ScoreView(QWidget* parent)
       _fgColor    = Qt::white;
       fgPixmap    = 0;
       bgPixmap    = 0;
+      tileMag     = 0.0;
+      paintStamp  = 0;
       curGrip     = -1;
       defaultGrip = -1;
       lasso       = new Lasso(_score);
@@ -924,6 +926,7 @@ void ScoreView::setScore(Score* s)
 
       _score = s;
       _score->addViewer(this);
+      invalidateTiles();
 
       if (shadowNote == 0) {
             shadowNote = new ShadowNote(_score);
@@ -1264,6 +1267,7 @@ void ScoreView::setForeground(const QColor& color)
 
 void ScoreView::dataChanged(const QRectF& r)
       {
+      invalidateTiles(r);
       update(_matrix.mapRect(r).toRect());  // generate paint event
       }
 
@@ -1273,6 +1277,7 @@ void ScoreView::dataChanged(const QRectF& r)
 
 void ScoreView::updateAll()
       {
+      invalidateTiles();
       update();
       }
 
@@ -1788,12 +1793,9 @@ void ScoreView::paint(const QRect& r, QPainter& p)
       QRectF fr = imatrix.mapRect(QRectF(r));
 
       QRegion r1(r);
-      if (_score->layoutMode() == LayoutMode::LINE) {
-            Page* page = _score->pages().front();
-            QList<Element*> ell = page->items(fr);
-            qStableSort(ell.begin(), ell.end(), elementLessThan);
-            drawElements(p, ell);
-            }
+      ++paintStamp;
+      if (_score->layoutMode() == LayoutMode::LINE)
+            paintPage(p, _score->pages().front(), r);
       else {
             foreach (Page* page, _score->pages()) {
                   if (!score()->printing())
@@ -1803,12 +1805,7 @@ void ScoreView::paint(const QRect& r, QPainter& p)
                         continue;
                   if (pr.left() > fr.right())
                         break;
-                  QList<Element*> ell = page->items(fr.translated(-page->pos()));
-                  qStableSort(ell.begin(), ell.end(), elementLessThan);
-                  QPointF pos(page->pos());
-                  p.translate(pos);
-                  drawElements(p, ell);
-                  p.translate(-pos);
+                  paintPage(p, page, r);
                   r1 -= _matrix.mapRect(pr).toAlignedRect();
                   }
             }
@@ -1917,6 +1914,207 @@ void ScoreView::paint(const QRect& r, QPainter& p)
       p.restore();
       }
 
+//---------------------------------------------------------
+//   drawnLive
+//    selected and edited elements are not part of the
+//    cached tiles, they are drawn on top on every paint
+//---------------------------------------------------------
+
+bool ScoreView::drawnLive(const Element* e) const
+      {
+      return e->selected() || e == editObject;
+      }
+
+//---------------------------------------------------------
+//   paintPage
+//    paint the elements of page in the device rectangle r:
+//    blit the cached tiles, rasterize the missing ones and
+//    draw the live elements on top
+//---------------------------------------------------------
+
+void ScoreView::paintPage(QPainter& p, Page* page, const QRect& r)
+      {
+      QRectF fr = imatrix.mapRect(QRectF(r)).translated(-page->pos());
+      if (score()->printing()) {
+            QList<Element*> ell = page->items(fr);
+            qStableSort(ell.begin(), ell.end(), elementLessThan);
+            QPointF pos(page->pos());
+            p.translate(pos);
+            drawElements(p, ell);
+            p.translate(-pos);
+            return;
+            }
+      qreal m = mag();
+      if (m != tileMag) {
+            invalidateTiles();
+            tileMag = m;
+            }
+      //
+      // the page origin is snapped to a device pixel, so tiles
+      // are blitted unscaled and live elements line up with them
+      //
+      QPointF po = _matrix.map(page->pos());
+      QPoint origin(lrint(po.x()), lrint(po.y()));
+      QRect dr(r.translated(-origin));
+      int x1 = qFloor(qreal(dr.left()) / TILE_SIZE);
+      int x2 = qFloor(qreal(dr.right()) / TILE_SIZE);
+      int y1 = qFloor(qreal(dr.top()) / TILE_SIZE);
+      int y2 = qFloor(qreal(dr.bottom()) / TILE_SIZE);
+
+      QList<TileKey> missing;
+      for (int y = y1; y <= y2; ++y) {
+            for (int x = x1; x <= x2; ++x) {
+                  TileKey key { page->no(), x, y };
+                  if (!tiles.contains(key))
+                        missing.append(key);
+                  }
+            }
+      if (!missing.isEmpty())
+            renderTiles(page, missing);
+
+      p.save();
+      p.resetTransform();
+      for (int y = y1; y <= y2; ++y) {
+            for (int x = x1; x <= x2; ++x) {
+                  Tile& tile = tiles[TileKey { page->no(), x, y }];
+                  tile.used = paintStamp;
+                  if (!tile.image.isNull())
+                        p.drawImage(origin + QPoint(x * TILE_SIZE, y * TILE_SIZE), tile.image);
+                  }
+            }
+
+      QList<Element*> ell;
+      foreach (Element* e, page->items(fr)) {
+            if (drawnLive(e))
+                  ell.append(e);
+            }
+      if (!ell.isEmpty()) {
+            qStableSort(ell.begin(), ell.end(), elementLessThan);
+            p.setTransform(QTransform(m, 0.0, 0.0, m, origin.x(), origin.y()));
+            drawElements(p, ell);
+            }
+      p.restore();
+
+      //
+      // drop the least recently painted tiles
+      //
+      if (tiles.size() > MAX_TILES) {
+            QList<uint> stamps;
+            for (const Tile& tile : tiles)
+                  stamps.append(tile.used);
+            qSort(stamps);
+            uint limit = stamps[tiles.size() - MAX_TILES * 3 / 4];
+            for (auto i = tiles.begin(); i != tiles.end();) {
+                  if (i->used < limit)
+                        i = tiles.erase(i);
+                  else
+                        ++i;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   TileJob
+//---------------------------------------------------------
+
+struct TileJob {
+      TileKey key;
+      QList<Element*> elements;
+      QImage image;
+      };
+
+//---------------------------------------------------------
+//   renderTiles
+//    The elements of a tile are collected here as the bsp
+//    tree is not thread safe. Rasterization goes through
+//    the usual Element::draw() into a transparent image and
+//    is spread over the thread pool; the gui thread waits
+//    for all tiles, so no tile is drawn while the score is
+//    modified.
+//---------------------------------------------------------
+
+void ScoreView::renderTiles(Page* page, const QList<TileKey>& keys)
+      {
+      qreal m      = tileMag;
+      qreal ts     = TILE_SIZE / m;
+      qreal margin = 2.0 / m;       // pen width and antialiasing outside of bbox
+      bool showInvisible = score()->showInvisible();
+
+      QList<TileJob> jobs;
+      for (const TileKey& key : keys) {
+            QRectF tr(key.x * ts, key.y * ts, ts, ts);
+            TileJob job;
+            job.key = key;
+            foreach (Element* e, page->items(tr.adjusted(-margin, -margin, margin, margin))) {
+                  if ((e->visible() || showInvisible) && !drawnLive(e))
+                        job.elements.append(e);
+                  }
+            if (!job.elements.isEmpty())
+                  qStableSort(job.elements.begin(), job.elements.end(), elementLessThan);
+            jobs.append(job);
+            }
+
+      bool antialias = preferences.antialiasedDrawing;
+      auto render = [m, antialias](TileJob& job) {
+            if (job.elements.isEmpty())
+                  return;
+            job.image = QImage(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+            job.image.fill(Qt::transparent);
+            QPainter p(&job.image);
+            p.setRenderHint(QPainter::Antialiasing, antialias);
+            p.setRenderHint(QPainter::TextAntialiasing, true);
+            p.setTransform(QTransform(m, 0.0, 0.0, m, -job.key.x * TILE_SIZE, -job.key.y * TILE_SIZE));
+            for (const Element* e : job.elements) {
+                  QPointF pos(e->pagePos());
+                  p.translate(pos);
+                  e->draw(&p);
+                  p.translate(-pos);
+                  }
+            };
+      if (jobs.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1
+         && QFontDatabase::supportsThreadedFontRendering())
+            QtConcurrent::blockingMap(jobs, render);
+      else {
+            for (TileJob& job : jobs)
+                  render(job);
+            }
+      for (const TileJob& job : jobs)
+            tiles.insert(job.key, Tile { job.image, paintStamp });
+      }
+
+//---------------------------------------------------------
+//   invalidateTiles
+//    drop all cached tiles which intersect the canvas
+//    rectangle r
+//---------------------------------------------------------
+
+void ScoreView::invalidateTiles(const QRectF& r)
+      {
+      if (tiles.isEmpty() || !_score)
+            return;
+      qreal ts     = TILE_SIZE / tileMag;
+      qreal margin = 2.0 / tileMag;
+      const QList<Page*>& pl = _score->pages();
+      for (auto i = tiles.begin(); i != tiles.end();) {
+            const TileKey& key = i.key();
+            if (key.page >= pl.size()) {
+                  i = tiles.erase(i);
+                  continue;
+                  }
+            QRectF tr(key.x * ts, key.y * ts, ts, ts);
+            tr.translate(pl[key.page]->pos());
+            if (tr.adjusted(-margin, -margin, margin, margin).intersects(r))
+                  i = tiles.erase(i);
+            else
+                  ++i;
+            }
+      }
+
+void ScoreView::invalidateTiles()
+      {
+      tiles.clear();
+      }
+
 //---------------------------------------------------------
 //   zoomStep: zoom in or out by some number of steps
 //---------------------------------------------------------
@@ -106,6 +106,31 @@ struct CommandEvent : public QEvent
          : QEvent(QEvent::Type(QEvent::User+1)), value(c) {}
       };
 
+//---------------------------------------------------------
+//   TileKey
+//    a TILE_SIZE x TILE_SIZE pixel tile of a page, tile
+//    0/0 starts at the page origin
+//---------------------------------------------------------
+
+struct TileKey {
+      int page;
+      int x, y;
+      bool operator==(const TileKey& k) const { return page == k.page && x == k.x && y == k.y; }
+      };
+
+inline uint qHash(const TileKey& k) { return qHash(k.page) ^ qHash((k.x << 16) ^ k.y); }
+
+//---------------------------------------------------------
+//   Tile
+//    cached rasterization of all elements of a tile which
+//    are not drawn live; null if the tile is empty
+//---------------------------------------------------------
+
+struct Tile {
+      QImage image;
+      uint used;              // paint stamp of last use
+      };
+
 //---------------------------------------------------------
 //   ScoreView
 //---------------------------------------------------------
@@ -178,8 +203,19 @@ class ScoreView : public QWidget, public MuseScoreView {
       QPixmap* bgPixmap;
       QPixmap* fgPixmap;
 
+      static const int TILE_SIZE = 256;
+      static const int MAX_TILES = 256;   // 64MB of tiles per view
+      QHash<TileKey, Tile> tiles;
+      qreal tileMag;                      // mag the cached tiles were rendered with
+      uint paintStamp;
+
       virtual void paintEvent(QPaintEvent*);
       void paint(const QRect&, QPainter&);
+      void paintPage(QPainter&, Page*, const QRect&);
+      void renderTiles(Page*, const QList<TileKey>&);
+      void invalidateTiles(const QRectF&);
+      void invalidateTiles();
+      bool drawnLive(const Element*) const;
 
       void objectPopup(const QPoint&, Element*);
       void measurePopup(const QPoint&, Measure*);
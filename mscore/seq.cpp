@@ -145,7 +145,12 @@ Seq::Seq()
       state    = TRANSPORT_STOP;
       oggInit  = false;
       _driver  = 0;
-      playPos  = events.cbegin();
+      events   = new EventMap;
+      newEvents.store(0);
+      seqEvents.store(events);
+      playPos  = events->cbegin();
+      playTick.store(0);
+      lastTick.store(0);
 
       playTime  = 0;
       metronomeVolume = 0.3;
@@ -184,6 +189,9 @@ Seq::Seq()
 Seq::~Seq()
       {
       delete _driver;
+      freeEvents();
+      delete newEvents.exchange(0);
+      delete seqEvents.load();
       }
 
 //---------------------------------------------------------
@@ -288,7 +296,7 @@ bool Seq::canStart()
             return false;
       if (playlistChanged)
             collectEvents();
-      return (!events.empty() && endTick != 0);
+      return (!events->empty() && endTick != 0);
       }
 
 //---------------------------------------------------------
@@ -658,6 +666,7 @@ void Seq::addCountInClicks()
 
 void Seq::process(unsigned n, float* buffer)
       {
+      takeEvents();
       unsigned frames = n;
       int driverState = _driver->getState();
 
@@ -690,7 +699,7 @@ void Seq::process(unsigned n, float* buffer)
                   state = TRANSPORT_STOP;
                   // Muting all notes
                   stopNotes();
-                  if (playPos == events.cend()) {
+                  if (playPos == seqEvents.load()->cend()) {
                         if (mscore->loop()) {
                               qDebug("Seq.cpp - Process - Loop whole score. playPos = %d     cs->pos() = %d", playPos->first,cs->pos());
                               emit toGui('4');
@@ -733,7 +742,7 @@ void Seq::process(unsigned n, float* buffer)
             if(!cs)
                   return;
             EventMap::const_iterator* pPlayPos = &playPos;
-            EventMap* pEvents   = &events;
+            EventMap* pEvents   = seqEvents.load();
             int*      pPlayTime = &playTime;
             //
             // in count-in?
@@ -750,6 +759,7 @@ void Seq::process(unsigned n, float* buffer)
             //
             unsigned framePos = 0;
             int endTime = *pPlayTime + frames;
+            bool useFrames = pEvents->hasFrames(cs->tempomap()->relTempo());
             int utickEnd = cs->repeatList()->tick2utick(cs->lastMeasure()->endTick()) - 1;
             for ( ; *pPlayPos != pEvents->cend(); ) {
                   int n;
@@ -770,7 +780,7 @@ void Seq::process(unsigned n, float* buffer)
                               }
                         }
                   else {
-                        int f = cs->utick2utime(playPos->first) * MScore::sampleRate;
+                        int f = useFrames ? pEvents->frame(playPos) : cs->utick2utime(playPos->first) * MScore::sampleRate;
                         if (f >= endTime)
                               break;
                         n = f - *pPlayTime;
@@ -822,10 +832,10 @@ qDebug ("Process playPos = %d  in/out tick = %d/%d  getCurTick() = %d   tickLoop
                         tickRest = tickLength;
                   else if (event.type() == ME_TICK2)
                         tackRest = tackLength;
-                  mutex.lock();
                   ++(*pPlayPos);
-                  mutex.unlock();
                   }
+            if (!inCountIn)
+                  publishPos();
             if (frames) {
                   if (cs->playMode() == PlayMode::SYNTHESIZER) {
                         metronome(frames, p, inCountIn);
@@ -914,23 +924,76 @@ void Seq::collectEvents()
       //do not collect even while playing
       if (state ==  TRANSPORT_PLAY)
             return;
-      events.clear();
 
-      mutex.lock();
-      cs->renderMidi(&events);
+      EventMap* ev = new EventMap;
+      cs->renderMidi(ev);
+      ev->setFrames([this](int utick) { return int(cs->utick2utime(utick) * MScore::sampleRate); },
+         cs->tempomap()->relTempo());
       endTick = 0;
-
-      if (!events.empty()) {
-            auto e = events.cend();
+      if (!ev->empty()) {
+            auto e = ev->cend();
             --e;
             endTick = e->first;
             }
-      playPos  = events.cbegin();
-      mutex.unlock();
+
+      // hand the new playlist to the rt thread; a playlist
+      // it did not pick up yet was never played and is
+      // still ours
+      delete newEvents.exchange(ev);
+      events = ev;
+      guiPos = events->cbegin();
+      freeEvents();
 
       playlistChanged = false;
       }
 
+//---------------------------------------------------------
+//   freeEvents
+//    delete the playlists the rt thread has replaced
+//---------------------------------------------------------
+
+void Seq::freeEvents()
+      {
+      while (!retiredEvents.isEmpty())
+            delete retiredEvents.dequeue();
+      }
+
+//---------------------------------------------------------
+//   takeEvents
+//    pick up a playlist published by collectEvents()
+//    realtime environment
+//---------------------------------------------------------
+
+void Seq::takeEvents()
+      {
+      if (retiredEvents.isFull())
+            return;                 // gui thread is behind, keep playing the old list
+      EventMap* ev = newEvents.exchange(0);
+      if (!ev)
+            return;
+      retiredEvents.enqueue(seqEvents.exchange(ev));
+      playPos = ev->cbegin();
+      publishPos();
+      }
+
+//---------------------------------------------------------
+//   publishPos
+//    make the play position visible to the gui thread
+//    realtime environment
+//---------------------------------------------------------
+
+void Seq::publishPos()
+      {
+      const EventMap* ev = seqEvents.load();
+      if (ev->empty())
+            return;
+      auto last = playPos;
+      if (last != ev->cbegin())
+            --last;
+      playTick.store(playPos != ev->cend() ? playPos->first : last->first);
+      lastTick.store(last->first);
+      }
+
 //---------------------------------------------------------
 //   getCurTick
 //---------------------------------------------------------
@@ -961,9 +1024,11 @@ void Seq::setPos(int utick)
       if (cs == 0)
             return;
       stopNotes();
+      takeEvents();
 
+      const EventMap* ev = seqEvents.load();
       int ucur;
-      if (playPos != events.end())
+      if (playPos != ev->cend())
             ucur = cs->repeatList()->utick2tick(playPos->first);
       else
             ucur = utick - 1;
@@ -971,9 +1036,8 @@ void Seq::setPos(int utick)
             updateSynthesizerState(ucur, utick);
 
       playTime  = cs->utick2utime(utick) * MScore::sampleRate;
-      mutex.lock();
-      playPos   = events.lower_bound(utick);
-      mutex.unlock();
+      playPos   = ev->lower_bound(utick);
+      publishPos();
       }
 
 //---------------------------------------------------------
@@ -1013,7 +1077,7 @@ void Seq::seek(int utick, Segment* seg)
             }
 
       guiToSeq(SeqMsg(SEQ_SEEK, utick));
-      guiPos = events.lower_bound(utick);
+      guiPos = events->lower_bound(utick);
       mscore->setPos(utick);
       unmarkNotes();
       cs->update();
@@ -1127,7 +1191,7 @@ void Seq::nextMeasure()
 void Seq::nextChord()
       {
       int tick = guiPos->first;
-      for (auto i = guiPos; i != events.cend(); ++i) {
+      for (auto i = guiPos; i != events->cend(); ++i) {
             if (i->second.type() == ME_NOTEON && i->first > tick && i->second.velo()) {
                   seek(i->first);
                   break;
@@ -1142,7 +1206,7 @@ void Seq::nextChord()
 void Seq::prevMeasure()
       {
       auto i = guiPos;
-      if (i == events.begin())
+      if (i == events->cbegin())
             return;
       --i;
       Measure* m = cs->tick2measure(i->first);
@@ -1159,9 +1223,13 @@ void Seq::prevMeasure()
 
 void Seq::prevChord()
       {
-      int tick  = playPos->first;
+      if (events->empty())
+            return;
+      int tick  = playTick.load();
       //find the chord just before playpos
-      EventMap::const_iterator i = events.upper_bound(cs->repeatList()->tick2utick(tick));
+      EventMap::const_iterator i = events->upper_bound(cs->repeatList()->tick2utick(tick));
+      if (i == events->cend())
+            --i;
       for (;;) {
             if (i->second.type() == ME_NOTEON) {
                   const NPlayEvent& n = i->second;
@@ -1170,13 +1238,15 @@ void Seq::prevChord()
                         break;
                         }
                   }
-            if (i == events.cbegin())
+            if (i == events->cbegin())
                   break;
             --i;
             }
       //go the previous chord
-      if (i != events.cbegin()) {
-            i = playPos;
+      if (i != events->cbegin()) {
+            i = events->lower_bound(playTick.load());
+            if (i == events->cend())
+                  --i;
             for (;;) {
                   if (i->second.type() == ME_NOTEON) {
                         const NPlayEvent& n = i->second;
@@ -1185,7 +1255,7 @@ void Seq::prevChord()
                               break;
                               }
                         }
-                  if (i == events.cbegin())
+                  if (i == events->cbegin())
                         break;
                   --i;
                   }
@@ -1329,16 +1399,11 @@ void Seq::heartBeatTimeout()
       if (state != TRANSPORT_PLAY || inCountIn)
             return;
       int endTime = playTime;
-
-      mutex.lock();
-      auto ppos = playPos;
-      if (ppos != events.cbegin())
-            --ppos;
-      mutex.unlock();
+      int utick   = lastTick.load();
 
       QRectF r;
-      for (;guiPos != events.cend(); ++guiPos) {
-            if (guiPos->first > ppos->first)
+      for (;guiPos != events->cend(); ++guiPos) {
+            if (guiPos->first > utick)
                   break;
             if (mscore->loop())
                   if (guiPos->first >= cs->repeatList()->tick2utick(cs->loopOutTick()))
@@ -1365,7 +1430,6 @@ void Seq::heartBeatTimeout()
                         }
                   }
             }
-      int utick = ppos->first;
       int tick = cs->repeatList()->utick2tick(utick);
       mscore->currentScoreView()->moveCursor(tick);
       mscore->setPos(tick);
@@ -1375,7 +1439,7 @@ void Seq::heartBeatTimeout()
       PianorollEditor* pre = mscore->getPianorollEditor();
       if (pre && pre->isVisible())
             pre->heartBeat(this);
-      cv->update(cv->toPhysical(r));
+      cv->dataChanged(r);
       }
 
 //---------------------------------------------------------
@@ -1388,8 +1452,9 @@ void Seq::updateSynthesizerState(int tick1, int tick2)
       {
       if (tick1 > tick2)
             tick1 = 0;
-      EventMap::const_iterator i1 = events.lower_bound(tick1);
-      EventMap::const_iterator i2 = events.upper_bound(tick2);
+      const EventMap* ev = seqEvents.load();
+      EventMap::const_iterator i1 = ev->lower_bound(tick1);
+      EventMap::const_iterator i2 = ev->upper_bound(tick2);
 
       for (; i1 != i2; ++i1) {
             if (i1->second.type() == ME_CONTROLLER)
@@ -1403,7 +1468,7 @@ void Seq::updateSynthesizerState(int tick1, int tick2)
 
 double Seq::curTempo() const
       {
-      return cs->tempomap()->tempo(playPos->first);
+      return cs->tempomap()->tempo(playTick.load());
       }
 
 //---------------------------------------------------------
@@ -1414,10 +1479,8 @@ void Seq::setLoopIn()
       {
       int tick;
       if (state == TRANSPORT_PLAY) {      // If in playback mode, set the In position where note is being played
-            auto ppos = playPos;
-            if (ppos != events.cbegin())
-                  --ppos;                 // We have to go back one pos to get the correct note that has just been played
-            tick = cs->repeatList()->utick2tick(ppos->first);
+            // the note that has just been played
+            tick = cs->repeatList()->utick2tick(lastTick.load());
             }
       else
             tick = cs->pos();             // Otherwise, use the selected note.
@@ -1434,7 +1497,7 @@ void Seq::setLoopOut()
       {
       int tick;
       if (state == TRANSPORT_PLAY) {    // If in playback mode, set the Out position where note is being played
-            tick = cs->repeatList()->utick2tick(playPos->first);
+            tick = cs->repeatList()->utick2tick(playTick.load());
             }
       else
             tick = cs->pos()+cs->inputState().ticks();   // Otherwise, use the selected note.
@@ -21,6 +21,7 @@
 #ifndef __SEQ_H__
 #define __SEQ_H__
 
+#include <atomic>
 #include "libmscore/sequencer.h"
 #include "libmscore/fraction.h"
 #include "synthesizer/event.h"
@@ -84,6 +85,24 @@ class SeqMsgFifo : public FifoBase {
       SeqMsg dequeue();                   // remove object from fifo
       };
 
+//---------------------------------------------------------
+//   EventMapFifo
+//    playlists retired by the rt thread, deleted by the
+//    gui thread
+//---------------------------------------------------------
+
+static const int EVENT_MAP_FIFO_SIZE = 16;
+
+class EventMapFifo : public FifoBase {
+      EventMap* maps[EVENT_MAP_FIFO_SIZE];
+
+   public:
+      EventMapFifo()            { maxCount = EVENT_MAP_FIFO_SIZE; clear(); }
+      virtual ~EventMapFifo()   {}
+      void enqueue(EventMap* m) { maps[widx] = m; push(); }
+      EventMap* dequeue()       { EventMap* m = maps[ridx]; pop(); return m; }
+      };
+
 //---------------------------------------------------------
 //   Seq
 //    sequencer
@@ -114,12 +133,21 @@ class Seq : public QObject, public Sequencer {
       double meterPeakValue[2];
       int peakTimer[2];
 
-      EventMap events;                    // playlist
+      // A published playlist is owned by the rt thread. It takes it
+      // out of newEvents with an atomic exchange and hands the playlist
+      // it replaces back through retiredEvents; the gui thread only
+      // deletes lists it got back from one of the two.
+      EventMap* events;                   // last published playlist, gui thread
+      std::atomic<EventMap*> newEvents;   // published playlist, not yet picked up by the rt thread
+      std::atomic<EventMap*> seqEvents;   // playlist played by the rt thread
+      EventMapFifo retiredEvents;         // replaced playlists, rt thread -> gui thread
       EventMap countInEvents;
 
       int playTime;                       // current play position in samples
       int countInPlayTime;
       int endTick;
+      std::atomic<int> playTick;          // utick of next event, published by the rt thread
+      std::atomic<int> lastTick;          // utick of last played event, published by the rt thread
 
       EventMap::const_iterator playPos;   // moved in real time thread
       EventMap::const_iterator countInPlayPos;
@@ -143,6 +171,9 @@ class Seq : public QObject, public Sequencer {
       void unmarkNotes();
       void updateSynthesizerState(int tick1, int tick2);
       void addCountInClicks();
+      void takeEvents();
+      void publishPos();
+      void freeEvents();
 
    private slots:
       void seqMessage(int msg);
@@ -23,6 +23,7 @@
 #include "libmscore/stafftext.h"
 #include "libmscore/system.h"
 #include "libmscore/staff.h"
+#include "libmscore/segment.h"
 
 namespace Ms {
 
@@ -371,6 +372,8 @@ void StaffTextProperties::saveValues()
                   }
             }
 
+      Segment* seg = static_cast<Segment*>(staffText->parent());
+      staffText->score()->invalidateMidiCache(seg->tick(), seg->tick());
       staffText->score()->updateChannel();
       staffText->score()->setPlaylistDirty(true);
       }
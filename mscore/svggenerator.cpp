@@ -147,6 +147,7 @@ public:
         attributes.font_weight = QLatin1String("normal");
 
         afterFirstUpdate = false;
+        fragment = false;
         numGradients = 0;
     }
 
@@ -160,6 +161,8 @@ public:
     QString defs;
     QString body;
     bool    afterFirstUpdate;
+    bool    fragment;
+    QString idPrefix;
 
     QBrush brush;
     QPen pen;
@@ -168,7 +171,7 @@ public:
 
     QString generateGradientName() {
         ++numGradients;
-        currentGradientName = QString::fromLatin1("gradient%1").arg(numGradients);
+        currentGradientName = idPrefix + QString::fromLatin1("gradient%1").arg(numGradients);
         return currentGradientName;
     }
 
@@ -256,6 +259,20 @@ public:
         Q_ASSERT(!isActive());
         d_func()->resolution = resolution;
     }
+
+    bool fragment() const { return d_func()->fragment; }
+    void setFragment(bool fragment) {
+        Q_ASSERT(!isActive());
+        d_func()->fragment = fragment;
+    }
+
+    QString idPrefix() const { return d_func()->idPrefix; }
+    void setIdPrefix(const QString &prefix) {
+        Q_ASSERT(!isActive());
+        d_func()->idPrefix = prefix;
+    }
+
+    void writeHeader(QTextStream &str);
     void saveLinearGradientBrush(const QGradient *g)
     {
         QTextStream str(&d_func()->defs, QIODevice::Append);
@@ -808,6 +825,76 @@ void SvgGenerator::setResolution(int dpi)
     d->engine->setResolution(dpi);
 }
 
+/*!
+    \property SvgGenerator::fragment
+    \brief whether only the drawing is written, without the svg document around it
+
+    Fragments of several generators with the same size and resolution
+    can be written one after another between header() and footer()
+    to assemble a single document, e.g. from pages painted in parallel.
+*/
+bool SvgGenerator::isFragment() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->fragment();
+}
+
+void SvgGenerator::setFragment(bool fragment)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setFragment(), cannot change mode while SVG is being generated");
+        return;
+    }
+    d->engine->setFragment(fragment);
+}
+
+/*!
+    \property SvgGenerator::idPrefix
+    \brief the prefix of the ids generated for gradients
+
+    Fragments assembled into one document need distinct prefixes,
+    otherwise each fragment starts again with the same ids.
+*/
+QString SvgGenerator::idPrefix() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->idPrefix();
+}
+
+void SvgGenerator::setIdPrefix(const QString &prefix)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setIdPrefix(), cannot change prefix while SVG is being generated");
+        return;
+    }
+    d->engine->setIdPrefix(prefix);
+}
+
+/*!
+    Returns the start of the svg document as written by a generator
+    which is not a fragment.
+*/
+QString SvgGenerator::header() const
+{
+    Q_D(const SvgGenerator);
+    QString header;
+    QTextStream str(&header);
+    d->engine->writeHeader(str);
+    str << "<defs>\n</defs>\n";
+    str.flush();
+    return header;
+}
+
+/*!
+    Returns the end of the svg document.
+*/
+QString SvgGenerator::footer() const
+{
+    return QLatin1String("</svg>\n");
+}
+
 /*!
     Returns the paint engine used to render graphics to be converted to SVG
     format information.
@@ -877,43 +964,50 @@ bool SvgPaintEngine::begin(QPaintDevice *)
     }
 
     d->stream = new QTextStream(&d->header);
+    if (!d->fragment)
+        writeHeader(*d->stream);
+
+    d->stream->setString(&d->defs);
+    *d->stream << "<defs>\n";
+
+    d->stream->setString(&d->body);
+    // Start the initial graphics state...
+    *d->stream << "<g ";
+    generateQtDefaults();
+    *d->stream << endl;
+
+    return true;
+}
+
+void SvgPaintEngine::writeHeader(QTextStream &str)
+{
+    Q_D(SvgPaintEngine);
 
     // stream out the header...
-    *d->stream << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << endl << "<svg";
+    str << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << endl << "<svg";
 
     if (d->size.isValid()) {
         qreal wmm = d->size.width() * 25.4 / d->resolution;
         qreal hmm = d->size.height() * 25.4 / d->resolution;
-        *d->stream << " width=\"" << wmm << "mm\" height=\"" << hmm << "mm\"" << endl;
+        str << " width=\"" << wmm << "mm\" height=\"" << hmm << "mm\"" << endl;
     }
 
     if (d->viewBox.isValid()) {
-        *d->stream << " viewBox=\"" << d->viewBox.left() << ' ' << d->viewBox.top();
-        *d->stream << ' ' << d->viewBox.width() << ' ' << d->viewBox.height() << '\"' << endl;
+        str << " viewBox=\"" << d->viewBox.left() << ' ' << d->viewBox.top();
+        str << ' ' << d->viewBox.width() << ' ' << d->viewBox.height() << '\"' << endl;
     }
 
-    *d->stream << " xmlns=\"http://www.w3.org/2000/svg\""
-                  " xmlns:xlink=\"http://www.w3.org/1999/xlink\" "
-                  " version=\"1.2\" baseProfile=\"tiny\">" << endl;
+    str << " xmlns=\"http://www.w3.org/2000/svg\""
+           " xmlns:xlink=\"http://www.w3.org/1999/xlink\" "
+           " version=\"1.2\" baseProfile=\"tiny\">" << endl;
 
     if (!d->attributes.document_title.isEmpty()) {
-        *d->stream << "<title>" << d->attributes.document_title << "</title>" << endl;
+        str << "<title>" << d->attributes.document_title << "</title>" << endl;
     }
 
     if (!d->attributes.document_description.isEmpty()) {
-        *d->stream << "<desc>" << d->attributes.document_description << "</desc>" << endl;
+        str << "<desc>" << d->attributes.document_description << "</desc>" << endl;
     }
-
-    d->stream->setString(&d->defs);
-    *d->stream << "<defs>\n";
-
-    d->stream->setString(&d->body);
-    // Start the initial graphics state...
-    *d->stream << "<g ";
-    generateQtDefaults();
-    *d->stream << endl;
-
-    return true;
 }
 
 bool SvgPaintEngine::end()
@@ -929,13 +1023,15 @@ bool SvgPaintEngine::end()
 #endif
 
     *d->stream << d->header;
-    *d->stream << d->defs;
+    if (!d->fragment || d->numGradients)
+        *d->stream << d->defs;
     *d->stream << d->body;
     if (d->afterFirstUpdate)
         *d->stream << "</g>" << endl; // close the updateState
 
-    *d->stream << "</g>" << endl // close the Qt defaults
-               << "</svg>" << endl;
+    *d->stream << "</g>" << endl; // close the Qt defaults
+    if (!d->fragment)
+        *d->stream << "</svg>" << endl;
 
     delete d->stream;
 
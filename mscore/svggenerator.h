@@ -60,6 +60,8 @@ class SvgGeneratorPrivate;
 //   @P fileName      QString
 //   @P outputDevice  QIODevice
 //   @P resolution    int
+//   @P fragment      bool
+//   @P idPrefix      QString
 //---------------------------------------------------------
 
 class SvgGenerator : public QPaintDevice
@@ -73,6 +75,8 @@ class SvgGenerator : public QPaintDevice
     Q_PROPERTY(QString fileName READ fileName WRITE setFileName)
     Q_PROPERTY(QIODevice* outputDevice READ outputDevice WRITE setOutputDevice)
     Q_PROPERTY(int resolution READ resolution WRITE setResolution)
+    Q_PROPERTY(bool fragment READ isFragment WRITE setFragment)
+    Q_PROPERTY(QString idPrefix READ idPrefix WRITE setIdPrefix)
 public:
     SvgGenerator();
     ~SvgGenerator();
@@ -99,6 +103,13 @@ public:
 
     void setResolution(int dpi);
     int resolution() const;
+
+    bool isFragment() const;
+    void setFragment(bool fragment);
+    QString idPrefix() const;
+    void setIdPrefix(const QString &prefix);
+    QString header() const;
+    QString footer() const;
 protected:
     QPaintEngine *paintEngine() const;
     int metric(QPaintDevice::PaintDeviceMetric metric) const;
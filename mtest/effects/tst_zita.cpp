@@ -0,0 +1,149 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "effects/zita1/zita.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+static const int FRAMES = 512;
+static const float SR   = 44100.0;
+
+//---------------------------------------------------------
+//   TestZita
+//    block and per sample reverb, silence bypass
+//---------------------------------------------------------
+
+class TestZita : public QObject
+      {
+      Q_OBJECT
+
+      float noise[FRAMES * 2];
+
+   private slots:
+      void initTestCase();
+      void compare();
+      void bypass();
+      void benchReverb_data();
+      void benchReverb();
+      void benchIdle();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestZita::initTestCase()
+      {
+      initNoise();
+      fillNoise(noise, FRAMES * 2, -0.5);
+      }
+
+//---------------------------------------------------------
+//   compare
+//    block and per sample reverb must be bit identical,
+//    also for odd block sizes
+//---------------------------------------------------------
+
+void TestZita::compare()
+      {
+      ZitaReverb r1, r2;
+      r1.init(SR);
+      r2.init(SR);
+      r1.setSimd(false);
+      r2.setSimd(true);
+      r2.set_opmix(0.7);
+      r1.set_opmix(0.7);
+      float o1[FRAMES * 2], o2[FRAMES * 2];
+      for (int block = 0; block < 200; ++block) {
+            int n = 1 + (block * 37) % FRAMES;
+            r1.process(n, noise, o1);
+            r2.process(n, noise, o2);
+            QVERIFY(sameSamples(o1, o2, n * 2));
+            }
+      }
+
+//---------------------------------------------------------
+//   bypass
+//    after the tail has decayed only the dry signal is
+//    left; audible input wakes the reverb up again
+//---------------------------------------------------------
+
+void TestZita::bypass()
+      {
+      ZitaReverb r;
+      r.init(SR);
+      float out[FRAMES * 2];
+      float silence[FRAMES * 2];
+      memset(silence, 0, sizeof(silence));
+
+      r.process(FRAMES, noise, out);
+      QVERIFY(!r.idle());
+      int blocks = 0;
+      while (!r.idle() && blocks < int(30 * SR / FRAMES)) {
+            r.process(FRAMES, silence, out);
+            ++blocks;
+            }
+      QVERIFY(r.idle());
+      QVERIFY(blocks * FRAMES > SR / 2);          // not before the tail is gone
+      r.process(FRAMES, silence, out);
+      for (int i = 0; i < FRAMES * 2; ++i)
+            QCOMPARE(out[i], 0.0f);
+      r.process(FRAMES, noise, out);
+      QVERIFY(!r.idle());
+      }
+
+//---------------------------------------------------------
+//   benchReverb
+//    one second of noise
+//---------------------------------------------------------
+
+void TestZita::benchReverb_data()
+      {
+      simdData();
+      }
+
+void TestZita::benchReverb()
+      {
+      QFETCH(bool, simd);
+      ZitaReverb r;
+      r.init(SR);
+      r.setSimd(simd);
+      float out[FRAMES * 2];
+      QBENCHMARK {
+            for (int i = 0; i < SR / FRAMES; ++i)
+                  r.process(FRAMES, noise, out);
+            }
+      }
+
+//---------------------------------------------------------
+//   benchIdle
+//    one second of silence after the tail has decayed
+//---------------------------------------------------------
+
+void TestZita::benchIdle()
+      {
+      ZitaReverb r;
+      r.init(SR);
+      float out[FRAMES * 2];
+      float silence[FRAMES * 2];
+      memset(silence, 0, sizeof(silence));
+      QVERIFY(r.idle());
+      QBENCHMARK {
+            for (int i = 0; i < SR / FRAMES; ++i)
+                  r.process(FRAMES, silence, out);
+            }
+      }
+
+QTEST_MAIN(TestZita)
+#include "tst_zita.moc"
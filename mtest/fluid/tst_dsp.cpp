@@ -0,0 +1,200 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "fluid/dsp.h"
+#include "mtest/testutils.h"
+
+using namespace FluidS;
+
+static const unsigned SAMPLES = 1 << 16;
+static const unsigned BLOCK   = 64;
+
+//---------------------------------------------------------
+//   TestDsp
+//    compares the SIMD kernels of the fluid voice
+//    against the scalar loops
+//---------------------------------------------------------
+
+class TestDsp : public QObject
+      {
+      Q_OBJECT
+
+      short data[SAMPLES];
+      float coeff2[FLUID_INTERP_MAX][2];
+      float coeff4[FLUID_INTERP_MAX][4];
+      float coeff7[FLUID_INTERP_MAX][7];
+
+      unsigned run(const float (*coeff)[2], Phase& phase, float& amp, float* buf, bool simd);
+      unsigned run(const float (*coeff)[4], Phase& phase, float& amp, float* buf, bool simd);
+      unsigned run(const float (*coeff)[7], Phase& phase, float& amp, float* buf, bool simd);
+      template <int N>
+      void compare(const float (*coeff)[N]);
+      template <int N>
+      void bench(const float (*coeff)[N], bool simd);
+
+   private slots:
+      void initTestCase();
+      void linear()     { compare<2>(coeff2); }
+      void order4()     { compare<4>(coeff4); }
+      void order7()     { compare<7>(coeff7); }
+      void mix();
+      void benchLinear_data();
+      void benchLinear();
+      void bench4_data();
+      void bench4();
+      void bench7_data();
+      void bench7();
+      void benchMix_data();
+      void benchMix();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestDsp::initTestCase()
+      {
+      Ms::initNoise();
+      Ms::fillNoise(data, SAMPLES);
+      Ms::fillNoise(coeff2[0], FLUID_INTERP_MAX * 2, 0.0);
+      Ms::fillNoise(coeff4[0], FLUID_INTERP_MAX * 4, -0.25);
+      Ms::fillNoise(coeff7[0], FLUID_INTERP_MAX * 7, -0.5);
+      }
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+unsigned TestDsp::run(const float (*coeff)[2], Phase& phase, float& amp, float* buf, bool simd)
+      {
+      Phase incr;
+      incr.setFloat(1.37);
+      return dsp_interpolate_linear_run(data, coeff, phase, incr, amp, 1e-4, buf, 0, BLOCK, SAMPLES - 8, simd);
+      }
+
+unsigned TestDsp::run(const float (*coeff)[4], Phase& phase, float& amp, float* buf, bool simd)
+      {
+      Phase incr;
+      incr.setFloat(1.37);
+      return dsp_interpolate_4th_run(data, coeff, phase, incr, amp, 1e-4, buf, 0, BLOCK, SAMPLES - 8, simd);
+      }
+
+unsigned TestDsp::run(const float (*coeff)[7], Phase& phase, float& amp, float* buf, bool simd)
+      {
+      Phase incr;
+      incr.setFloat(1.37);
+      return dsp_interpolate_7th_run(data, coeff, phase, incr, amp, 1e-4, buf, 0, BLOCK, SAMPLES - 8, simd);
+      }
+
+//---------------------------------------------------------
+//   compare
+//    run scalar and SIMD kernel over the whole sample,
+//    results must be bit identical
+//---------------------------------------------------------
+
+template <int N>
+void TestDsp::compare(const float (*coeff)[N])
+      {
+      Phase p1, p2;
+      p1.setFloat(4.25);
+      p2 = p1;
+      float a1 = 0.1;
+      float a2 = a1;
+      float b1[BLOCK];
+      float b2[BLOCK];
+      for (;;) {
+            unsigned n1 = run(coeff, p1, a1, b1, false);
+            unsigned n2 = run(coeff, p2, a2, b2, true);
+            QCOMPARE(n1, n2);
+            QCOMPARE(p1.data, p2.data);
+            QVERIFY(a1 == a2);
+            QVERIFY(Ms::sameSamples(b1, b2, n1));
+            if (n1 < BLOCK)
+                  break;
+            }
+      }
+
+//---------------------------------------------------------
+//   mix
+//---------------------------------------------------------
+
+void TestDsp::mix()
+      {
+      const unsigned n = BLOCK + 3;
+      float buf[n];
+      for (unsigned i = 0; i < n; ++i)
+            buf[i] = data[i] / 32768.0;
+      float out[2][n * 2], reverb[2][n * 2], chorus[2][n * 2];
+      for (int k = 0; k < 2; ++k) {
+            for (unsigned i = 0; i < n * 2; ++i)
+                  out[k][i] = reverb[k][i] = chorus[k][i] = data[n + i] / 32768.0;
+            dsp_mix(buf, n, 0.3, 0.7, 0.2, 0.1, out[k], reverb[k], chorus[k], k == 1);
+            }
+      QVERIFY(Ms::sameSamples(out[0], out[1], n * 2));
+      QVERIFY(Ms::sameSamples(reverb[0], reverb[1], n * 2));
+      QVERIFY(Ms::sameSamples(chorus[0], chorus[1], n * 2));
+      }
+
+//---------------------------------------------------------
+//   bench
+//---------------------------------------------------------
+
+template <int N>
+void TestDsp::bench(const float (*coeff)[N], bool simd)
+      {
+      float buf[BLOCK];
+      QBENCHMARK {
+            Phase phase;
+            phase.setFloat(4.25);
+            float amp = 0.1;
+            while (run(coeff, phase, amp, buf, simd) == BLOCK)
+                  ;
+            }
+      }
+
+void TestDsp::benchLinear_data() { Ms::simdData(); }
+void TestDsp::bench4_data()      { Ms::simdData(); }
+void TestDsp::bench7_data()      { Ms::simdData(); }
+void TestDsp::benchMix_data()    { Ms::simdData(); }
+
+void TestDsp::benchLinear()
+      {
+      QFETCH(bool, simd);
+      bench<2>(coeff2, simd);
+      }
+
+void TestDsp::bench4()
+      {
+      QFETCH(bool, simd);
+      bench<4>(coeff4, simd);
+      }
+
+void TestDsp::bench7()
+      {
+      QFETCH(bool, simd);
+      bench<7>(coeff7, simd);
+      }
+
+void TestDsp::benchMix()
+      {
+      QFETCH(bool, simd);
+      static float buf[SAMPLES / 2], out[SAMPLES], reverb[SAMPLES], chorus[SAMPLES];
+      for (unsigned i = 0; i < SAMPLES / 2; ++i)
+            buf[i] = data[i] / 32768.0;
+      QBENCHMARK {
+            dsp_mix(buf, SAMPLES / 2, 0.3, 0.7, 0.2, 0.1, out, reverb, chorus, simd);
+            }
+      }
+
+QTEST_MAIN(TestDsp)
+#include "tst_dsp.moc"
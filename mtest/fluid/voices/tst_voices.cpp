@@ -0,0 +1,126 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "fluid/fluid.h"
+#include "synthesizer/event.h"
+
+using namespace FluidS;
+
+static const int VOICES = 512;
+static const int BLOCK  = 64;
+
+//---------------------------------------------------------
+//   TestFluid
+//---------------------------------------------------------
+
+class TestFluid : public Fluid {
+   public:
+      TestFluid()
+            {
+            init(44100);
+            play(PlayEvent(ME_CONTROLLER, 0, CTRL_PRESS, 0));   // creates channel 0
+            noteid = 1000;
+            }
+      };
+
+//---------------------------------------------------------
+//   TestVoices
+//    allocation and stealing of the fluid voice pool
+//---------------------------------------------------------
+
+class TestVoices : public QObject
+      {
+      Q_OBJECT
+
+      float out[BLOCK * 2], reverb[BLOCK * 2], chorus[BLOCK * 2];
+
+   private slots:
+      void steal();
+      void active();
+      void benchSteal();
+      };
+
+//---------------------------------------------------------
+//   steal
+//    with all voices in use the oldest voice is killed;
+//    the pool hands it out again for the new note
+//---------------------------------------------------------
+
+void TestVoices::steal()
+      {
+      TestFluid f;
+      Voice* voices[VOICES];
+      for (int i = 0; i < VOICES; ++i) {
+            voices[i] = f.alloc_voice(i, 0, 0, 60, 100, 0);
+            QVERIFY(voices[i]);
+            }
+      VoiceStats stats = f.voiceStats();
+      QCOMPARE(stats.allocated, VOICES);
+      QCOMPARE(stats.stolen, 0);
+
+      for (int i = 0; i < 10; ++i)
+            QVERIFY(f.alloc_voice(1000 + i, 0, 0, 62, 100, 0) == voices[i]);
+      stats = f.voiceStats();
+      QCOMPARE(stats.allocated, VOICES + 10);
+      QCOMPARE(stats.stolen, 10);
+
+      // a finished block rebuilds the priorities
+      f.process(BLOCK, out, reverb, chorus);
+      QVERIFY(f.alloc_voice(2000, 0, 0, 64, 100, 0) == voices[10]);
+      }
+
+//---------------------------------------------------------
+//   active
+//---------------------------------------------------------
+
+void TestVoices::active()
+      {
+      TestFluid f;
+      for (int i = 0; i < 100; ++i)
+            f.alloc_voice(i, 0, 0, 60, 100, 0);
+      f.process(BLOCK, out, reverb, chorus);
+      QCOMPARE(f.voiceStats().active, 100);
+
+      f.allSoundsOff(-1);
+      f.process(BLOCK, out, reverb, chorus);
+      VoiceStats stats = f.voiceStats();
+      QCOMPARE(stats.active, 0);
+      QCOMPARE(stats.maxActive, 100);
+
+      for (int i = 0; i < VOICES; ++i)
+            f.alloc_voice(100 + i, 0, 0, 60, 100, 0);
+      QCOMPARE(f.voiceStats().stolen, 0);
+      }
+
+//---------------------------------------------------------
+//   benchSteal
+//    chords at full polyphony, every note steals a voice
+//---------------------------------------------------------
+
+void TestVoices::benchSteal()
+      {
+      TestFluid f;
+      for (int i = 0; i < VOICES; ++i)
+            f.alloc_voice(i, 0, 0, 60, 100, 0);
+      unsigned id = VOICES;
+      QBENCHMARK {
+            for (int chord = 0; chord < 16; ++chord) {
+                  for (int note = 0; note < 10; ++note)
+                        f.alloc_voice(id++, 0, 0, 60 + note, 100, 0);
+                  f.process(BLOCK, out, reverb, chorus);
+                  }
+            }
+      }
+
+QTEST_MAIN(TestVoices)
+#include "tst_voices.moc"
@@ -88,6 +88,12 @@ class TestImportMidi : public QObject, public MTest
       void maxLevelBetween();
       void isSimpleDuration();
 
+      // fraction arithmetic
+      void reducedFraction();
+
+      // import time of all test files
+      void benchImport();
+
       // test scores for meter (duration subdivision)
       void meterTimeSig4_4() { mf("meter_4-4"); }
       void metertimeSig9_8() { mf("meter_9-8"); }
@@ -972,6 +978,54 @@ void TestImportMidi::isSimpleDuration()
       QVERIFY(!Meter::isSimpleNoteDuration({1, 5}));
       }
 
+//---------------------------------------------------------
+//  fraction arithmetic
+//---------------------------------------------------------
+
+void TestImportMidi::reducedFraction()
+      {
+      QVERIFY(ReducedFraction(1, 3) < ReducedFraction(1, 2));
+      QVERIFY(ReducedFraction(2, 6) == ReducedFraction(1, 3));
+      QVERIFY(ReducedFraction(-1, 3) < ReducedFraction(0, 1));
+      QVERIFY(ReducedFraction(7, 1920) != ReducedFraction(1, 274));
+      QVERIFY(ReducedFraction(100000, 3) > ReducedFraction(99999, 3));
+                  // cross products exceed the int range
+      QVERIFY(ReducedFraction(100003, 100000) > ReducedFraction(100001, 99999));
+      QVERIFY(ReducedFraction(100000, 100003) >= ReducedFraction(99999, 100002));
+
+      ReducedFraction sum(1, 4);
+      sum += ReducedFraction(1, 4);
+      QCOMPARE(sum, ReducedFraction(1, 2));
+      sum -= ReducedFraction(1, 3);
+      QCOMPARE(sum, ReducedFraction(1, 6));
+      sum += ReducedFraction(5, 6);
+      QCOMPARE(sum, ReducedFraction(1, 1));
+      QCOMPARE(ReducedFraction(-4, 6).reduced().numerator(), -2);
+      QCOMPARE(ReducedFraction(-4, 6).reduced().denominator(), 3);
+      QCOMPARE(ReducedFraction(7, 2).ticks(), MScore::division * 14);
+      }
+
+//---------------------------------------------------------
+//  benchImport
+//    tuplet search and quantization dominate the import
+//    of the dense test files
+//---------------------------------------------------------
+
+void TestImportMidi::benchImport()
+      {
+      const QStringList files = QDir(TESTROOT "/mtest/" + DIR).entryList(QStringList("*.mid"));
+      QVERIFY(!files.isEmpty());
+      QBENCHMARK {
+            for (const QString& name : files) {
+                  Score* score = new Score(mscore->baseStyle());
+                  score->setName(name);
+                  Score::FileError rv = importMidi(score, TESTROOT "/mtest/" + DIR + name);
+                  delete score;
+                  QCOMPARE(rv, Score::FileError::FILE_NO_ERROR);
+                  }
+            }
+      }
+
 
 QTEST_MAIN(TestImportMidi)
 
@@ -0,0 +1,241 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/symbol.h"
+#include "libmscore/bsp.h"
+
+using namespace Ms;
+
+static const int ELEMENTS = 10000;
+static const QRectF PAGE(0.0, 0.0, 2100.0, 2970.0);
+
+//---------------------------------------------------------
+//   TestBsp
+//    the spatial index of a page filled with
+//    10000 elements
+//---------------------------------------------------------
+
+class TestBsp : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QList<Element*> elements;
+      QList<QRectF> queries;
+
+      void moveElements(int n, qreal d);
+      static QSet<Element*> find(const QList<Element*>&, const QRectF&);
+      void verify(BspTree&);
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void query();
+      void update();
+      void sync();
+      void benchInsert();
+      void benchQuery();
+      void benchUpdate();
+      void benchSync();
+      void benchRebuild();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestBsp::initTestCase()
+      {
+      initMTest();
+      qsrand(1);
+      for (int i = 0; i < ELEMENTS; ++i) {
+            Symbol* s = new Symbol(score);
+            s->setbbox(QRectF(0.0, 0.0, 5.0 + qrand() % 30, 5.0 + qrand() % 30));
+            s->setPos(qrand() % 2060, qrand() % 2930);
+            elements.append(s);
+            }
+      for (int i = 0; i < 1000; ++i)
+            queries.append(QRectF(qrand() % 2000, qrand() % 2900, 10 + qrand() % 100, 10 + qrand() % 70));
+      }
+
+void TestBsp::cleanupTestCase()
+      {
+      qDeleteAll(elements);
+      }
+
+//---------------------------------------------------------
+//   moveElements
+//    move every (ELEMENTS/n)th element by d
+//---------------------------------------------------------
+
+void TestBsp::moveElements(int n, qreal d)
+      {
+      int step = ELEMENTS / n;
+      for (int i = 0; i < ELEMENTS; i += step)
+            elements[i]->setPos(elements[i]->pos() + QPointF(d, d));
+      }
+
+//---------------------------------------------------------
+//   find
+//    brute force reference
+//---------------------------------------------------------
+
+QSet<Element*> TestBsp::find(const QList<Element*>& el, const QRectF& r)
+      {
+      QSet<Element*> found;
+      for (Element* e : el) {
+            if (e->pageBoundingRect().intersects(r))
+                  found.insert(e);
+            }
+      return found;
+      }
+
+void TestBsp::verify(BspTree& tree)
+      {
+      for (const QRectF& r : queries)
+            QCOMPARE(tree.items(r).toSet(), find(elements, r));
+      }
+
+//---------------------------------------------------------
+//   query
+//---------------------------------------------------------
+
+void TestBsp::query()
+      {
+      BspTree tree;
+      tree.initialize(PAGE, ELEMENTS);
+      for (Element* e : elements)
+            tree.insert(e);
+      QCOMPARE(tree.count(), ELEMENTS);
+      verify(tree);
+      }
+
+//---------------------------------------------------------
+//   update
+//    moved and removed elements are found at their
+//    new place only
+//---------------------------------------------------------
+
+void TestBsp::update()
+      {
+      BspTree tree;
+      tree.initialize(PAGE, ELEMENTS);
+      for (Element* e : elements)
+            tree.insert(e);
+      moveElements(100, 40.0);
+      int moved = 0;
+      for (Element* e : elements)
+            moved += tree.update(e);
+      QCOMPARE(moved, 100);
+      verify(tree);
+
+      Element* e = elements.takeLast();
+      tree.remove(e);
+      QVERIFY(!tree.contains(e));
+      verify(tree);
+      elements.append(e);
+      moveElements(100, -40.0);
+      }
+
+//---------------------------------------------------------
+//   sync
+//---------------------------------------------------------
+
+void TestBsp::sync()
+      {
+      BspTree tree;
+      tree.initialize(PAGE, ELEMENTS);
+      for (Element* e : elements)
+            tree.insert(e);
+      QList<Element*> el = elements.mid(0, ELEMENTS - 100);
+      moveElements(10, 100.0);
+      tree.sync(el);
+      QCOMPARE(tree.count(), el.size());
+      for (const QRectF& r : queries)
+            QCOMPARE(tree.items(r).toSet(), find(el, r));
+      moveElements(10, -100.0);
+      }
+
+//---------------------------------------------------------
+//   benchmarks
+//---------------------------------------------------------
+
+void TestBsp::benchInsert()
+      {
+      BspTree tree;
+      QBENCHMARK {
+            tree.initialize(PAGE, ELEMENTS);
+            for (Element* e : elements)
+                  tree.insert(e);
+            }
+      }
+
+void TestBsp::benchQuery()
+      {
+      BspTree tree;
+      tree.initialize(PAGE, ELEMENTS);
+      for (Element* e : elements)
+            tree.insert(e);
+      QBENCHMARK {
+            for (const QRectF& r : queries)
+                  tree.items(r);
+            }
+      }
+
+void TestBsp::benchUpdate()
+      {
+      BspTree tree;
+      tree.initialize(PAGE, ELEMENTS);
+      for (Element* e : elements)
+            tree.insert(e);
+      qreal d = 10.0;
+      QBENCHMARK {                        // move 1% of the elements
+            moveElements(100, d);
+            int step = ELEMENTS / 100;
+            for (int i = 0; i < ELEMENTS; i += step)
+                  tree.update(elements[i]);
+            d = -d;
+            }
+      }
+
+void TestBsp::benchSync()
+      {
+      BspTree tree;
+      tree.initialize(PAGE, ELEMENTS);
+      for (Element* e : elements)
+            tree.insert(e);
+      qreal d = 10.0;
+      QBENCHMARK {                        // what a page relayout does now
+            moveElements(100, d);
+            tree.sync(elements);
+            d = -d;
+            }
+      }
+
+void TestBsp::benchRebuild()
+      {
+      BspTree tree;
+      qreal d = 10.0;
+      QBENCHMARK {                        // what a page relayout did before
+            moveElements(100, d);
+            tree.initialize(PAGE, ELEMENTS);
+            for (Element* e : elements)
+                  tree.insert(e);
+            d = -d;
+            }
+      }
+
+QTEST_MAIN(TestBsp)
+#include "tst_bsp.moc"
+
@@ -14,6 +14,9 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/system.h"
+#include "libmscore/page.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -33,12 +36,17 @@ class TestBenchmark : public QObject, public MTest
 
       Score* score;
       void beam(const char* path);
+      void compareLayout(Score* s1, Score* s2);
+      void checkIndex(Score* s);
 
    private slots:
       void initTestCase();
       void benchmark3();
       void benchmark1();
       void benchmark2();
+      void benchmark4();
+      void layoutRange_data();
+      void layoutRange();
       };
 
 //---------------------------------------------------------
@@ -82,6 +90,177 @@ void TestBenchmark::benchmark2()
             }
       }
 
+void TestBenchmark::benchmark4()
+      {
+      score->doLayout();
+      Measure* m = score->firstMeasure();
+      for (int i = 0; i < 20 && m->nextMeasure(); ++i)
+            m = m->nextMeasure();
+      QBENCHMARK {                        // incremental relayout of one measure
+            score->doLayoutRange(m->tick(), m->tick());
+            }
+      }
+
+//---------------------------------------------------------
+//   collectGeometry
+//---------------------------------------------------------
+
+static void collectGeometry(void* data, Element* e)
+      {
+      static_cast<QList<QRectF>*>(data)->append(e->canvasBoundingRect());
+      }
+
+static bool sameRect(const QRectF& r1, const QRectF& r2)
+      {
+      const qreal eps = 0.001;
+      return qAbs(r1.x() - r2.x()) < eps && qAbs(r1.y() - r2.y()) < eps
+         && qAbs(r1.width() - r2.width()) < eps && qAbs(r1.height() - r2.height()) < eps;
+      }
+
+//---------------------------------------------------------
+//   compareLayout
+//    same pages, same line breaks, every element at
+//    the same place
+//---------------------------------------------------------
+
+void TestBenchmark::compareLayout(Score* s1, Score* s2)
+      {
+      QCOMPARE(s1->pages().size(), s2->pages().size());
+      QCOMPARE(s1->systems()->size(), s2->systems()->size());
+      for (int i = 0; i < s1->systems()->size(); ++i) {
+            System* sys1 = s1->systems()->at(i);
+            System* sys2 = s2->systems()->at(i);
+            QCOMPARE(sys1->measures().size(), sys2->measures().size());
+            if (sys1->measures().isEmpty())
+                  continue;
+            QCOMPARE(sys1->measures().front()->tick(), sys2->measures().front()->tick());
+            QCOMPARE(s1->pages().indexOf(sys1->page()), s2->pages().indexOf(sys2->page()));
+            QVERIFY(sameRect(sys1->canvasBoundingRect(), sys2->canvasBoundingRect()));
+            }
+      QList<QRectF> g1, g2;
+      s1->scanElements(&g1, collectGeometry);
+      s2->scanElements(&g2, collectGeometry);
+      QCOMPARE(g1.size(), g2.size());
+      for (int i = 0; i < g1.size(); ++i)
+            QVERIFY2(sameRect(g1[i], g2[i]), qPrintable(QString("element %1").arg(i)));
+      }
+
+//---------------------------------------------------------
+//   pageElements
+//    all elements filed in the spatial index of page,
+//    sorted and without duplicates
+//---------------------------------------------------------
+
+static QList<Element*> sorted(QList<Element*> el)
+      {
+      std::sort(el.begin(), el.end());
+      el.erase(std::unique(el.begin(), el.end()), el.end());
+      return el;
+      }
+
+static QList<Element*> pageElements(Page* page)
+      {
+      QList<Element*> el;
+      for (System* s : *page->systems()) {
+            for (MeasureBase* m : s->measures())
+                  m->scanElements(&el, collectElements, false);
+            s->scanElements(&el, collectElements, false);
+            }
+      el.append(page);
+      return sorted(el);
+      }
+
+//---------------------------------------------------------
+//   checkIndex
+//    rect queries over every system and point queries at
+//    the center of every measure must find the same
+//    elements as a search through all elements of the page
+//---------------------------------------------------------
+
+void TestBenchmark::checkIndex(Score* s)
+      {
+      for (Page* page : s->pages()) {
+            QList<Element*> all = pageElements(page);
+            for (System* sys : *page->systems()) {
+                  QRectF r = sys->pageBoundingRect();
+                  QList<Element*> expected;
+                  for (Element* e : all) {
+                        if (e->pageBoundingRect().intersects(r))
+                              expected.append(e);
+                        }
+                  QList<Element*> found = sorted(page->items(r));
+                  QVERIFY2(found == expected, qPrintable(QString("page %1 system %2: %3 elements, expected %4")
+                     .arg(page->no()).arg(page->systems()->indexOf(sys)).arg(found.size()).arg(expected.size())));
+
+                  for (MeasureBase* m : sys->measures()) {
+                        QPointF p = m->pageBoundingRect().center();
+                        expected.clear();
+                        for (Element* e : all) {
+                              if (e->contains(p))
+                                    expected.append(e);
+                              }
+                        found = sorted(page->items(p));
+                        QVERIFY2(found == expected, qPrintable(QString("page %1 measure at tick %2: %3 elements, expected %4")
+                           .arg(page->no()).arg(m->tick()).arg(found.size()).arg(expected.size())));
+                        }
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   layoutRange
+//    doLayoutRange() after a change of a measure width
+//    must give the same layout as a full doLayout(); a
+//    wider measure pushes measures into the next systems,
+//    a narrower one pulls them back
+//---------------------------------------------------------
+
+void TestBenchmark::layoutRange_data()
+      {
+      QTest::addColumn<int>("measure");
+      QTest::addColumn<qreal>("stretch");
+      QTest::newRow("first wider")   << 0  << 3.0;
+      QTest::newRow("wider")         << 20 << 3.0;
+      QTest::newRow("narrower")      << 20 << 0.3;
+      QTest::newRow("last narrower") << -1 << 0.3;
+      }
+
+void TestBenchmark::layoutRange()
+      {
+      QFETCH(int, measure);
+      QFETCH(qreal, stretch);
+
+      Score* s1 = readScore(DIR + "goldberg.mscx");
+      Score* s2 = readScore(DIR + "goldberg.mscx");
+      s1->doLayout();
+      s2->doLayout();
+      for (Page* page : s1->pages())      // build the spatial index before the change
+            page->items(page->abbox());
+      Measure* m1 = measure < 0 ? s1->lastMeasure() : s1->firstMeasure();
+      Measure* m2 = measure < 0 ? s2->lastMeasure() : s2->firstMeasure();
+      for (int i = 0; i < measure && m1->nextMeasure(); ++i) {
+            m1 = m1->nextMeasure();
+            m2 = m2->nextMeasure();
+            }
+      m1->setUserStretch(stretch);
+      m2->setUserStretch(stretch);
+      s1->doLayoutRange(m1->tick(), m1->tick());
+      s2->doLayout();
+      compareLayout(s1, s2);
+      checkIndex(s1);
+
+      // and back
+      m1->setUserStretch(1.0);
+      m2->setUserStretch(1.0);
+      s1->doLayoutRange(m1->tick(), m1->tick());
+      s2->doLayout();
+      compareLayout(s1, s2);
+      checkIndex(s1);
+
+      delete s1;
+      delete s2;
+      }
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
 
@@ -0,0 +1,162 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/xml.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestLoad
+//    XmlReader helpers and load and save time of the
+//    mtest and vtest scores
+//---------------------------------------------------------
+
+class TestLoad : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QStringList files;
+
+   private slots:
+      void initTestCase();
+      void tags();
+      void readText();
+      void attributes();
+      void benchLoad();
+      void benchSave();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLoad::initTestCase()
+      {
+      initMTest();
+      for (const char* dir : { "/mtest", "/vtest" }) {
+            QDirIterator it(TESTROOT + QString(dir), QStringList() << "*.mscx" << "*.mscz",
+               QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                  files.append(it.next());
+            }
+      QVERIFY(!files.isEmpty());
+      }
+
+//---------------------------------------------------------
+//   tags
+//---------------------------------------------------------
+
+void TestLoad::tags()
+      {
+      XmlReader e(QByteArray("<Measure><Chord/><Note/><tpc2/><durationType/><tpc3/><chord/></Measure>"));
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.tag(), Tag::Unknown);
+      Tag expected[] = { Tag::Chord, Tag::Note, Tag::tpc2, Tag::durationType, Tag::Unknown, Tag::Unknown };
+      for (Tag t : expected) {
+            QVERIFY(e.readNextStartElement());
+            QCOMPARE(e.tag(), t);
+            e.skipCurrentElement();
+            }
+      }
+
+//---------------------------------------------------------
+//   readText
+//    readInt() and friends reuse the reader's buffer
+//    but must read the same values as readElementText()
+//---------------------------------------------------------
+
+void TestLoad::readText()
+      {
+      XmlReader e(QByteArray("<a><i>42</i><d> 2.5</d><b>1</b><c>1<!-- x -->2&amp;3</c><n/><x><y/></x></a>"));
+      QVERIFY(e.readNextStartElement());
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readInt(), 42);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readDouble(), 2.5);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readBool(), true);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readText(), QString("12&3"));
+      QVERIFY(e.readNextStartElement());
+      bool ok;
+      e.readInt(&ok);
+      QVERIFY(!ok);
+      QVERIFY(e.readNextStartElement());
+      e.readText();
+      QVERIFY(e.hasError());
+      }
+
+//---------------------------------------------------------
+//   attributes
+//---------------------------------------------------------
+
+void TestLoad::attributes()
+      {
+      XmlReader e(QByteArray("<Note pitch=\"60\" len=\"3/4\" scale=\"0.5\"/>"));
+      QVERIFY(e.readNextStartElement());
+      QVERIFY(e.hasAttribute("pitch"));
+      QVERIFY(!e.hasAttribute("tpc"));
+      QCOMPARE(e.intAttribute("pitch"), 60);
+      QCOMPARE(e.intAttribute("tpc", 14), 14);
+      QCOMPARE(e.doubleAttribute("scale"), 0.5);
+      QCOMPARE(e.attribute("len"), QString("3/4"));
+      QCOMPARE(e.attribute("type", "auto"), QString("auto"));
+      }
+
+//---------------------------------------------------------
+//   benchLoad
+//    read all scores of the test corpus
+//---------------------------------------------------------
+
+void TestLoad::benchLoad()
+      {
+      QBENCHMARK {
+            for (const QString& path : files) {
+                  Score* s = new Score(mscore->baseStyle());
+                  s->setName(path);
+                  s->loadMsc(path, false);
+                  delete s;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   benchSave
+//    write all scores of the test corpus
+//---------------------------------------------------------
+
+void TestLoad::benchSave()
+      {
+      QList<Score*> scores;
+      for (const QString& path : files) {
+            Score* s = new Score(mscore->baseStyle());
+            s->setName(path);
+            if (s->loadMsc(path, false) == Score::FileError::FILE_NO_ERROR)
+                  scores.append(s);
+            else
+                  delete s;
+            }
+      QBENCHMARK {
+            for (Score* s : scores) {
+                  QBuffer buffer;
+                  buffer.open(QIODevice::WriteOnly);
+                  s->saveFile(&buffer, false);
+                  }
+            }
+      qDeleteAll(scores);
+      }
+
+QTEST_MAIN(TestLoad)
+#include "tst_load.moc"
@@ -0,0 +1,170 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+
+using namespace Ms;
+
+static const double dpis[] = { 72.0, 150.0 };
+
+//---------------------------------------------------------
+//   RenderJob
+//    one page at all resolutions, like png export does
+//---------------------------------------------------------
+
+struct RenderJob {
+      Page* page;
+      QList<const Element*> elements;
+      QByteArray png[2];
+      };
+
+//---------------------------------------------------------
+//   TestRender
+//    page rasterization as done by png export and
+//    its throughput over the vtest scores
+//---------------------------------------------------------
+
+class TestRender : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QList<Score*> scores;
+      QVector<RenderJob> jobs;
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void render();
+      void parallel();
+      void benchRender_data();
+      void benchRender();
+      };
+
+//---------------------------------------------------------
+//   renderJob
+//---------------------------------------------------------
+
+static void renderJob(RenderJob& job)
+      {
+      for (int i = 0; i < 2; ++i) {
+            QImage image = job.page->render(job.elements, dpis[i], false, QImage::Format_Indexed8);
+            QBuffer buffer(&job.png[i]);
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "png");
+            }
+      }
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestRender::initTestCase()
+      {
+      initMTest();
+      QDirIterator it(TESTROOT "/vtest", QStringList("*.mscz"), QDir::Files);
+      while (it.hasNext()) {
+            Score* score = readCreatedScore(it.next());
+            if (!score)
+                  continue;
+            score->doLayout();
+            score->setPrinting(true);
+            scores.append(score);
+            for (Page* page : score->pages())
+                  jobs.append({ page, page->elements(), { QByteArray(), QByteArray() } });
+            }
+      QVERIFY(!jobs.isEmpty());
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestRender::cleanupTestCase()
+      {
+      qDeleteAll(scores);
+      }
+
+//---------------------------------------------------------
+//   render
+//---------------------------------------------------------
+
+void TestRender::render()
+      {
+      Page* page = jobs.first().page;
+      const QList<const Element*>& el = jobs.first().elements;
+      QImage image = page->render(el, 300, true, QImage::Format_ARGB32_Premultiplied);
+      QCOMPARE(image.width(), int(lrint(page->abbox().width() * 300 / MScore::DPI)));
+      QCOMPARE(image.height(), int(lrint(page->abbox().height() * 300 / MScore::DPI)));
+      QCOMPARE(image.dotsPerMeterX(), int(lrint(300 * 1000 / INCH)));
+      QCOMPARE(image.format(), QImage::Format_ARGB32_Premultiplied);
+
+      image = page->render(el, 72, false, QImage::Format_Indexed8);
+      QCOMPARE(image.format(), QImage::Format_Indexed8);
+      QCOMPARE(image.colorCount(), 256);
+      QCOMPARE(image.pixelIndex(0, 0), 255);          // white paper
+      }
+
+//---------------------------------------------------------
+//   parallel
+//    pages rendered at the same time must give the
+//    same images as pages rendered one after another
+//---------------------------------------------------------
+
+void TestRender::parallel()
+      {
+      if (!QFontDatabase::supportsThreadedFontRendering())
+            QSKIP("no threaded font rendering");
+      QVector<RenderJob> serial = jobs;
+      for (RenderJob& job : serial)
+            renderJob(job);
+      QVector<RenderJob> concurrent = jobs;
+      QtConcurrent::blockingMap(concurrent, renderJob);
+      for (int i = 0; i < jobs.size(); ++i) {
+            QVERIFY(serial[i].png[0] == concurrent[i].png[0]);
+            QVERIFY(serial[i].png[1] == concurrent[i].png[1]);
+            }
+      }
+
+//---------------------------------------------------------
+//   benchRender
+//    rasterize and png encode all pages of the vtest
+//    scores at 72 and 150 dpi
+//---------------------------------------------------------
+
+void TestRender::benchRender_data()
+      {
+      QTest::addColumn<bool>("threads");
+      QTest::newRow("serial")   << false;
+      QTest::newRow("parallel") << true;
+      }
+
+void TestRender::benchRender()
+      {
+      QFETCH(bool, threads);
+      if (threads && !QFontDatabase::supportsThreadedFontRendering())
+            QSKIP("no threaded font rendering");
+      QVector<RenderJob> j = jobs;
+      QBENCHMARK {
+            if (threads)
+                  QtConcurrent::blockingMap(j, renderJob);
+            else {
+                  for (RenderJob& job : j)
+                        renderJob(job);
+                  }
+            }
+      }
+
+QTEST_MAIN(TestRender)
+#include "tst_render.moc"
@@ -16,6 +16,7 @@
 #include "libmscore/score.h"
 #include "libmscore/measure.h"
 #include "libmscore/repeatlist.h"
+#include "libmscore/tempo.h"
 
 #define DIR QString("libmscore/repeat/")
 
@@ -47,6 +48,7 @@ class TestRepeat : public QObject, public MTest
       void repeat12() { repeat("repeat12.mscx", "1;2;3;4;3;5;6;2;3;5;6;7"); }
       void repeat13() { repeat("repeat13.mscx", "1;2;3;4;5"); }
       void repeat14() { repeat("repeat14.mscx", "1;2;3;4;5;6;7;8;9;10; 2;3;4;5;6;7;8;11;12; 2;3;4;5;6;7;8;13;14;15; 16;17;18; 16;17;18; 19;20;21;22;23; 5;6;7; 24;25;26"); }
+      void timeTable();
       };
 
 
@@ -87,6 +89,43 @@ void TestRepeat::repeat(const char* f1, const QString & ref)
       delete score;
       }
 
+//---------------------------------------------------------
+//   timeTable
+//    utick <-> utime conversion of the repeat list
+//    against the tempo map
+//---------------------------------------------------------
+
+void TestRepeat::timeTable()
+      {
+      Score* score = readScore(DIR + "repeat14.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      TempoMap* tm = score->tempomap();
+      tm->setTempo(MScore::division * 6, 3.0);
+      tm->setTempo(MScore::division * 21, 1.5);
+      tm->setTempo(MScore::division * 50, 2.5);
+      score->updateRepeatList(true);
+      RepeatList* rl = score->repeatList();
+
+      for (int utick = 0; utick < rl->ticks(); utick += MScore::division / 4) {
+            const RepeatSegment* rs = 0;
+            foreach (const RepeatSegment* s, *rl) {
+                  if (utick >= s->utick)
+                        rs = s;
+                  }
+            QVERIFY(rs);
+            qreal time = tm->tick2time(utick - rs->utick + rs->tick) + rs->timeOffset;
+            QCOMPARE(rl->utick2utime(utick), time);
+            QCOMPARE(rl->utime2utick(time), utick);
+            }
+
+      // the table follows tempo changes
+      qreal t1 = rl->utick2utime(MScore::division * 8);
+      tm->setRelTempo(2.0);
+      rl->update();
+      QCOMPARE(rl->utick2utime(MScore::division * 8), t1 / 2.0);
+      delete score;
+      }
 
 QTEST_MAIN(TestRepeat)
 #include "tst_repeat.moc"
@@ -34,6 +34,7 @@ class TestText : public QObject, public MTest
       void testSpecialSymbols();
       void testTextProperties();
       void testCompatibility();
+      void testLayoutCache();
       };
 
 //---------------------------------------------------------
@@ -296,6 +297,42 @@ void TestText::testCompatibility() {
 
 }
 
+//---------------------------------------------------------
+///   testLayoutCache
+///   the parsed text is reused until text or style change
+//---------------------------------------------------------
+
+void TestText::testLayoutCache()
+      {
+      Text* text = new Text(score);
+      text->setTextStyle(score->textStyle(TextStyleType::STAFF));
+      text->setText("a<b>b</b><sym>segno</sym>");
+      text->layout();
+      QRectF bb = text->bbox();
+
+      Text::resetLayoutStats();
+      text->layout();
+      TextLayoutStats s = Text::layoutStats();
+      QCOMPARE(s.layoutHits, 1);
+      QCOMPARE(s.layoutMisses, 0);
+      QCOMPARE(s.fontMisses, 0);
+      QCOMPARE(text->bbox(), bb);
+
+      text->setText("a<b>b</b>c");
+      text->layout();
+      QCOMPARE(Text::layoutStats().layoutMisses, 1);
+      QVERIFY(text->bbox() != bb);
+
+      text->textStyle().setSize(text->textStyle().size() * 2);
+      text->layout();
+      QCOMPARE(Text::layoutStats().layoutMisses, 2);
+
+      text->setEditMode(true);
+      text->setEditMode(false);
+      text->layout();
+      QCOMPARE(Text::layoutStats().layoutMisses, 3);
+      delete text;
+      }
 
 QTEST_MAIN(TestText)
 
@@ -0,0 +1,223 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "libmscore/score.h"
+#include "libmscore/undo.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "synthesizer/event.h"
+#include "mtest/testutils.h"
+
+#define DIR QString("libmscore/undo/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestUndo
+//    memory accounting and limits of the undo stack
+//---------------------------------------------------------
+
+class TestUndo : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      int undoLimit;
+      qint64 undoMemoryLimit;
+
+      int measures(Score*);
+      void insertMeasure(Score*, int idx);
+      void removeMeasure(Score*, int idx);
+
+   private slots:
+      void initTestCase();
+      void cleanup();
+      void memoryUsage();
+      void stepLimit();
+      void memoryLimit();
+      void dropRedo();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestUndo::initTestCase()
+      {
+      initMTest();
+      undoLimit       = MScore::undoLimit;
+      undoMemoryLimit = MScore::undoMemoryLimit;
+      }
+
+//---------------------------------------------------------
+//   cleanup
+//---------------------------------------------------------
+
+void TestUndo::cleanup()
+      {
+      MScore::undoLimit       = undoLimit;
+      MScore::undoMemoryLimit = undoMemoryLimit;
+      }
+
+//---------------------------------------------------------
+//   helpers
+//---------------------------------------------------------
+
+int TestUndo::measures(Score* score)
+      {
+      int n = 0;
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure())
+            ++n;
+      return n;
+      }
+
+void TestUndo::insertMeasure(Score* score, int idx)
+      {
+      Measure* m = score->firstMeasure();
+      for (int i = 0; i < idx; ++i)
+            m = m->nextMeasure();
+      score->startCmd();
+      score->insertMeasure(ElementType::MEASURE, m);
+      score->endCmd();
+      }
+
+void TestUndo::removeMeasure(Score* score, int idx)
+      {
+      Measure* m = score->firstMeasure();
+      for (int i = 0; i < idx; ++i)
+            m = m->nextMeasure();
+      score->startCmd();
+      score->undoRemoveMeasures(m, m);
+      score->endCmd();
+      }
+
+//---------------------------------------------------------
+//   memoryUsage
+//    every step is counted, a step which took a measure
+//    out of the score includes the measure
+//---------------------------------------------------------
+
+void TestUndo::memoryUsage()
+      {
+      MScore::undoLimit       = 0;
+      MScore::undoMemoryLimit = 0;
+      Score* score = readScore(DIR + "undo-1.mscx");
+      score->doLayout();
+      UndoStack* undo = score->undo();
+
+      insertMeasure(score, 1);
+      insertMeasure(score, 2);
+      removeMeasure(score, 3);
+      QCOMPARE(undo->count(), 3);
+      qint64 sum = 0;
+      for (int i = 0; i < undo->count(); ++i) {
+            QVERIFY(undo->memoryUsage(i) > 0);
+            sum += undo->memoryUsage(i);
+            }
+      QCOMPARE(undo->memoryUsage(), sum);
+      QVERIFY(undo->memoryUsage(2) >= int(sizeof(Measure) + sizeof(Segment)));
+      QVERIFY(undo->memoryUsage(2) > undo->memoryUsage(1));
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   stepLimit
+//    only the newest undoLimit steps can be undone
+//---------------------------------------------------------
+
+void TestUndo::stepLimit()
+      {
+      MScore::undoLimit = 2;
+      Score* score = readScore(DIR + "undo-1.mscx");
+      score->doLayout();
+      UndoStack* undo = score->undo();
+      int n = measures(score);
+
+      for (int i = 0; i < 4; ++i)
+            insertMeasure(score, 1);
+      QCOMPARE(undo->count(), 2);
+      QCOMPARE(measures(score), n + 4);
+      undo->undo();
+      undo->undo();
+      QVERIFY(!undo->canUndo());
+      QCOMPARE(measures(score), n + 2);
+      undo->redo();
+      undo->redo();
+      QVERIFY(!undo->canRedo());
+      QCOMPARE(measures(score), n + 4);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   memoryLimit
+//    the newest step is kept even if it alone exceeds
+//    the limit
+//---------------------------------------------------------
+
+void TestUndo::memoryLimit()
+      {
+      MScore::undoMemoryLimit = 1;
+      Score* score = readScore(DIR + "undo-1.mscx");
+      score->doLayout();
+      UndoStack* undo = score->undo();
+      int n = measures(score);
+
+      insertMeasure(score, 1);
+      removeMeasure(score, 2);
+      insertMeasure(score, 3);
+      QCOMPARE(undo->count(), 1);
+      QCOMPARE(undo->memoryUsage(), qint64(undo->memoryUsage(0)));
+      undo->undo();
+      QVERIFY(!undo->canUndo());
+      QCOMPARE(measures(score), n);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   dropRedo
+//    undo, edit (drops the redo step), play and trim;
+//    elements of dropped steps stay valid and the score
+//    is still intact
+//---------------------------------------------------------
+
+void TestUndo::dropRedo()
+      {
+      MScore::undoLimit = 1;
+      Score* score = readScore(DIR + "undo-1.mscx");
+      score->doLayout();
+      UndoStack* undo = score->undo();
+      EventMap events;
+
+      removeMeasure(score, 2);
+      undo->undo();
+      score->doLayout();
+      score->renderMidi(&events);
+
+      insertMeasure(score, 3);            // drops the undone removal
+      QCOMPARE(undo->count(), 1);
+      QVERIFY(!undo->canRedo());
+      events.clear();
+      score->renderMidi(&events);
+
+      insertMeasure(score, 5);            // trims the first insertion
+      QCOMPARE(undo->count(), 1);
+      undo->undo();
+      QVERIFY(!undo->canUndo());
+      score->doLayout();
+      events.clear();
+      score->renderMidi(&events);
+      QVERIFY(saveCompareScore(score, "undo-1.mscx", DIR + "undo-1-ref.mscx"));
+      delete score;
+      }
+
+QTEST_MAIN(TestUndo)
+#include "tst_undo.moc"
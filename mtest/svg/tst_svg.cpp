@@ -0,0 +1,185 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "mscore/svggenerator.h"
+
+#define DIR QString("libmscore/layout/")
+
+using namespace Ms;
+
+namespace Ms {
+extern bool saveSvg(Score*, const QString& name, double dpi, int firstPage, int lastPage, bool parallel);
+}
+
+//---------------------------------------------------------
+//   TestSvg
+//---------------------------------------------------------
+
+class TestSvg : public QObject, public MTest
+      {
+      Q_OBJECT
+
+   private slots:
+      void initTestCase();
+      void parallel();
+      void gradientIds();
+      void pageRange();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSvg::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   readFile
+//---------------------------------------------------------
+
+static QByteArray readFile(const QString& path)
+      {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly))
+            return QByteArray();
+      return f.readAll();
+      }
+
+//---------------------------------------------------------
+//   ids
+//    all values of id attributes in svg, matching pattern
+//---------------------------------------------------------
+
+static QStringList ids(const QString& svg, const QString& pattern = QString("<\\w+ [^>]*id=\"([^\"]+)\""))
+      {
+      QStringList l;
+      QRegExp rx(pattern);
+      for (int pos = 0; (pos = rx.indexIn(svg, pos)) != -1; pos += rx.matchedLength())
+            l.append(rx.cap(1));
+      return l;
+      }
+
+//---------------------------------------------------------
+//   parallel
+//    a multi page score exported with pages painted on
+//    the thread pool is the same file as a serial export,
+//    no id occurs twice
+//---------------------------------------------------------
+
+void TestSvg::parallel()
+      {
+      Score* score = readScore(DIR + "goldberg.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      QVERIFY(score->pages().size() > 1);
+
+      QVERIFY(saveSvg(score, "svg-serial.svg", 72.0, 0, -1, false));
+      QVERIFY(saveSvg(score, "svg-parallel.svg", 72.0, 0, -1, true));
+      QByteArray serial   = readFile("svg-serial.svg");
+      QByteArray parallel = readFile("svg-parallel.svg");
+      QVERIFY(!serial.isEmpty());
+      QVERIFY(serial == parallel);
+
+      QStringList l = ids(QString::fromUtf8(parallel));
+      QCOMPARE(l.toSet().size(), l.size());
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   gradientIds
+//    score elements do not paint gradients; fragments
+//    painted concurrently with the page id prefixes of
+//    saveSvg() must still give unique gradient ids, and
+//    every gradient reference must resolve
+//---------------------------------------------------------
+
+void TestSvg::gradientIds()
+      {
+      const int pages = 8;
+      QVector<QByteArray> fragments(pages);
+      QVector<int> numbers(pages);
+      for (int i = 0; i < pages; ++i)
+            numbers[i] = i;
+
+      auto paint = [&fragments](int pageNumber) {
+            SvgGenerator printer;
+            printer.setFragment(true);
+            printer.setIdPrefix(QString("p%1-").arg(pageNumber + 1));
+            QBuffer buffer(&fragments[pageNumber]);
+            printer.setOutputDevice(&buffer);
+            printer.setSize(QSize(100, 100));
+            printer.setViewBox(QRectF(0.0, 0.0, 100.0, 100.0));
+            QPainter p(&printer);
+            QLinearGradient lg(0.0, 0.0, 100.0, 0.0);
+            lg.setColorAt(0.0, Qt::black);
+            lg.setColorAt(1.0, Qt::white);
+            p.fillRect(QRectF(0.0, 0.0, 50.0, 50.0), lg);
+            QRadialGradient rg(50.0, 50.0, 20.0);
+            rg.setColorAt(0.0, Qt::red);
+            rg.setColorAt(1.0, Qt::blue);
+            p.fillRect(QRectF(50.0, 50.0, 50.0, 50.0), rg);
+            p.end();
+            };
+      QtConcurrent::blockingMap(numbers, paint);
+
+      SvgGenerator document;
+      document.setSize(QSize(100 * pages, 100));
+      document.setViewBox(QRectF(0.0, 0.0, 100.0 * pages, 100.0));
+      QString svg = document.header();
+      for (const QByteArray& fragment : fragments)
+            svg += QString::fromUtf8(fragment);
+      svg += document.footer();
+
+      QStringList gradients = ids(svg, "<(?:linear|radial)Gradient [^>]*id=\"([^\"]+)\"");
+      QCOMPARE(gradients.size(), pages * 2);
+      QCOMPARE(gradients.toSet().size(), gradients.size());
+      QStringList refs = ids(svg, "url\\(#([^)]+)\\)");
+      QVERIFY(!refs.isEmpty());
+      for (const QString& ref : refs)
+            QVERIFY2(gradients.contains(ref), qPrintable(ref));
+      }
+
+//---------------------------------------------------------
+//   pageRange
+//    a page range writes one file per page; a range
+//    without a page of the score fails
+//---------------------------------------------------------
+
+void TestSvg::pageRange()
+      {
+      Score* score = readScore(DIR + "goldberg.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      int pages = score->pages().size();
+      int padding = QString("%1").arg(pages).size();
+      QString page1 = QString("svg-range-%1.svg").arg(1, padding, 10, QLatin1Char('0'));
+      QString page2 = QString("svg-range-%1.svg").arg(2, padding, 10, QLatin1Char('0'));
+      QFile::remove(page1);
+      QFile::remove(page2);
+
+      QVERIFY(saveSvg(score, "svg-range.svg", 72.0, 0, 1, true));
+      QVERIFY(QFile::exists(page1));
+      QVERIFY(QFile::exists(page2));
+
+      QVERIFY(!saveSvg(score, "svg-range.svg", 72.0, pages, pages + 1, true));
+      QVERIFY(!saveSvg(score, "svg-range.svg", 72.0, 1, 0, true));
+      delete score;
+      }
+
+QTEST_MAIN(TestSvg)
+#include "tst_svg.moc"
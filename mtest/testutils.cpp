@@ -290,5 +290,54 @@ void MTest::initMTest()
       loadInstrumentTemplates(":/instruments.xml");
       score = readScore("/test.mscx");
       }
+
+//---------------------------------------------------------
+//   initNoise
+//    restart the noise so every test run sees the same
+//    data
+//---------------------------------------------------------
+
+void initNoise()
+      {
+      qsrand(1);
+      }
+
+//---------------------------------------------------------
+//   fillNoise
+//---------------------------------------------------------
+
+void fillNoise(short* data, int n)
+      {
+      for (int i = 0; i < n; ++i)
+            data[i] = short(qrand() - RAND_MAX / 2);
+      }
+
+void fillNoise(float* data, int n, float offset, float scale)
+      {
+      for (int i = 0; i < n; ++i)
+            data[i] = (float(qrand()) / RAND_MAX + offset) * scale;
+      }
+
+//---------------------------------------------------------
+//   sameSamples
+//    scalar and SIMD kernels must be bit identical
+//---------------------------------------------------------
+
+bool sameSamples(const float* a, const float* b, int n)
+      {
+      return memcmp(a, b, n * sizeof(float)) == 0;
+      }
+
+//---------------------------------------------------------
+//   simdData
+//    data rows for benchmarks run with both kernels
+//---------------------------------------------------------
+
+void simdData()
+      {
+      QTest::addColumn<bool>("simd");
+      QTest::newRow("scalar") << false;
+      QTest::newRow("simd")   << true;
+      }
 }
 
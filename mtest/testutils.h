@@ -42,6 +42,17 @@ class MTest {
       Ms::Element* writeReadElement(Ms::Element* element);
       void initMTest();
       };
+
+//---------------------------------------------------------
+//   helpers for the tests of the scalar and SIMD
+//   dsp kernels
+//---------------------------------------------------------
+
+extern void initNoise();
+extern void fillNoise(short* data, int n);
+extern void fillNoise(float* data, int n, float offset, float scale = 1.0);
+extern bool sameSamples(const float* a, const float* b, int n);
+extern void simdData();
 }
 
 #endif
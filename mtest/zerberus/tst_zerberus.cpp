@@ -0,0 +1,245 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "zerberus/dsp.h"
+#include "zerberus/zerberus.h"
+#include "zerberus/channel.h"
+#include "zerberus/zone.h"
+#include "zerberus/sample.h"
+#include "mtest/testutils.h"
+
+static const int FRAMES = 1 << 16;      // stereo frames of the test sample
+static const int BLOCK  = 64;
+static const int VOICES = 256;
+
+//---------------------------------------------------------
+//   TestZerberus
+//    compares the SIMD kernels of the zerberus voice
+//    render path against the scalar loops
+//---------------------------------------------------------
+
+class TestZerberus : public QObject
+      {
+      Q_OBJECT
+
+      short data[FRAMES * 2];
+      float coeff[INTERP_MAX][4];
+
+      void compare(int channels);
+
+   private slots:
+      void initTestCase();
+      void mono()       { compare(1); }
+      void stereo()     { compare(2); }
+      void mix();
+      void filter();
+      void attack_data();
+      void attack();
+      void benchVoices_data();
+      void benchVoices();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestZerberus::initTestCase()
+      {
+      Ms::initNoise();
+      Ms::fillNoise(data, FRAMES * 2);
+      Ms::fillNoise(coeff[0], INTERP_MAX * 4, -0.25, 1.0 / 32768.0);
+      }
+
+//---------------------------------------------------------
+//   compare
+//    interpolate the whole sample in odd sized blocks with
+//    the scalar and the SIMD kernel, results must be bit
+//    identical
+//---------------------------------------------------------
+
+void TestZerberus::compare(int channels)
+      {
+      const int n = BLOCK - 3;
+      Phase incr;
+      incr.set(1.37);
+      Phase p1(4 * 256 + 77);
+      Phase p2 = p1;
+      float a1 = 0.1;
+      float a2 = a1;
+      float l1[n], r1[n], l2[n], r2[n];
+      // incr.index() rounds the increment down, bound the block by its
+      // exact length plus the interpolation points behind the phase
+      while (p1.index() + (incr.data * n >> 8) + 4 < FRAMES) {
+            dspInterpolate(data, channels, coeff, p1, incr, a1, 1e-4, l1, r1, n, false);
+            dspInterpolate(data, channels, coeff, p2, incr, a2, 1e-4, l2, r2, n, true);
+            QCOMPARE(p1.data, p2.data);
+            QVERIFY(a1 == a2);
+            QVERIFY(Ms::sameSamples(l1, l2, n));
+            if (channels == 2)
+                  QVERIFY(Ms::sameSamples(r1, r2, n));
+            }
+      }
+
+//---------------------------------------------------------
+//   mix
+//---------------------------------------------------------
+
+void TestZerberus::mix()
+      {
+      const int n = BLOCK + 3;
+      float l[n], r[n];
+      for (int i = 0; i < n; ++i) {
+            l[i] = data[i] / 32768.0;
+            r[i] = data[n + i] / 32768.0;
+            }
+      float out[2][n * 2];
+      for (int k = 0; k < 2; ++k) {
+            for (int i = 0; i < n * 2; ++i)
+                  out[k][i] = data[2 * n + i] / 32768.0;
+            dspMix(l, r, n, 0.3, 0.7, out[k], k == 1);
+            }
+      QVERIFY(Ms::sameSamples(out[0], out[1], n * 2));
+      }
+
+//---------------------------------------------------------
+//   filter
+//    a block run continues exactly like the sample by
+//    sample filter
+//---------------------------------------------------------
+
+void TestZerberus::filter()
+      {
+      Biquad f { 0.2, 0.4, -0.5, 0.25 };
+      float buf[BLOCK];
+      float ref[BLOCK];
+      for (int i = 0; i < BLOCK; ++i)
+            buf[i] = data[i] / 32768.0;
+      float h1 = 0.0, h2 = 0.0;
+      for (int i = 0; i < BLOCK; ++i)
+            ref[i] = f(buf[i], h1, h2);
+      float g1 = 0.0, g2 = 0.0;
+      dspFilter(buf, BLOCK / 2, f, g1, g2);
+      dspFilter(buf + BLOCK / 2, BLOCK / 2, f, g1, g2);
+      QVERIFY(Ms::sameSamples(buf, ref, BLOCK));
+      QVERIFY(g1 == h1 && g2 == h2);
+      }
+
+//---------------------------------------------------------
+//   attack
+//    the first block of a note-on must follow the per
+//    sample attack envelope: a stereo voice plays a
+//    constant sample, the reference applies the envelope
+//    sample by sample and runs the voice filter
+//---------------------------------------------------------
+
+void TestZerberus::attack_data()
+      {
+      QTest::addColumn<int>("sampleRate");
+      QTest::newRow("44100") << 44100;
+      QTest::newRow("96000") << 96000;
+      }
+
+void TestZerberus::attack()
+      {
+      QFETCH(int, sampleRate);
+
+      const int frames = 4096;
+      const short value = 16384;
+      short* buf = new short[(frames + 4) * 2];
+      for (int i = 0; i < (frames + 4) * 2; ++i)
+            buf[i] = value;
+      Zerberus z;
+      z.init(sampleRate);
+      Channel c(&z, 0);
+      Zone zone;
+      zone.sample = new Sample(2, buf, frames, 44100);      // owned by the zone
+      Voice v(&z);
+      v.start(&c, zone.keyBase, 127, &zone);
+      float out[BLOCK * 2];
+      memset(out, 0, sizeof(out));
+      v.process(BLOCK, out);
+
+      // reference: gain 0.5 at full velocity, the
+      // interpolation of the constant sample gives 0.5
+      float x = 0.5 * 0.5 * c.gain();
+      float fres = qMin(z.ct2hz(13500.0), 0.45 * sampleRate);
+      float qLin  = pow(10.0f, (100.0 / 10.0f - 3.01f) / 20.0f);
+      float omega = 2.0f * M_PI * (fres / sampleRate);
+      float alpha = sin(omega) / (2.0f * qLin);
+      float a0Inv = 1.0f / (1.0f + alpha);
+      float b1    = (1.0f - cos(omega)) * a0Inv * (1.0 / sqrt(qLin));
+      Biquad f { b1 * 0.5f, b1, -2.0f * float(cos(omega)) * a0Inv, (1.0f - alpha) * a0Inv };
+
+      int steps = sampleRate / 1000;
+      float h1 = 0.0, h2 = 0.0;
+      for (int i = 0; i < BLOCK; ++i) {
+            int count = steps - i - 1;
+            float env = count >= 0 ? Envelope::egLin[EG_SIZE * count / steps] : 1.0;
+            float ref = f(x * env, h1, h2) * c.panLeftGain();
+            QVERIFY2(qAbs(out[i * 2] - ref) < x * 4.0 / EG_SIZE,
+               qPrintable(QString("frame %1: %2 expected %3").arg(i).arg(out[i * 2]).arg(ref)));
+            QVERIFY(qAbs(out[i * 2 + 1] - out[i * 2] * c.panRightGain() / c.panLeftGain()) < 1e-5);
+            }
+      }
+
+//---------------------------------------------------------
+//   benchVoices
+//    renders one second of VOICES voices, half of them
+//    stereo, through interpolation, filter and mix
+//---------------------------------------------------------
+
+void TestZerberus::benchVoices_data()
+      {
+      Ms::simdData();
+      }
+
+void TestZerberus::benchVoices()
+      {
+      QFETCH(bool, simd);
+
+      struct V {
+            Phase phase, incr;
+            float hist[4];
+            };
+      V voices[VOICES];
+      for (int i = 0; i < VOICES; ++i) {
+            voices[i].phase.set(4);
+            voices[i].incr.set(0.5 + double(i) / VOICES);
+            memset(voices[i].hist, 0, sizeof(voices[i].hist));
+            }
+      Biquad f { 0.2, 0.4, -0.5, 0.25 };
+      float l[BLOCK], r[BLOCK];
+      static float out[BLOCK * 2];
+
+      QBENCHMARK {
+            for (int block = 0; block < 44100 / BLOCK; ++block) {
+                  memset(out, 0, sizeof(out));
+                  for (int i = 0; i < VOICES; ++i) {
+                        V& v       = voices[i];
+                        int ch     = 1 + (i & 1);
+                        float amp  = 0.01;
+                        float* rb  = ch == 1 ? 0 : r;
+                        if (v.phase.index() + (v.incr.data * BLOCK >> 8) + 4 >= FRAMES)
+                              v.phase.set(4);
+                        dspInterpolate(data, ch, coeff, v.phase, v.incr, amp, 1e-6, l, rb, BLOCK, simd);
+                        dspFilter(l, BLOCK, f, v.hist[0], v.hist[1]);
+                        if (rb)
+                              dspFilter(rb, BLOCK, f, v.hist[2], v.hist[3]);
+                        dspMix(l, rb ? rb : l, BLOCK, 0.7, 0.6, out, simd);
+                        }
+                  }
+            }
+      }
+
+QTEST_MAIN(TestZerberus)
+#include "tst_zerberus.moc"
@@ -340,5 +340,88 @@ void EventList::insert(const Event& e)
             }
       append(e);
       }
+
+//---------------------------------------------------------
+//   sort
+//---------------------------------------------------------
+
+void EventMap::sort() const
+      {
+      if (_sorted)
+            return;
+      std::stable_sort(_events.begin(), _events.end(),
+         [](const value_type& a, const value_type& b) { return a.first < b.first; });
+      _sorted = true;
+      }
+
+//---------------------------------------------------------
+//   append
+//    bulk insert the events of m shifted by tickOffset
+//---------------------------------------------------------
+
+void EventMap::append(const EventMap& m, int tickOffset)
+      {
+      if (m.empty())
+            return;
+      m.sort();
+      if (!_events.empty() && m._events.front().first + tickOffset < _events.back().first)
+            _sorted = false;
+      _events.reserve(_events.size() + m._events.size());
+      for (const value_type& e : m._events)
+            _events.push_back(value_type(e.first + tickOffset, e.second));
+      }
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void EventMap::clear()
+      {
+      _events.clear();
+      _frames.clear();
+      _sorted = true;
+      }
+
+//---------------------------------------------------------
+//   lower_bound
+//   upper_bound
+//---------------------------------------------------------
+
+EventMap::const_iterator EventMap::lower_bound(int tick) const
+      {
+      sort();
+      return std::lower_bound(_events.cbegin(), _events.cend(), tick,
+         [](const value_type& e, int t) { return e.first < t; });
+      }
+
+EventMap::const_iterator EventMap::upper_bound(int tick) const
+      {
+      sort();
+      return std::upper_bound(_events.cbegin(), _events.cend(), tick,
+         [](int t, const value_type& e) { return t < e.first; });
+      }
+
+//---------------------------------------------------------
+//   setFrames
+//    compute the sample time of all events for the
+//    relative tempo relTempo
+//---------------------------------------------------------
+
+void EventMap::setFrames(const std::function<int(int)>& tick2frame, double relTempo)
+      {
+      sort();
+      _frames.resize(_events.size());
+      int lastTick  = -1;
+      int lastFrame = 0;
+      for (size_t i = 0; i < _events.size(); ++i) {
+            int tick = _events[i].first;
+            if (tick != lastTick) {
+                  lastTick  = tick;
+                  lastFrame = tick2frame(tick);
+                  }
+            _frames[i] = lastFrame;
+            }
+      _framesTempo = relTempo;
+      }
 }
 
@@ -14,6 +14,9 @@
 #define __EVENT_H__
 
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <functional>
 
 namespace Ms {
 
@@ -307,7 +310,54 @@ class EventList : public QList<Event> {
       void insertNote(int channel, Note*);
       };
 
-class EventMap : public std::multimap<int, NPlayEvent> {};
+//---------------------------------------------------------
+//   EventMap
+//    time sorted play list in one contiguous buffer;
+//    insertion is an append, the buffer is (stable)
+//    sorted on first read, so events with the same tick
+//    keep their insertion order.
+//    setFrames() adds a column with the sample time of
+//    every event, a list with frames is not modified
+//    anymore and can be read from the audio thread.
+//---------------------------------------------------------
+
+class EventMap {
+   public:
+      typedef std::pair<int, NPlayEvent> value_type;
+      typedef std::vector<value_type>::const_iterator const_iterator;
+      typedef const_iterator iterator;
+
+   private:
+      mutable std::vector<value_type> _events;
+      mutable bool _sorted { true };
+      std::vector<int> _frames;
+      double _framesTempo  { 0.0 };
+
+      void sort() const;
+
+   public:
+      void insert(const value_type& e) {
+            if (!_events.empty() && e.first < _events.back().first)
+                  _sorted = false;
+            _events.push_back(e);
+            }
+      void append(const EventMap&, int tickOffset);
+      void reserve(size_t n)              { _events.reserve(n); }
+      void clear();
+      size_t size() const                 { return _events.size();  }
+      bool empty() const                  { return _events.empty(); }
+
+      const_iterator begin() const        { sort(); return _events.cbegin(); }
+      const_iterator end() const          { sort(); return _events.cend();   }
+      const_iterator cbegin() const       { return begin(); }
+      const_iterator cend() const         { return end();   }
+      const_iterator lower_bound(int tick) const;
+      const_iterator upper_bound(int tick) const;
+
+      void setFrames(const std::function<int(int)>& tick2frame, double relTempo);
+      bool hasFrames(double relTempo) const { return !_frames.empty() && _framesTempo == relTempo; }
+      int frame(const_iterator i) const   { return _frames[i - _events.cbegin()]; }
+      };
 
 typedef EventList::iterator iEvent;
 typedef EventList::const_iterator ciEvent;
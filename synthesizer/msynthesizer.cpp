@@ -18,6 +18,8 @@
 #include "libmscore/xml.h"
 #include "midipatch.h"
 
+#include <thread>
+
 namespace Ms {
 
 extern QString dataPath;
@@ -45,6 +47,100 @@ static SynthesizerState defaultState = {
 //            },
       };
 
+//---------------------------------------------------------
+//   SynthWorker
+//    renders one synthesizer into a private buffer on
+//    its own thread; the audio thread hands out a block
+//    with dispatch() and collects it with wait(). A block
+//    not collected in time stays pending until the worker
+//    is done with it.
+//---------------------------------------------------------
+
+class SynthWorker {
+      Synthesizer* _synth;
+      std::thread _thread;
+      QSemaphore _start;
+      QSemaphore _done;
+      std::atomic<bool> _quit;
+      std::atomic<bool> _pending;   // a dispatched block is not collected yet
+      unsigned _frames;
+      float _buffer[MasterSynthesizer::MAX_BUFFERSIZE];
+      float _effect1[MasterSynthesizer::MAX_BUFFERSIZE];
+      float _effect2[MasterSynthesizer::MAX_BUFFERSIZE];
+
+      void run();
+
+   public:
+      SynthWorker(Synthesizer* s);
+      ~SynthWorker();
+      void dispatch(unsigned n);
+      bool wait(int ms);
+      void sync()                   { while (!wait(1)) ; }
+      bool idle()                   { return wait(0); }
+      const float* buffer() const   { return _buffer; }
+      };
+
+SynthWorker::SynthWorker(Synthesizer* s)
+      {
+      _synth  = s;
+      _quit    = false;
+      _pending = false;
+      _frames  = 0;
+      _thread = std::thread(&SynthWorker::run, this);
+      }
+
+SynthWorker::~SynthWorker()
+      {
+      _quit = true;
+      _start.release();
+      _thread.join();
+      }
+
+//---------------------------------------------------------
+//   dispatch
+//    called from the audio thread
+//---------------------------------------------------------
+
+void SynthWorker::dispatch(unsigned n)
+      {
+      _frames  = n;
+      _pending = true;
+      _start.release();
+      }
+
+//---------------------------------------------------------
+//   wait
+//    collect the dispatched block, waiting at most ms
+//    milliseconds; returns false if the worker is still
+//    rendering it
+//---------------------------------------------------------
+
+bool SynthWorker::wait(int ms)
+      {
+      if (!_pending)
+            return true;
+      if (!_done.tryAcquire(1, ms))
+            return false;
+      _pending = false;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SynthWorker::run()
+      {
+      for (;;) {
+            _start.acquire();
+            if (_quit)
+                  break;
+            memset(_buffer, 0, _frames * sizeof(float) * 2);
+            _synth->process(_frames, _buffer, _effect1, _effect2);
+            _done.release();
+            }
+      }
+
 //---------------------------------------------------------
 //   MasterSynthesizer
 //---------------------------------------------------------
@@ -91,6 +187,8 @@ void MasterSynthesizer::init()
 
 MasterSynthesizer::~MasterSynthesizer()
       {
+      for (SynthWorker* w : _worker)
+            delete w;
       for (Synthesizer* s : _synthesizer)
             delete s;
       for (int i = 0; i < MAX_EFFECTS; ++i)
@@ -115,6 +213,9 @@ void MasterSynthesizer::play(const NPlayEvent& event, unsigned syntiIdx)
       {
       if (syntiIdx >= _synthesizer.size())
             return;
+      // a synthesizer that missed the last block may still be rendering it
+      if (!_worker.empty())
+            _worker[syntiIdx]->sync();
       _synthesizer[syntiIdx]->setActive(true);
       _synthesizer[syntiIdx]->play(event);
       }
@@ -201,6 +302,8 @@ Synthesizer* MasterSynthesizer::synthesizer(const QString& name)
 void MasterSynthesizer::registerSynthesizer(Synthesizer* s)
       {
       _synthesizer.push_back(s);
+      if (QThread::idealThreadCount() > 1)
+            _worker.push_back(new SynthWorker(s));
       }
 
 //---------------------------------------------------------
@@ -276,10 +379,7 @@ void MasterSynthesizer::process(unsigned n, float* p)
       // avoid overflow
       if( n > MAX_BUFFERSIZE / 2)
             return;
-      for (Synthesizer* s : _synthesizer) {
-            if (s->active())
-                  s->process(n, p, effect1Buffer, effect2Buffer);
-            }
+      processSynthesizers(n, p);
       if (_effect[0] && _effect[1]) {
             memset(effect1Buffer, 0, n * sizeof(float) * 2);
             _effect[0]->process(n, p, effect1Buffer);
@@ -297,6 +397,63 @@ void MasterSynthesizer::process(unsigned n, float* p)
       lock1 = false;
       }
 
+//---------------------------------------------------------
+//   processSynthesizers
+//    The first idle synthesizer renders directly into p
+//    on the audio thread, all others are handed to their
+//    workers and mixed in afterwards. The workers are
+//    waited for until one buffer period has passed; a
+//    synthesizer that misses it plays silence for this
+//    block and is skipped until its worker is done, its
+//    late block is dropped. Offline rendering waits for
+//    every block.
+//---------------------------------------------------------
+
+void MasterSynthesizer::processSynthesizers(unsigned n, float* p)
+      {
+      int nsynth = int(_synthesizer.size());
+      if (_worker.empty()) {
+            for (Synthesizer* s : _synthesizer) {
+                  if (s->active())
+                        s->process(n, p, effect1Buffer, effect2Buffer);
+                  }
+            return;
+            }
+
+      QElapsedTimer timer;
+      timer.start();
+      int period = _sampleRate > 0 ? qMax(1, int(n * 1000 / _sampleRate)) : 1;     // ms
+
+      Synthesizer* first  = 0;
+      unsigned dispatched = 0;      // bit mask, MasterSynthesizer hosts only a few synthesizers
+      for (int i = 0; i < nsynth; ++i) {
+            Synthesizer* s = _synthesizer[i];
+            if (!s->active() || !_worker[i]->idle())
+                  continue;
+            if (!first)
+                  first = s;        // rendered on the audio thread below
+            else {
+                  _worker[i]->dispatch(n);
+                  dispatched |= 1 << i;
+                  }
+            }
+      if (first)
+            first->process(n, p, effect1Buffer, effect2Buffer);
+
+      for (int i = 0; i < nsynth; ++i) {
+            if (!(dispatched & (1 << i)))
+                  continue;
+            SynthWorker* w = _worker[i];
+            if (_synthesizer[i]->offline())
+                  w->sync();
+            else if (!w->wait(qMax(0, period - int(timer.elapsed()))))
+                  continue;
+            const float* b = w->buffer();
+            for (unsigned k = 0; k < n * 2; ++k)
+                  p[k] += b[k];
+            }
+      }
+
 //---------------------------------------------------------
 //   indexOfEffect
 //---------------------------------------------------------
@@ -409,5 +566,18 @@ void MasterSynthesizer::setMasterTuning(double val)
       for (Synthesizer* s : _synthesizer)
             s->setMasterTuning(_masterTuning);
       }
+
+//---------------------------------------------------------
+//   setOffline
+//    offline rendering (audio export) is not bound to
+//    real time: synthesizers wait for sample data instead
+//    of dropping notes or playing silence
+//---------------------------------------------------------
+
+void MasterSynthesizer::setOffline(bool val)
+      {
+      for (Synthesizer* s : _synthesizer)
+            s->setOffline(val);
+      }
 }
 
@@ -24,6 +24,7 @@ class NPlayEvent;
 class Synthesizer;
 class Effect;
 class Xml;
+class SynthWorker;
 
 //---------------------------------------------------------
 //   MasterSynthesizer
@@ -44,6 +45,7 @@ class MasterSynthesizer : public QObject {
       std::atomic<bool> lock1;
       std::atomic<bool> lock2;
       std::vector<Synthesizer*> _synthesizer;
+      std::vector<SynthWorker*> _worker;      // one per synthesizer, empty on single core machines
       std::vector<Effect*> _effectList[2];
       Effect* _effect[2];
 
@@ -52,6 +54,7 @@ class MasterSynthesizer : public QObject {
       float effect1Buffer[MAX_BUFFERSIZE];
       float effect2Buffer[MAX_BUFFERSIZE];
       int indexOfEffect(int ab, const QString& name);
+      void processSynthesizers(unsigned n, float* p);
 
    public slots:
       void sfChanged() { emit soundFontChanged(); }
@@ -76,6 +79,7 @@ class MasterSynthesizer : public QObject {
 
       void setMasterTuning(double val);
       double masterTuning() const      { return _masterTuning; }
+      void setOffline(bool val);
 
       int index(const QString&) const;
       QString name(unsigned) const;
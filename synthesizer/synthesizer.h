@@ -28,13 +28,14 @@ class SynthesizerGui;
 
 class Synthesizer {
       bool _active;
+      bool _offline;          // rendering for export, may wait for sample data
 
    protected:
       float _sampleRate;
       SynthesizerGui* _gui;
 
    public:
-      Synthesizer() : _active(false) { _gui = 0; }
+      Synthesizer() : _active(false), _offline(false) { _gui = 0; }
       virtual ~Synthesizer() {}
       virtual void init(float sr)    { _sampleRate = sr; }
       float sampleRate() const       { return _sampleRate; }
@@ -64,6 +65,8 @@ class Synthesizer {
       void reset()                    { _active = false; }
       bool active() const             { return _active; }
       void setActive(bool val = true) { _active = val;  }
+      bool offline() const            { return _offline; }
+      void setOffline(bool val)       { _offline = val;  }
 
       virtual void allSoundsOff(int /*channel*/) {}
       virtual void allNotesOff(int /*channel*/) {}
@@ -0,0 +1,182 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "config.h"
+#include "dsp.h"
+
+#if defined(USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define ZERBERUS_DSP_SSE2
+#endif
+
+#ifdef ZERBERUS_DSP_SSE2
+//---------------------------------------------------------
+//   toFloat
+//    four 16 bit sample points as floats
+//---------------------------------------------------------
+
+static inline __m128 toFloat(__m128i s)
+      {
+      return _mm_cvtepi32_ps(_mm_srai_epi32(s, 16));
+      }
+
+//---------------------------------------------------------
+//   advance4
+//    phases and amplitudes for the next four frames;
+//    amplitudes are accumulated one by one like the
+//    scalar loop does to stay bit identical
+//---------------------------------------------------------
+
+static inline void advance4(Phase* p, float* a, const Phase& phase, const Phase& incr, float amp, float ampIncr)
+      {
+      p[0] = phase;
+      a[0] = amp;
+      for (int k = 1; k < 4; ++k) {
+            p[k] = p[k-1];
+            p[k] += incr;
+            a[k] = a[k-1] + ampIncr;
+            }
+      }
+
+//---------------------------------------------------------
+//   sum4
+//    transposes the four products and adds up the terms
+//    in the order of the scalar loop
+//---------------------------------------------------------
+
+static inline __m128 sum4(__m128* r)
+      {
+      _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+      return _mm_add_ps(_mm_add_ps(_mm_add_ps(r[0], r[1]), r[2]), r[3]);
+      }
+#endif
+
+//---------------------------------------------------------
+//   dspInterpolate
+//---------------------------------------------------------
+
+void dspInterpolate(const short* data, int channels, const float (*coeff)[4],
+   Phase& phase, Phase incr, float& amp, float ampIncr, float* l, float* r, int n,
+   bool simd)
+      {
+      int i = 0;
+#ifdef ZERBERUS_DSP_SSE2
+      if (simd) {
+            Phase p[4];
+            float a[4];
+            for (; i + 4 <= n; i += 4) {
+                  advance4(p, a, phase, incr, amp, ampIncr);
+                  __m128 va = _mm_loadu_ps(a);
+                  if (channels == 1) {
+                        __m128 v[4];
+                        for (int k = 0; k < 4; ++k) {
+                              __m128i s = _mm_loadl_epi64((const __m128i*)(data + p[k].index() - 1));
+                              __m128 c  = _mm_loadu_ps(coeff[p[k].fract()]);
+                              v[k] = _mm_mul_ps(c, toFloat(_mm_unpacklo_epi16(s, s)));
+                              }
+                        _mm_storeu_ps(l + i, _mm_mul_ps(sum4(v), va));
+                        }
+                  else {
+                        __m128 vl[4], vr[4];
+                        for (int k = 0; k < 4; ++k) {
+                              // l r l r l r l r of the four points
+                              __m128i s  = _mm_loadu_si128((const __m128i*)(data + p[k].index() * 2 - 2));
+                              __m128 lo  = toFloat(_mm_unpacklo_epi16(s, s));
+                              __m128 hi  = toFloat(_mm_unpackhi_epi16(s, s));
+                              __m128 c   = _mm_loadu_ps(coeff[p[k].fract()]);
+                              vl[k] = _mm_mul_ps(c, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+                              vr[k] = _mm_mul_ps(c, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+                              }
+                        _mm_storeu_ps(l + i, _mm_mul_ps(sum4(vl), va));
+                        _mm_storeu_ps(r + i, _mm_mul_ps(sum4(vr), va));
+                        }
+                  phase = p[3];
+                  phase += incr;
+                  amp = a[3] + ampIncr;
+                  }
+            }
+#else
+      Q_UNUSED(simd);
+#endif
+      if (channels == 1) {
+            for (; i < n; ++i) {
+                  const short* src    = data + phase.index();
+                  const float* coeffs = coeff[phase.fract()];
+                  l[i] = (coeffs[0] * src[-1]
+                        + coeffs[1] * src[0]
+                        + coeffs[2] * src[1]
+                        + coeffs[3] * src[2]) * amp;
+                  phase += incr;
+                  amp   += ampIncr;
+                  }
+            }
+      else {
+            for (; i < n; ++i) {
+                  const short* src    = data + phase.index() * 2;
+                  const float* coeffs = coeff[phase.fract()];
+                  l[i] = (coeffs[0] * src[-2]
+                        + coeffs[1] * src[0]
+                        + coeffs[2] * src[2]
+                        + coeffs[3] * src[4]) * amp;
+                  r[i] = (coeffs[0] * src[-1]
+                        + coeffs[1] * src[1]
+                        + coeffs[2] * src[3]
+                        + coeffs[3] * src[5]) * amp;
+                  phase += incr;
+                  amp   += ampIncr;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   dspFilter
+//---------------------------------------------------------
+
+void dspFilter(float* buf, int n, const Biquad& f, float& hist1, float& hist2)
+      {
+      float h1 = hist1;
+      float h2 = hist2;
+      for (int i = 0; i < n; ++i)
+            buf[i] = f(buf[i], h1, h2);
+      hist1 = h1;
+      hist2 = h2;
+      }
+
+//---------------------------------------------------------
+//   dspMix
+//---------------------------------------------------------
+
+void dspMix(const float* l, const float* r, int n, float gainLeft, float gainRight,
+   float* out, bool simd)
+      {
+      int i = 0;
+#ifdef ZERBERUS_DSP_SSE2
+      if (simd) {
+            const __m128 gl = _mm_set1_ps(gainLeft);
+            const __m128 gr = _mm_set1_ps(gainRight);
+            for (; i + 4 <= n; i += 4) {
+                  __m128 vl = _mm_mul_ps(_mm_loadu_ps(l + i), gl);
+                  __m128 vr = _mm_mul_ps(_mm_loadu_ps(r + i), gr);
+                  float* o  = out + i * 2;
+                  _mm_storeu_ps(o,     _mm_add_ps(_mm_loadu_ps(o),     _mm_unpacklo_ps(vl, vr)));
+                  _mm_storeu_ps(o + 4, _mm_add_ps(_mm_loadu_ps(o + 4), _mm_unpackhi_ps(vl, vr)));
+                  }
+            }
+#else
+      Q_UNUSED(simd);
+#endif
+      for (; i < n; ++i) {
+            out[i * 2]     += l[i] * gainLeft;
+            out[i * 2 + 1] += r[i] * gainRight;
+            }
+      }
+
@@ -0,0 +1,66 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __ZDSP_H__
+#define __ZDSP_H__
+
+#include "voice.h"
+
+//---------------------------------------------------------
+//   Biquad
+//    filter coefficients, b0 and b2 are identical
+//---------------------------------------------------------
+
+struct Biquad {
+      float b02;
+      float b1;
+      float a1;
+      float a2;
+
+      float operator()(float x, float& hist1, float& hist2) const {
+            float f = x - a1 * hist1 - a2 * hist2;
+            float v = b02 * (f + hist2) + b1 * hist1;
+            hist2   = hist1;
+            hist1   = f;
+            return v;
+            }
+      };
+
+//---------------------------------------------------------
+//   block kernels of the voice render path
+//    With simd set the SSE2 kernels are used where
+//    available; they produce bit identical results to
+//    the scalar loops.
+//---------------------------------------------------------
+
+// Interpolates n frames of a mono or interleaved stereo sample into l
+// (and r for stereo), scaled by the amplitude ramp amp, amp + ampIncr, ...
+// All four interpolation points of every frame must lie inside data.
+// phase and amp are advanced.
+
+void dspInterpolate(const short* data, int channels, const float (*coeff)[4],
+   Phase& phase, Phase incr, float& amp, float ampIncr, float* l, float* r, int n,
+   bool simd = true);
+
+// Runs n samples of buf through the filter. The recursion
+// has no parallelism to exploit, this is a plain loop.
+
+void dspFilter(float* buf, int n, const Biquad&, float& hist1, float& hist2);
+
+// Adds n frames of l and r with the pan gains to the interleaved
+// stereo buffer out; for mono voices l and r are the same block.
+
+void dspMix(const float* l, const float* r, int n, float gainLeft, float gainRight,
+   float* out, bool simd = true);
+
+#endif
+
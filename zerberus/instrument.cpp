@@ -22,10 +22,12 @@
 
 #include "instrument.h"
 #include "zone.h"
+#include "streamer.h"
 #include "sample.h"
 
 QByteArray ZInstrument::buf;
 int ZInstrument::idx;
+bool ZInstrument::diskStreaming = true;
 
 //---------------------------------------------------------
 //   Sample
@@ -33,7 +35,8 @@ int ZInstrument::idx;
 
 Sample::~Sample()
       {
-      delete _data;
+      delete[] _data;
+      delete[] _full.load();
       }
 
 //---------------------------------------------------------
@@ -42,6 +45,11 @@ Sample::~Sample()
 
 Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
       {
+      if (!uz && diskStreaming) {
+            Sample* sa = readStreamedSample(s);
+            if (sa)
+                  return sa;
+            }
       if (uz) {
             QList<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -87,6 +95,38 @@ Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
       return sa;
       }
 
+//---------------------------------------------------------
+//   readStreamedSample
+//    long samples on disk are only read up to the preload
+//    head, the rest is streamed during playback; returns 0
+//    if the sample should be loaded completely
+//---------------------------------------------------------
+
+Sample* ZInstrument::readStreamedSample(const QString& s)
+      {
+      AudioFile a;
+      if (!a.open(s))
+            return 0;
+      int channel = a.channels();
+      int frames  = a.frames();
+      int head    = DiskStreamer::HEAD_FRAMES;
+      if (channel > 2 || frames < head * 4)
+            return 0;
+
+      short* data = new short[(head + 3) * channel];
+      if (head != a.read(data + channel, head)) {
+            printf("Sample read failed: %s\n", a.error());
+            delete[] data;
+            return 0;
+            }
+      for (int i = 0; i < channel; ++i)
+            data[i] = data[channel + i];
+      Sample* sa = new Sample(channel, data, frames, a.samplerate());
+      sa->setStreamed(s, head);
+      _streamed = true;
+      return sa;
+      }
+
 //---------------------------------------------------------
 //   ZInstrument
 //---------------------------------------------------------
@@ -34,6 +34,7 @@ class ZInstrument {
       int _program;
       QString instrumentPath;
       std::list<Zone*> _zones;
+      bool _streamed = false;       // some samples are streamed from disk
 
       bool loadFromFile(const QString&);
       bool loadSfz(const QString&);
@@ -53,11 +54,14 @@ class ZInstrument {
       const std::list<Zone*>& zones() const { return _zones;  }
       std::list<Zone*>& zones()             { return _zones;  }
       Sample* readSample(const QString& s, MQZipReader* uz);
+      Sample* readStreamedSample(const QString& s);
+      bool streamed() const                 { return _streamed; }
       void addZone(Zone* z)                 { _zones.push_back(z); }
       void addRegion(SfzRegion&);
 
       static QByteArray buf;  // used during read of Sample
       static int idx;
+      static bool diskStreaming;    // stream long samples from disk
       };
 
 #endif
@@ -13,6 +13,8 @@
 #ifndef __SAMPLE_H__
 #define __SAMPLE_H__
 
+#include <atomic>
+
 //---------------------------------------------------------
 //   Sample
 //---------------------------------------------------------
@@ -22,16 +24,31 @@ class Sample {
       short* _data;
       int _frames;
       int _sampleRate;
+      int _headFrames;        // frames in _data; less than _frames if streamed
+      QString _path;          // file of a streamed sample
+      std::atomic<short*> _full;          // complete data of a streamed sample, see DiskStreamer::loadFull()
+      std::atomic<bool> _fullRequested;
 
    public:
       Sample(int ch, short* val, int f, int sr)
-         : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+         : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _headFrames(f), _full(0), _fullRequested(false) {}
       ~Sample();
       bool read(const QString&);
       int frames() const     { return _frames;          }
       short* data() const    { return _data + _channel; }
       int channel() const    { return _channel;         }
       int sampleRate() const { return _sampleRate;      }
+
+      void setStreamed(const QString& path, int head) { _path = path; _headFrames = head; }
+      bool streamed() const       { return _headFrames < _frames; }
+      int headFrames() const      { return _headFrames; }
+      const QString& path() const { return _path; }
+
+      short* fullData() const     { short* d = _full; return d ? d + _channel : 0; }
+      void setFullData(short* d)  { _full = d; }
+      bool requestFull()          { return !_fullRequested.exchange(true); }
+      void cancelFull()           { _fullRequested = false; }
+      bool fullRequested() const  { return _fullRequested; }
       };
 
 #endif
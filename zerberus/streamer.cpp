@@ -0,0 +1,327 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <chrono>
+#include <thread>
+
+#include "audiofile/audiofile.h"
+#include "libmscore/mscore.h"
+#include "streamer.h"
+#include "sample.h"
+
+//---------------------------------------------------------
+//   Stream
+//---------------------------------------------------------
+
+Stream::Stream()
+      {
+      state   = IDLE;
+      filled  = 0;
+      readPos = 0;
+      }
+
+Stream::~Stream()
+      {
+      delete[] buffer;
+      delete file;
+      }
+
+//---------------------------------------------------------
+//   DiskStreamer
+//---------------------------------------------------------
+
+DiskStreamer::DiskStreamer(int n)
+      {
+      _n          = n;
+      _next       = 0;
+      _streams    = new Stream[n];
+      for (int i = 0; i < REQUESTS; ++i)
+            _requests[i] = 0;
+      _quit       = false;
+      _started    = 0;
+      _underruns  = 0;
+      _latencies  = 0;
+      _latencySum = 0;
+      _latencyMax = 0;
+      _reads      = 0;
+      _readSum    = 0;
+      _readMax    = 0;
+      _thread     = std::thread(&DiskStreamer::run, this);
+      }
+
+DiskStreamer::~DiskStreamer()
+      {
+      _quit = true;
+      _wake.release();
+      _thread.join();
+      if (Ms::MScore::debugMode && _started) {
+            StreamStats s = stats();
+            qDebug("Zerberus: %d streams, %d underruns, latency avg %.2f max %.2f ms, read avg %.2f max %.2f ms",
+               s.streams, s.underruns, s.avgLatency, s.maxLatency, s.avgRead, s.maxRead);
+            }
+      delete[] _streams;
+      }
+
+//---------------------------------------------------------
+//   now
+//---------------------------------------------------------
+
+qint64 DiskStreamer::now()
+      {
+      using namespace std::chrono;
+      return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+      }
+
+//---------------------------------------------------------
+//   start
+//    audio thread; request streaming of sample from frame
+//    on in an idle stream. If all streams are busy or
+//    still shutting down the sample is loaded completely
+//    instead and 0 is returned.
+//---------------------------------------------------------
+
+Stream* DiskStreamer::start(Sample* sample, int frame)
+      {
+      Stream* s = 0;
+      for (int i = 0; i < _n; ++i) {
+            Stream* st = &_streams[(_next + i) % _n];
+            if (st->state == Stream::IDLE) {
+                  s = st;
+                  _next = (_next + i + 1) % _n;
+                  break;
+                  }
+            }
+      if (!s) {
+            loadFull(sample);
+            return 0;
+            }
+      s->path        = sample->path();
+      s->channels    = sample->channel();
+      s->frames      = sample->frames();
+      s->startFrame  = frame;
+      s->filled      = frame;
+      s->readPos     = frame;
+      s->requestTime = now();
+      s->state       = Stream::START;
+      ++_started;
+      _wake.release();
+      return s;
+      }
+
+//---------------------------------------------------------
+//   loadFull
+//    audio thread; ask the io thread to load the complete
+//    sample, later notes play it like a resident sample
+//---------------------------------------------------------
+
+void DiskStreamer::loadFull(Sample* sample)
+      {
+      if (!sample->requestFull())
+            return;
+      for (int i = 0; i < REQUESTS; ++i) {
+            Sample* s = 0;
+            if (_requests[i].compare_exchange_strong(s, sample)) {
+                  _wake.release();
+                  return;
+                  }
+            }
+      sample->cancelFull();         // try again on the next note
+      }
+
+//---------------------------------------------------------
+//   waitFull
+//    offline rendering waits for a complete load, at most
+//    WAIT_MS; returns false if the sample was not loaded
+//---------------------------------------------------------
+
+bool DiskStreamer::waitFull(Sample* sample)
+      {
+      qint64 deadline = now() + qint64(WAIT_MS) * 1000000;
+      while (!sample->fullData()) {
+            if (now() > deadline) {
+                  qDebug("Zerberus: timeout loading <%s>", qPrintable(sample->path()));
+                  return false;
+                  }
+            if (!sample->fullRequested())
+                  loadFull(sample);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   waitFilled
+//    offline rendering waits for the io thread instead of
+//    playing silence, at most WAIT_MS; returns false if
+//    the frame did not arrive
+//---------------------------------------------------------
+
+bool DiskStreamer::waitFilled(const Stream* s, int frame)
+      {
+      _wake.release();
+      qint64 deadline = now() + qint64(WAIT_MS) * 1000000;
+      while (frame >= s->filled) {
+            if (now() > deadline) {
+                  qDebug("Zerberus: timeout streaming <%s>", qPrintable(s->path));
+                  return false;
+                  }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   stop
+//    audio thread
+//---------------------------------------------------------
+
+void DiskStreamer::stop(Stream* s)
+      {
+      int st = Stream::START;
+      if (!s->state.compare_exchange_strong(st, Stream::STOP)) {
+            st = Stream::RUN;
+            s->state.compare_exchange_strong(st, Stream::STOP);
+            }
+      }
+
+//---------------------------------------------------------
+//   run
+//    io thread
+//---------------------------------------------------------
+
+void DiskStreamer::run()
+      {
+      while (!_quit) {
+            _wake.tryAcquire(1, 5);
+            for (int i = 0; i < REQUESTS; ++i) {
+                  Sample* sample = _requests[i].exchange(0);
+                  if (sample)
+                        load(sample);
+                  }
+            for (int i = 0; i < _n; ++i) {
+                  Stream* s = &_streams[i];
+                  switch (s->state) {
+                        case Stream::IDLE:
+                              break;
+                        case Stream::START: {
+                              if (!s->buffer)
+                                    s->buffer = new short[Stream::FRAMES * 2];
+                              delete s->file;
+                              s->file = new AudioFile;
+                              if (!s->file->open(s->path) || s->file->seekFrame(s->startFrame) < 0) {
+                                    qDebug("Zerberus: cannot stream <%s>", qPrintable(s->path));
+                                    delete s->file;
+                                    s->file = 0;
+                                    }
+                              int st = Stream::START;
+                              if (s->state.compare_exchange_strong(st, Stream::RUN))
+                                    fill(s);
+                              }
+                              break;
+                        case Stream::RUN:
+                              fill(s);
+                              break;
+                        case Stream::STOP:
+                              delete s->file;
+                              s->file  = 0;
+                              s->state = Stream::IDLE;
+                              break;
+                        }
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   load
+//    io thread; read a streamed sample completely, laid
+//    out like ZInstrument::readSample() does. If the file
+//    cannot be read the head is followed by silence.
+//---------------------------------------------------------
+
+void DiskStreamer::load(Sample* sample)
+      {
+      int ch     = sample->channel();
+      int frames = sample->frames();
+      short* data = new short[(frames + 3) * ch];
+      AudioFile a;
+      if (a.open(sample->path()) && a.read(data + ch, frames) == frames) {
+            for (int i = 0; i < ch; ++i) {
+                  data[i]                   = data[ch + i];
+                  data[(frames-1) * ch + i] = data[(frames-3) * ch + i];
+                  data[(frames-2) * ch + i] = data[(frames-3) * ch + i];
+                  }
+            }
+      else {
+            qDebug("Zerberus: cannot load <%s>", qPrintable(sample->path()));
+            int head = sample->headFrames() + 1;
+            memcpy(data, sample->data() - ch, head * ch * sizeof(short));
+            memset(data + head * ch, 0, (frames + 3 - head) * ch * sizeof(short));
+            }
+      sample->setFullData(data);
+      }
+
+//---------------------------------------------------------
+//   fill
+//    read ahead of the voice as far as the ring allows;
+//    past the end of the sample, or if the file cannot be
+//    read, the ring is padded with silence
+//---------------------------------------------------------
+
+void DiskStreamer::fill(Stream* s)
+      {
+      for (;;) {
+            int f = s->filled;
+            if (s->readPos + Stream::FRAMES - f < CHUNK)
+                  break;
+            int pos = f & (Stream::FRAMES - 1);
+            int n   = qMin(int(CHUNK), Stream::FRAMES - pos);   // do not wrap within one read
+            short* dst = s->buffer + pos * s->channels;
+            int r = 0;
+            if (f < s->frames && s->file) {
+                  qint64 t = now();
+                  r = qMax(s->file->read(dst, qMin(n, s->frames - f)), 0);
+                  t = now() - t;
+                  ++_reads;
+                  _readSum += t;
+                  if (t > _readMax)
+                        _readMax = t;
+                  }
+            memset(dst + r * s->channels, 0, (n - r) * s->channels * sizeof(short));
+            if (s->state != Stream::RUN)
+                  return;
+            if (f == s->startFrame) {
+                  qint64 t = now() - s->requestTime;
+                  ++_latencies;
+                  _latencySum += t;
+                  if (t > _latencyMax)
+                        _latencyMax = t;
+                  }
+            s->filled = f + n;
+            }
+      }
+
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+StreamStats DiskStreamer::stats() const
+      {
+      StreamStats s;
+      s.streams    = _started;
+      s.underruns  = _underruns;
+      s.avgLatency = _latencies ? _latencySum / double(_latencies) * 1e-6 : 0.0;
+      s.maxLatency = _latencyMax * 1e-6;
+      s.avgRead    = _reads ? _readSum / double(_reads) * 1e-6 : 0.0;
+      s.maxRead    = _readMax * 1e-6;
+      return s;
+      }
+
@@ -0,0 +1,115 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __STREAMER_H__
+#define __STREAMER_H__
+
+#include <atomic>
+#include <thread>
+#include <QSemaphore>
+#include <QString>
+
+class Sample;
+class AudioFile;
+
+//---------------------------------------------------------
+//   Stream
+//    ring buffer of one voice playing a streamed sample;
+//    frames are absolute sample frame numbers
+//---------------------------------------------------------
+
+class Stream {
+   public:
+      static const int FRAMES = 32768;          // ring size, power of two
+      enum State { IDLE, START, RUN, STOP };
+
+      std::atomic<int> state;
+      std::atomic<int> filled;                  // frames below this are in the ring
+      std::atomic<int> readPos;                 // oldest frame the voice still needs
+
+      // written by the audio thread before START
+      QString path;
+      int channels    = 1;
+      int frames      = 0;
+      int startFrame  = 0;
+      qint64 requestTime = 0;                   // ns, for latency statistics
+
+      // owned by the io thread
+      short* buffer   = 0;
+      AudioFile* file = 0;
+
+      Stream();
+      ~Stream();
+      const short* frame(int n) const { return buffer + (n & (FRAMES - 1)) * channels; }
+      };
+
+//---------------------------------------------------------
+//   StreamStats
+//---------------------------------------------------------
+
+struct StreamStats {
+      int streams;            // streams started
+      int underruns;          // frames played as silence because the ring was empty
+      double avgLatency;      // ms from note on to the first block in the ring
+      double maxLatency;
+      double avgRead;         // ms per file read
+      double maxRead;
+      };
+
+//---------------------------------------------------------
+//   DiskStreamer
+//    one io thread per Zerberus instance fills the ring
+//    buffers of all voices playing streamed samples; it is
+//    only created once an instrument with streamed samples
+//    is loaded
+//---------------------------------------------------------
+
+class DiskStreamer {
+      static const int REQUESTS = 32;
+
+      Stream* _streams;
+      int _n;
+      int _next;                                // audio thread, where to look for an idle stream
+      std::atomic<Sample*> _requests[REQUESTS]; // samples to load completely
+      std::thread _thread;
+      QSemaphore _wake;
+      std::atomic<bool> _quit;
+
+      std::atomic<int> _started;
+      std::atomic<int> _underruns;
+      std::atomic<qint64> _latencies, _latencySum, _latencyMax;   // ns
+      std::atomic<qint64> _reads, _readSum, _readMax;   // ns
+
+      void run();
+      void fill(Stream*);
+      void load(Sample*);
+
+   public:
+      static const int HEAD_FRAMES = 16384;     // resident part of a streamed sample
+      static const int CHUNK       = 4096;      // frames per file read
+      static const int WAIT_MS     = 5000;      // longest offline wait for the io thread
+
+      DiskStreamer(int streams);
+      ~DiskStreamer();
+
+      Stream* start(Sample*, int frame);
+      void stop(Stream*);
+      void loadFull(Sample*);
+      bool waitFull(Sample*);
+      bool waitFilled(const Stream*, int frame);
+      void underrun()                 { ++_underruns; }
+      StreamStats stats() const;
+      static qint64 now();
+      };
+
+#endif
+
@@ -18,12 +18,17 @@
 #include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
+#include "streamer.h"
+#include "dsp.h"
 #include "synthesizer/msynthesizer.h"
 
+const int Voice::BLOCK;
 float Voice::interpCoeff[INTERP_MAX][4];
 float Envelope::egPow[EG_SIZE];
 float Envelope::egLin[EG_SIZE];
 
+static const float SILENCE = 1e-6;      // -120 dB, voices below are not rendered
+
 static const char* voiceStateNames[] = {
       "OFF", "ATTACK", "PLAYING", "SUSTAINED", "STOP"
       };
@@ -34,7 +39,7 @@ static const char* voiceStateNames[] = {
 
 void Envelope::setTime(float ms, int sampleRate)
       {
-      val   = 1.0;
+      val   = start;
       steps = int(ms * sampleRate / 1000);
       count = steps;
       }
@@ -44,7 +49,7 @@ void Envelope::setTime(float ms, int sampleRate)
 //---------------------------------------------------------
 
 Voice::Voice(Zerberus* z)
-   : _zerberus(z), attackEnv(Envelope::egLin), stopEnv(Envelope::egPow)
+   : _zerberus(z), attackEnv(Envelope::egLin, 0.0), stopEnv(Envelope::egPow, 1.0)
       {
       }
 
@@ -99,8 +104,25 @@ void Voice::start(Channel* c, int key, int v, const Zone* z)
       _velocity = v;
       Sample* s = z->sample;
       audioChan = s->channel();
-      data      = s->data() + z->offset * audioChan;
+      _offset   = z->offset;
+      streaming = false;
+      _stream   = 0;
+      short* full = s->streamed() ? s->fullData() : 0;
+      DiskStreamer* ds = _zerberus->streamer();
+      if (s->streamed() && !full && ds) {
+            _stream   = ds->start(s, qMax(s->headFrames(), _offset));
+            streaming = _stream != 0;
+            if (!streaming && _zerberus->offline() && ds->waitFull(s)) {
+                  // no stream free: wait for the complete sample,
+                  // on timeout the resident head is played
+                  full = s->fullData();
+                  }
+            }
+      data      = (full ? full : s->data()) + _offset * audioChan;
       eidx      = s->frames() * audioChan;
+      headEnd   = s->headFrames() - _offset;
+      if (s->streamed() && !full && !streaming)
+            eidx = qMax(headEnd - 2, 0) * audioChan;   // play the resident head until the sample is loaded
       _loopMode = z->loopMode;
 
       _offMode  = z->offMode;
@@ -138,6 +160,43 @@ void Voice::start(Channel* c, int key, int v, const Zone* z)
       stopEnv.setTime(z->ampegRelease, _zerberus->sampleRate());
       }
 
+//---------------------------------------------------------
+//   streamFrames
+//    collect the four interpolation points around frame
+//    from the resident head and the ring buffer; plays
+//    silence if the io thread is behind, offline rendering
+//    waits for it
+//---------------------------------------------------------
+
+const short* Voice::streamFrames(int frame, short* win)
+      {
+      if (frame + 2 + _offset >= _stream->filled) {
+            _zerberus->streamer()->underrun();
+            if (!_zerberus->offline() || !_zerberus->streamer()->waitFilled(_stream, frame + 2 + _offset)) {
+                  memset(win, 0, 4 * audioChan * sizeof(short));
+                  return win + audioChan;
+                  }
+            }
+      short* d = win;
+      for (int i = frame - 1; i <= frame + 2; ++i) {
+            const short* src = i < headEnd ? data + i * audioChan : _stream->frame(i + _offset);
+            for (int k = 0; k < audioChan; ++k)
+                  *d++ = src[k];
+            }
+      return win + audioChan;
+      }
+
+//---------------------------------------------------------
+//   stopStream
+//---------------------------------------------------------
+
+void Voice::stopStream()
+      {
+      _zerberus->streamer()->stop(_stream);
+      _stream   = 0;
+      streaming = false;
+      }
+
 //---------------------------------------------------------
 //   updateFilter
 //---------------------------------------------------------
@@ -208,8 +267,81 @@ void Voice::updateFilter(float _fres)
             }
       }
 
+//---------------------------------------------------------
+//   interpolate
+//    n frames into l and r; frames whose interpolation
+//    points reach into the ring buffer of a streamed
+//    sample are collected one by one
+//---------------------------------------------------------
+
+void Voice::interpolate(float* l, float* r, int n, float amp, float ampIncr)
+      {
+      int resident = n;
+      if (streaming) {
+            int64_t left = (int64_t(headEnd - 2) << 8) - phase.data;
+            if (left <= 0)
+                  resident = 0;
+            else if (phaseIncr.data > 0)
+                  resident = int(qMin<int64_t>(n, (left + phaseIncr.data - 1) / phaseIncr.data));
+            }
+      dspInterpolate(data, audioChan, interpCoeff, phase, phaseIncr, amp, ampIncr, l, r, resident);
+
+      short win[8];
+      for (int i = resident; i < n; ++i) {
+            const short* src    = streamFrames(phase.index(), win);
+            const float* coeffs = interpCoeff[phase.fract()];
+            if (audioChan == 1) {
+                  l[i] = (coeffs[0] * src[-1]
+                        + coeffs[1] * src[0]
+                        + coeffs[2] * src[1]
+                        + coeffs[3] * src[2]) * amp;
+                  }
+            else {
+                  l[i] = (coeffs[0] * src[-2]
+                        + coeffs[1] * src[0]
+                        + coeffs[2] * src[2]
+                        + coeffs[3] * src[4]) * amp;
+                  r[i] = (coeffs[0] * src[-1]
+                        + coeffs[1] * src[1]
+                        + coeffs[2] * src[3]
+                        + coeffs[3] * src[5]) * amp;
+                  }
+            phase += phaseIncr;
+            amp   += ampIncr;
+            }
+      }
+
+//---------------------------------------------------------
+//   filter
+//    frames in a coefficient transition are filtered
+//    one by one, the rest of the block in one run
+//---------------------------------------------------------
+
+void Voice::filter(float* l, float* r, int n)
+      {
+      int i = 0;
+      for (; i < n && filter_coeff_incr_count; ++i) {
+            Biquad f { b02, b1, a1, a2 };
+            l[i] = f(l[i], hist1l, hist2l);
+            if (r)
+                  r[i] = f(r[i], hist1r, hist2r);
+            --filter_coeff_incr_count;
+            a1  += a1_incr;
+            a2  += a2_incr;
+            b02 += b02_incr;
+            b1  += b1_incr;
+            }
+      Biquad f { b02, b1, a1, a2 };
+      dspFilter(l + i, n - i, f, hist1l, hist2l);
+      if (r)
+            dspFilter(r + i, n - i, f, hist1r, hist2r);
+      }
+
 //---------------------------------------------------------
 //   process
+//    renders in blocks of up to BLOCK frames; envelopes
+//    are evaluated once per block and ramped linearly,
+//    blocks below SILENCE only advance the voice
 //---------------------------------------------------------
 
 void Voice::process(int frames, float* p)
@@ -232,112 +364,76 @@ void Voice::process(int frames, float* p)
             last_fres = _fres;
             }
 
-      if (audioChan == 1) {
-            while (frames--) {
-                  int idx = phase.index();
-                  if (idx >= eidx) {
-                        off();
-                        break;
-                        }
-                  const float* coeffs = interpCoeff[phase.fract()];
-                  float f;
-                  f =  (coeffs[0] * data[idx-1]
-                      + coeffs[1] * data[idx+0]
-                      + coeffs[2] * data[idx+1]
-                      + coeffs[3] * data[idx+2]) * gain
-                      - a1 * hist1l
-                      - a2 * hist2l;
-                  float v = b02 * (f + hist2l) + b1 * hist1l;
-                  hist2l  = hist1l;
-                  hist1l  = f;
-
-                  if (filter_coeff_incr_count) {
-                        --filter_coeff_incr_count;
-                        a1  += a1_incr;
-                        a2  += a2_incr;
-                        b02 += b02_incr;
-                        b1  += b1_incr;
+      float l[BLOCK];
+      float r[BLOCK];
+      float panLeft  = _channel->panLeftGain();
+      float panRight = _channel->panRightGain();
+      int endFrame   = eidx / audioChan;
+
+      while (frames > 0) {
+            int64_t left = (int64_t(endFrame) << 8) - phase.data;
+            if (left <= 0) {
+                  off();
+                  break;
+                  }
+            int n     = qMin(frames, BLOCK);
+            bool last = false;      // block ends with the sample
+            if (phaseIncr.data > 0) {
+                  int64_t avail = (left + phaseIncr.data - 1) / phaseIncr.data;
+                  if (avail <= n) {
+                        n    = int(avail);
+                        last = true;
                         }
+                  }
 
+            Envelope* env = 0;
+            if (_state == VoiceState::ATTACK)
+                  env = &attackEnv;
+            else if (_state == VoiceState::STOP)
+                  env = &stopEnv;
+            float v0 = 1.0;
+            float v1 = 1.0;
+            if (env && env->count == 0) {
                   if (_state == VoiceState::STOP) {
-                        if (stopEnv.step()) {
-                              off();
-                              break;
-                              }
-                        v *= stopEnv.val;
-                        }
-                  *p++  += v * _channel->panLeftGain();
-                  *p++  += v * _channel->panRightGain();
-                  phase += phaseIncr;
-                  }
-            }
-      else {
-            //
-            // handle interleaved stereo samples
-            //
-            while (frames--) {
-                  int idx = phase.index() * 2;
-                  if (idx >= eidx) {
                         off();
-                        // printf("end of sample\n");
                         break;
                         }
-
-                  const float* coeffs = interpCoeff[phase.fract()];
-                  float f1, f2;
-
-                  f1 = (coeffs[0] * data[idx-2]
-                      + coeffs[1] * data[idx]
-                      + coeffs[2] * data[idx+2]
-                      + coeffs[3] * data[idx+4])
-                      * gain * _channel->panLeftGain();
-
-                  f2 = (coeffs[0] * data[idx-1]
-                      + coeffs[1] * data[idx+1]
-                      + coeffs[2] * data[idx+3]
-                      + coeffs[3] * data[idx+5])
-                      * gain * _channel->panRightGain();
-
-                  if (_state == VoiceState::ATTACK) {
-                        if (attackEnv.step())
-                              _state = VoiceState::PLAYING;
-                        else {
-                              f1 *= attackEnv.val;
-                              f2 *= attackEnv.val;
-                              }
-                        }
-                  else if (_state == VoiceState::STOP) {
-                        if (stopEnv.step()) {
-                              off();
-                              break;
-                              }
-                        f1 *= stopEnv.val;
-                        f2 *= stopEnv.val;
+                  _state = VoiceState::PLAYING;
+                  env    = 0;
+                  }
+            if (env) {
+                  if (env->count < n) {
+                        n    = env->count;
+                        last = false;
                         }
+                  v0 = env->val;
+                  v1 = env->advance(n);
+                  }
 
-                  f1      += -a1 * hist1l - a2 * hist2l;
-                  float vl = b02 * (f1 + hist2l) + b1 * hist1l;
-                  hist2l   = hist1l;
-                  hist1l   = f1;
-
-                  f2      +=  -a1 * hist1r - a2 * hist2r;
-                  float vr = b02 * (f2 + hist2r) + b1 * hist1r;
-                  hist2r   = hist1r;
-                  hist1r   = f2;
-
-                  if (filter_coeff_incr_count) {
-                        --filter_coeff_incr_count;
-                        a1  += a1_incr;
-                        a2  += a2_incr;
-                        b02 += b02_incr;
-                        b1  += b1_incr;
+            if (gain * qMax(v0, v1) * qMax(panLeft, panRight) < SILENCE) {
+                  if (_state == VoiceState::STOP) {
+                        off();
+                        break;
                         }
-
-                  *p++  += vl;
-                  *p++  += vr;
-                  phase += phaseIncr;
+                  phase.data += phaseIncr.data * n;
+                  hist1l = hist2l = hist1r = hist2r = 0.0;
+                  }
+            else {
+                  float ampIncr = gain * (v1 - v0) / n;
+                  float* rb     = audioChan == 1 ? 0 : r;
+                  interpolate(l, rb, n, gain * v0 + ampIncr, ampIncr);
+                  filter(l, rb, n);
+                  dspMix(l, rb ? rb : l, n, panLeft, panRight, p);
+                  }
+            p      += n * 2;
+            frames -= n;
+            if (last) {
+                  off();
+                  break;
                   }
             }
+      if (streaming)
+            _stream->readPos = phase.index() - 1 + _offset;
       }
 
 //---------------------------------------------------------
@@ -20,6 +20,7 @@ class Channel;
 struct Zone;
 class Sample;
 class Zerberus;
+class Stream;
 
 enum class LoopMode : char;
 enum class OffMode : char;
@@ -37,17 +38,14 @@ struct Envelope {
 
       int steps, count;
       float val;
+      float start;            // value before the first step
       float* table;
 
-      Envelope(float* f) { table = f; }
-      bool step() {
-            if (count) {
-                  --count;
-                  val = table[EG_SIZE * count/steps];
-                  return false;
-                  }
-            else
-                  return true;
+      Envelope(float* f, float s) { table = f; start = s; }
+      float advance(int n) {        // n <= count
+            count -= n;
+            val = table[EG_SIZE * count/steps];
+            return val;
             }
       void setTime(float ms, int sampleRate);
       };
@@ -104,6 +102,11 @@ class Voice {
 
       short* data;
       int eidx;
+
+      Stream* _stream = 0;     // ring buffer while streaming a sample
+      bool streaming  = false;
+      int headEnd;             // first frame not in the resident sample head
+      int _offset;             // zone offset into the sample in frames
       LoopMode _loopMode;
       OffMode _offMode;
       int _offBy;
@@ -147,8 +150,14 @@ class Voice {
       static float interpCoeff[INTERP_MAX][4];
 
       void updateFilter(float fres);
+      void interpolate(float* l, float* r, int n, float amp, float ampIncr);
+      void filter(float* l, float* r, int n);
+      const short* streamFrames(int frame, short* win);
+      void stopStream();
 
    public:
+      static const int BLOCK = 64;        // frames per control period
+
       Voice(Zerberus*);
       Voice* next() const         { return _next; }
       void setNext(Voice* v)      { _next = v; }
@@ -167,7 +176,7 @@ class Voice {
       void stop()                 { _state = VoiceState::STOP;      }
       void stop(float time);
       void sustained()            { _state = VoiceState::SUSTAINED; }
-      void off()                  { _state = VoiceState::OFF;       }
+      void off()                  { _state = VoiceState::OFF; if (streaming) stopStream(); }
       const char* state() const;
       LoopMode loopMode() const   { return _loopMode; }
 
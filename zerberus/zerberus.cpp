@@ -20,6 +20,7 @@
 #include "channel.h"
 #include "instrument.h"
 #include "zone.h"
+#include "streamer.h"
 
 #include <stdio.h>
 
@@ -47,6 +48,7 @@ Zerberus::Zerberus()
             initialized = true;
             Voice::init();
             }
+      _streamer = 0;
       for (int i = 0; i < MAX_VOICES; ++i)
             freeVoices.push(new Voice(this));
       for (int i = 0; i < MAX_CHANNEL; ++i)
@@ -61,6 +63,7 @@ Zerberus::Zerberus()
 Zerberus::~Zerberus()
       {
       busy = true;
+      delete _streamer.load();
       while (!instruments.empty()) {
             auto i  = instruments.front();
             auto it = instruments.begin();
@@ -76,6 +79,34 @@ Zerberus::~Zerberus()
             }
       }
 
+//---------------------------------------------------------
+//   streamStats
+//---------------------------------------------------------
+
+StreamStats Zerberus::streamStats() const
+      {
+      DiskStreamer* ds = _streamer.load(std::memory_order_acquire);
+      return ds ? ds->stats() : StreamStats();
+      }
+
+//---------------------------------------------------------
+//   initStreamer
+//    the io thread and the ring buffers are only needed
+//    once an instrument streams samples from disk. Called
+//    from the loader thread; the release store publishes
+//    the constructed streamer to the audio thread.
+//---------------------------------------------------------
+
+void Zerberus::initStreamer(const ZInstrument* instr)
+      {
+      if (!instr->streamed() || _streamer.load(std::memory_order_acquire))
+            return;
+      DiskStreamer* ds = new DiskStreamer(MAX_VOICES);
+      DiskStreamer* none = 0;
+      if (!_streamer.compare_exchange_strong(none, ds, std::memory_order_acq_rel, std::memory_order_acquire))
+            delete ds;
+      }
+
 //---------------------------------------------------------
 //   programChange
 //---------------------------------------------------------
@@ -410,6 +441,7 @@ bool Zerberus::loadInstrument(const QString& s)
             if (QFileInfo(instr->path()).fileName() == s) {
                   instruments.push_back(instr);
                   instr->setRefCount(instr->refCount() + 1);
+                  initStreamer(instr);
                   if (instruments.size() == 1) {
                         for (int i = 0; i < MAX_CHANNEL; ++i)
                               _channel[i]->setInstrument(instr);
@@ -435,6 +467,7 @@ bool Zerberus::loadInstrument(const QString& s)
                   globalInstruments.push_back(instr);
                   instruments.push_back(instr);
                   instr->setRefCount(1);
+                  initStreamer(instr);
                   //
                   // set default instrument for all channels:
                   //
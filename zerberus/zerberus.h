@@ -24,6 +24,8 @@
 class Voice;
 class Channel;
 class ZInstrument;
+class DiskStreamer;
+struct StreamStats;
 enum class Trigger : char;
 
 static const int MAX_VOICES  = 512;
@@ -74,6 +76,7 @@ class Zerberus : public Ms::Synthesizer {
       Channel* _channel[MAX_CHANNEL];
 
       int allocatedVoices = 0;
+      std::atomic<DiskStreamer*> _streamer;   // set by the loader, read by the audio thread
       VoiceFifo freeVoices;
       Voice* activeVoices = 0;
       int _loadProgress = 0;
@@ -95,6 +98,9 @@ class Zerberus : public Ms::Synthesizer {
       ZInstrument* instrument(int program) const;
       Voice* getActiveVoices()      { return activeVoices; }
       Channel* channel(int n)       { return _channel[n]; }
+      DiskStreamer* streamer()      { return _streamer.load(std::memory_order_acquire); }
+      void initStreamer(const ZInstrument*);
+      StreamStats streamStats() const;
       int loadProgress()            { return _loadProgress; }
       void setLoadProgress(int val) { _loadProgress = val; }
 